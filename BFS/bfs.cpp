@@ -51,6 +51,9 @@
 #include <algorithm>
 #include <vector>
 #include "bfs_core.h"
+#ifdef BATCH_QUERIES
+#include "bfs_batch.h"
+#endif
 #include "utils.h"
 #include <omp.h>
 
@@ -60,13 +63,41 @@
 typedef uint32_t VTYPE;
 typedef int64_t  PTYPE;
 
+#if defined(BATCH_QUERIES) && defined(CHECK_DEPTHS)
+typedef struct {
+ VTYPE * IAr;
+ VTYPE * JAr;
+ VTYPE NUM_VERTICES;
+ uint32_t num_failed;
+} batch_check_t;
+
+// Per-query verification callback for batch_bfs.
+void check_batch_query(uint32_t query_idx, VTYPE source_id,
+  const VTYPE * parent, void * ctx)
+{
+ batch_check_t * chk = (batch_check_t *)ctx;
+ VTYPE N = chk->NUM_VERTICES;
+ PTYPE * parent_wide = (PTYPE *)malloc(N * sizeof(PTYPE));
+ uint32_t * depth_table = (uint32_t *)malloc(N * sizeof(uint32_t));
+ for (VTYPE idx = 0; idx < N; idx++){
+  parent_wide[idx] = parent[idx];
+ }
+ init_vector(depth_table, N, N);
+ make_depth_table(source_id, depth_table, chk->IAr, chk->JAr, N);
+ if (!check_parents_vs_depths(parent_wide, depth_table, source_id, N)){
+  __sync_fetch_and_add(&(chk->num_failed), 1);
+ }
+ free(parent_wide);
+ free(depth_table);
+}
+#endif
+
 void usage(const char * exec_name)
 {
  printf("USAGE: %s IA_FILE JA_FILE [optional:source_id(int)]\n", exec_name);
 }
 
 int main(int argc, char **argv){
- PTYPE * parent;
  double t0,t1;
  uint32_t NUM_EDGES,NUM_VERTICES;
  VTYPE * IAr, * JAr, * IAc, * JAc;
@@ -155,8 +186,52 @@ int main(int argc, char **argv){
  // ********** End of setup *********
 
 
+#ifdef BATCH_QUERIES
+ // Throughput mode: all sources are independent queries.
+ uint32_t num_queries = source_ids.size();
+ bfs_query_result_t * results = (bfs_query_result_t *)malloc(
+   num_queries * sizeof(bfs_query_result_t));
+ // Worker buffers are allocated once and reused by every iteration.
+ bfs_batch_workers_t * workers =
+   bfs_batch_workers_alloc(NUM_VERTICES, omp_get_max_threads());
+ double total_time = 0;
+ uint32_t num_intra = 0;
+ for (int i = 0; i < ITERS; i++){
+  t0 = omp_get_wtime();
+  num_intra = batch_bfs(workers, source_ids.data(), num_queries,
+    IAr, JAr, IAc, JAc, NUM_VERTICES,
+    BFS_BATCH_FRONTIER_CUTOFF, results, NULL, NULL);
+  t1 = omp_get_wtime();
+  total_time += (t1-t0);
+ }
+ double avg_time = total_time / (double)ITERS;
+ uint32_t max_depth = 0;
+ for (uint32_t qdx = 0; qdx < num_queries; qdx++){
+  max_depth = MAX(max_depth, results[qdx].depth);
+ }
+ printf("name,queries,inter,intra,time_avg,queries_per_sec,max_depth,threads\n");
+ printf("%s,%u,%u,%u,%f,%f,%u,%d\n", argv[1], num_queries,
+   num_queries - num_intra, num_intra, avg_time,
+   (double)num_queries / avg_time, max_depth, NUM_THREADS);
+#ifdef CHECK_DEPTHS
+ // Verify on one more, untimed, batch.
+ batch_check_t chk = {IAr, JAr, NUM_VERTICES, 0};
+ batch_bfs(workers, source_ids.data(), num_queries,
+   IAr, JAr, IAc, JAc, NUM_VERTICES,
+   BFS_BATCH_FRONTIER_CUTOFF, results, check_batch_query, &chk);
+ if (chk.num_failed){
+  std::cerr << "FAILED PARENT VS DEPTH CHECK (" << chk.num_failed
+   << " of " << num_queries << " queries)" << std::endl;
+ }
+ else {
+  std::cerr << "PASSED PARENT VS DEPTH CHECK." << std::endl;
+ }
+#endif
+ bfs_batch_workers_free(workers);
+ free(results);
+#else
  double total_time = 0;
- parent = (PTYPE * )malloc(NUM_VERTICES* sizeof(PTYPE));
+ PTYPE * parent = (PTYPE * )malloc(NUM_VERTICES* sizeof(PTYPE));
  for (auto srcs_itr = source_ids.begin(); srcs_itr != source_ids.end(); srcs_itr++){
   uint32_t source_id = *srcs_itr;
   uint32_t depth;	
@@ -193,8 +268,9 @@ int main(int argc, char **argv){
 #endif
  }
  printf("Average time for all sources: %f\n", total_time/source_ids.size());
- 
  free(parent);
+#endif
+ 
  free(IAr);
  free(JAr);
  free(IAc);
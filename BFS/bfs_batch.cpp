@@ -0,0 +1,237 @@
+/*
+ * Graph Kernel Collection
+ *
+ * Copyright 2020 Carnegie Mellon University.
+ *
+ * NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ * INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON 
+ * UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR IMPLIED, 
+ * AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF FITNESS FOR 
+ * PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS OBTAINED FROM USE OF 
+ * THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES NOT MAKE ANY WARRANTY OF ANY
+ * KIND WITH RESPECT TO FREEDOM FROM PATENT, TRADEMARK, OR COPYRIGHT 
+ * INFRINGEMENT.
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or
+ * contact permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public
+ * release and unlimited distribution.  Please see Copyright notice for 
+ * non-US Government use and distribution.
+ *
+ * This Software includes and/or makes use of the following Third-Party
+ * Software subject to its own license:
+ *
+ * 1. Matrix Market Loader code (https://math.nist.gov/MatrixMarket/mmio-c.html).
+ *
+ *      The code made publicly available at nist.gov is not marked with a 
+ *      copyright notice and is therefore believed pursuant to section 105 of 
+ *      the Copyright Act, to not be entitled to domestic copyright protection 
+ *      under U.S. law and is therefore in the public domain.  Accordingly, it 
+ *      is believed that no license is required for its use.
+ *
+ * This Software may include certain portions of copyrighted code that is 
+ * initially being released only in binary form for validation and evaluation
+ * purposes. It is expected that source code will be released as open source at
+ * a future date. 
+ *
+ * DM20-0375
+ */
+ 
+#include "bfs_batch.h"
+
+bfs_batch_workers_t * bfs_batch_workers_alloc(VTYPE NUM_VERTICES,
+    uint32_t num_workers)
+{
+ bfs_batch_workers_t * bw =
+   (bfs_batch_workers_t *)calloc(1, sizeof(bfs_batch_workers_t));
+ num_workers = MAX(num_workers, 1);
+ if (bw) bw->workers = (bfs_worker_t *)calloc(num_workers, sizeof(bfs_worker_t));
+ if (!bw || !bw->workers){
+  fprintf(stderr, "ERROR: could not allocate batch BFS workers.\n");
+  exit(EXIT_FAILURE);
+ }
+ bw->NUM_VERTICES = NUM_VERTICES;
+ bw->num_workers = num_workers;
+ // Every worker gets its buffers however many threads the team has. With
+ // a full team each is first touched by the thread that will run it.
+#pragma omp parallel for schedule(static, 1) num_threads(num_workers)
+ for (uint32_t wdx = 0; wdx < num_workers; wdx++){
+  bfs_worker_t * w = &bw->workers[wdx];
+  w->parent = (VTYPE *)malloc(MAX(NUM_VERTICES, 1) * sizeof(VTYPE));
+  w->queue = (VTYPE *)malloc(MAX(NUM_VERTICES, 1) * sizeof(VTYPE));
+  if (!w->parent || !w->queue){
+   fprintf(stderr, "ERROR: could not allocate batch BFS worker buffers.\n");
+   exit(EXIT_FAILURE);
+  }
+  init_vector(w->parent, NUM_VERTICES, NUM_VERTICES);
+ }
+ return bw;
+}
+
+void bfs_batch_workers_free(bfs_batch_workers_t * bw){
+ if (!bw) return;
+ for (uint32_t wdx = 0; wdx < bw->num_workers; wdx++){
+  free(bw->workers[wdx].parent);
+  free(bw->workers[wdx].queue);
+ }
+ free(bw->workers);
+ free(bw->parent);
+ free(bw->parent_out);
+ free(bw->deferred);
+ free(bw);
+}
+
+// Work of the second BFS level from src (sum of out-degrees of the source and
+// its neighbors). Stops scanning once the cutoff has been passed.
+static uint64_t two_hop_estimate(
+    VTYPE src, VTYPE * IAr, VTYPE * JAr, uint64_t cutoff)
+{
+ uint64_t est = IAr[src+1] - IAr[src];
+ for (VTYPE edx = IAr[src]; edx < IAr[src+1] && est <= cutoff; edx++){
+  VTYPE v = JAr[edx];
+  est += IAr[v+1] - IAr[v];
+ }
+ return est;
+}
+
+// Serial top-down BFS using the worker's buffers. Sets *visited to the number
+// of vertices queued (and so marked in parent). Returns false if some level
+// had more than cutoff frontier work, in which case the query was abandoned.
+static bool serial_bfs(
+    bfs_worker_t * w, VTYPE src, VTYPE * IAr, VTYPE * JAr,
+    VTYPE NUM_VERTICES, uint64_t cutoff, VTYPE * depth_out, VTYPE * visited)
+{
+ VTYPE * parent = w->parent;
+ VTYPE * queue = w->queue;
+ VTYPE head = 0, tail = 0, depth = 0;
+ parent[src] = src;
+ queue[tail++] = src;
+ while (head < tail){
+  VTYPE level_end = tail;
+  uint64_t level_work = 0;
+  for (VTYPE qdx = head; qdx < level_end; qdx++){
+   level_work += IAr[queue[qdx]+1] - IAr[queue[qdx]];
+  }
+  if (level_work > cutoff){
+   *visited = tail;
+   return false;
+  }
+  for (; head < level_end; head++){
+   VTYPE u = queue[head];
+   for (VTYPE edx = IAr[u]; edx < IAr[u+1]; edx++){
+    VTYPE v = JAr[edx];
+    if (parent[v] == NUM_VERTICES){
+     parent[v] = u;
+     queue[tail++] = v;
+    }
+   }
+  }
+  if (tail > level_end) depth++;
+ }
+ *depth_out = depth;
+ *visited = tail;
+ return true;
+}
+
+uint32_t batch_bfs(
+    bfs_batch_workers_t * bw,
+    const VTYPE * sources,
+    uint32_t num_sources,
+    VTYPE * IAr,
+    VTYPE * JAr,
+    VTYPE * IAc,
+    VTYPE * JAc,
+    VTYPE NUM_VERTICES,
+    uint64_t frontier_cutoff,
+    bfs_query_result_t * results,
+    bfs_query_cb_t cb,
+    void * cb_ctx)
+{
+ if (bw->NUM_VERTICES != NUM_VERTICES){
+  fprintf(stderr, "ERROR: batch BFS workers are for %u vertices, not %u.\n",
+    bw->NUM_VERTICES, NUM_VERTICES);
+  exit(EXIT_FAILURE);
+ }
+ // Queries deferred to the intra-query phase, appended from any thread.
+ if (bw->deferred_cap < num_sources){
+  free(bw->deferred);
+  bw->deferred = (uint32_t *)malloc(num_sources * sizeof(uint32_t));
+  bw->deferred_cap = num_sources;
+  if (!bw->deferred){
+   fprintf(stderr, "ERROR: could not allocate batch BFS query lists.\n");
+   exit(EXIT_FAILURE);
+  }
+ }
+ uint32_t * deferred = bw->deferred;
+ uint32_t num_deferred = 0;
+
+ /*********************************/
+ /**** Inter-query parallelism ****/
+ /*********************************/
+// The team has at most num_workers threads, each with its own worker.
+#pragma omp parallel num_threads(bw->num_workers)
+ {
+  bfs_worker_t & w = bw->workers[omp_get_thread_num()];
+
+#pragma omp for schedule(dynamic, 1)
+  for (uint32_t qdx = 0; qdx < num_sources; qdx++){
+   VTYPE src = sources[qdx];
+   VTYPE depth = 0;
+   VTYPE visited = 0;
+   bool done = false;
+   if (two_hop_estimate(src, IAr, JAr, frontier_cutoff) <= frontier_cutoff){
+    done = serial_bfs(&w, src, IAr, JAr, NUM_VERTICES,
+      frontier_cutoff, &depth, &visited);
+   }
+   if (done){
+    results[qdx].depth = depth;
+    results[qdx].num_reached = visited;
+    results[qdx].intra = false;
+    if (cb) cb(qdx, src, w.parent, cb_ctx);
+   }
+   else {
+    uint32_t slot = __sync_fetch_and_add(&num_deferred, 1);
+    deferred[slot] = qdx;
+   }
+   // Sparse reset: only the queued vertices were marked.
+   for (VTYPE vdx = 0; vdx < visited; vdx++){
+    w.parent[w.queue[vdx]] = NUM_VERTICES;
+   }
+  }
+ }
+
+ /*********************************/
+ /**** Intra-query parallelism ****/
+ /*********************************/
+ if (num_deferred > 0){
+  if (!bw->parent){
+   bw->parent = (PTYPE *)malloc(MAX(NUM_VERTICES, 1) * sizeof(PTYPE));
+  }
+  if (cb && !bw->parent_out){
+   bw->parent_out = (VTYPE *)malloc(MAX(NUM_VERTICES, 1) * sizeof(VTYPE));
+  }
+  if (!bw->parent || (cb && !bw->parent_out)){
+   fprintf(stderr, "ERROR: could not allocate batch BFS parent array.\n");
+   exit(EXIT_FAILURE);
+  }
+  PTYPE * parent = bw->parent;
+  VTYPE * parent_out = cb ? bw->parent_out : NULL;
+  for (uint32_t ddx = 0; ddx < num_deferred; ddx++){
+   uint32_t qdx = deferred[ddx];
+   VTYPE src = sources[qdx];
+   VTYPE depth = par_bfs(src, parent, IAr, JAr, IAc, JAc, NUM_VERTICES);
+   VTYPE reached = 0;
+#pragma omp parallel for reduction(+:reached)
+   for (VTYPE vdx = 0; vdx < NUM_VERTICES; vdx++){
+    if (parent[vdx] != NUM_VERTICES) reached++;
+    if (parent_out) parent_out[vdx] = (VTYPE)parent[vdx];
+   }
+   results[qdx].depth = depth;
+   results[qdx].num_reached = reached;
+   results[qdx].intra = true;
+   if (cb) cb(qdx, src, parent_out, cb_ctx);
+  }
+ }
+ return num_deferred;
+}
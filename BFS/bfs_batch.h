@@ -0,0 +1,132 @@
+/*
+ * Graph Kernel Collection
+ *
+ * Copyright 2020 Carnegie Mellon University.
+ *
+ * NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ * INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON 
+ * UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR IMPLIED, 
+ * AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF FITNESS FOR 
+ * PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS OBTAINED FROM USE OF 
+ * THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES NOT MAKE ANY WARRANTY OF ANY
+ * KIND WITH RESPECT TO FREEDOM FROM PATENT, TRADEMARK, OR COPYRIGHT 
+ * INFRINGEMENT.
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or
+ * contact permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public
+ * release and unlimited distribution.  Please see Copyright notice for 
+ * non-US Government use and distribution.
+ *
+ * This Software includes and/or makes use of the following Third-Party
+ * Software subject to its own license:
+ *
+ * 1. Matrix Market Loader code (https://math.nist.gov/MatrixMarket/mmio-c.html).
+ *
+ *      The code made publicly available at nist.gov is not marked with a 
+ *      copyright notice and is therefore believed pursuant to section 105 of 
+ *      the Copyright Act, to not be entitled to domestic copyright protection 
+ *      under U.S. law and is therefore in the public domain.  Accordingly, it 
+ *      is believed that no license is required for its use.
+ *
+ * This Software may include certain portions of copyrighted code that is 
+ * initially being released only in binary form for validation and evaluation
+ * purposes. It is expected that source code will be released as open source at
+ * a future date. 
+ *
+ * DM20-0375
+ */
+ 
+#ifndef BFS_BATCH_H
+#define BFS_BATCH_H
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <vector>
+#include "bfs_core.h"
+#include "graph.h"
+#include <omp.h>
+
+// Default amount of frontier work (sum of out-degrees of a single BFS level)
+// above which a query is handed to the intra-query par_bfs instead of being
+// run by a single worker thread.
+#ifndef BFS_BATCH_FRONTIER_CUTOFF
+#define BFS_BATCH_FRONTIER_CUTOFF (64*1024)
+#endif
+
+typedef struct {
+ VTYPE depth;       // number of levels below the source
+ VTYPE num_reached; // vertices reached, including the source
+ bool  intra;       // true if the query was run with par_bfs
+} bfs_query_result_t;
+
+// Called once per finished query. parent holds NUM_VERTICES entries, with
+// NUM_VERTICES marking unreached vertices, and is only valid for the duration
+// of the call. May be called concurrently from several threads.
+typedef void (*bfs_query_cb_t)(
+    uint32_t query_idx,
+    VTYPE source_id,
+    const VTYPE * parent,
+    void * ctx);
+
+// State of one worker of the inter-query phase. parent is kept at
+// NUM_VERTICES everywhere between queries; a query only touches the entries
+// listed in queue, so only those are reset.
+typedef struct {
+ VTYPE * parent;
+ VTYPE * queue;
+} bfs_worker_t;
+
+/*
+ * Buffers of batch_bfs, allocated once by the caller and reused by any
+ * number of calls on graphs of NUM_VERTICES vertices.
+ *
+ * Each of the num_workers workers owns a parent and a queue array, 8 bytes
+ * per vertex (about 31.5 GB for 64 workers on the 61.6M vertices of
+ * twitter), normally first touched by the thread that runs it. The
+ * intra-query phase adds one PTYPE parent array (8 bytes per vertex) and,
+ * for callbacks, a VTYPE copy (4 bytes per vertex), allocated on first use.
+ * Fewer workers than threads trade inter-query parallelism for memory.
+ */
+typedef struct {
+ VTYPE NUM_VERTICES;
+ uint32_t num_workers;
+ bfs_worker_t * workers;
+ PTYPE * parent;          // intra-query phase, or NULL until needed
+ VTYPE * parent_out;
+ uint32_t * deferred;     // queries left for the intra-query phase
+ uint32_t deferred_cap;
+} bfs_batch_workers_t;
+
+bfs_batch_workers_t * bfs_batch_workers_alloc(VTYPE NUM_VERTICES,
+    uint32_t num_workers);
+void bfs_batch_workers_free(bfs_batch_workers_t * bw);
+
+/*
+ * Throughput-mode BFS over many independent sources.
+ *
+ * Queries whose estimated frontier stays below frontier_cutoff are run
+ * concurrently, one per worker of bw, each reusing its own parent and queue
+ * buffers (reset sparsely between queries). Queries that exceed the cutoff,
+ * either in the two-hop estimate or while running, are deferred and then run
+ * one after another with the intra-query par_bfs on all threads.
+ *
+ * The graph is shared and read-only. results must hold num_sources entries;
+ * cb may be NULL. Returns the number of queries run with par_bfs.
+ */
+uint32_t batch_bfs(
+    bfs_batch_workers_t * bw,
+    const VTYPE * sources,
+    uint32_t num_sources,
+    VTYPE * IAr,
+    VTYPE * JAr,
+    VTYPE * IAc,
+    VTYPE * JAc,
+    VTYPE NUM_VERTICES,
+    uint64_t frontier_cutoff,
+    bfs_query_result_t * results,
+    bfs_query_cb_t cb,
+    void * cb_ctx);
+#endif
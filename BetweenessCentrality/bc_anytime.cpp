@@ -0,0 +1,198 @@
+/*
+ * Graph Kernel Collection
+ *
+ * Copyright 2020 Carnegie Mellon University.
+ *
+ * NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ * INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON 
+ * UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR IMPLIED, 
+ * AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF FITNESS FOR 
+ * PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS OBTAINED FROM USE OF 
+ * THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES NOT MAKE ANY WARRANTY OF ANY
+ * KIND WITH RESPECT TO FREEDOM FROM PATENT, TRADEMARK, OR COPYRIGHT 
+ * INFRINGEMENT.
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or
+ * contact permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public
+ * release and unlimited distribution.  Please see Copyright notice for 
+ * non-US Government use and distribution.
+ *
+ * This Software includes and/or makes use of the following Third-Party
+ * Software subject to its own license:
+ *
+ * 1. Matrix Market Loader code (https://math.nist.gov/MatrixMarket/mmio-c.html).
+ *
+ *      The code made publicly available at nist.gov is not marked with a 
+ *      copyright notice and is therefore believed pursuant to section 105 of 
+ *      the Copyright Act, to not be entitled to domestic copyright protection 
+ *      under U.S. law and is therefore in the public domain.  Accordingly, it 
+ *      is believed that no license is required for its use.
+ *
+ * This Software may include certain portions of copyrighted code that is 
+ * initially being released only in binary form for validation and evaluation
+ * purposes. It is expected that source code will be released as open source at
+ * a future date. 
+ *
+ * DM20-0375
+ */
+ 
+#include "bc_anytime.h"
+#include <math.h>
+
+#define UNVISITED UINT32_MAX
+
+static inline void atomic_add_double(PATH_TYPE * loc, PATH_TYPE val){
+ union { PATH_TYPE f; uint64_t u; } cur, nxt;
+ cur.f = *loc;
+ while (true){
+  nxt.f = cur.f + val;
+  uint64_t old = __sync_val_compare_and_swap((uint64_t *)loc, cur.u, nxt.u);
+  if (old == cur.u) return;
+  cur.u = old;
+ }
+}
+
+// Dependencies of every vertex on src, written to delta (0 for unreached
+// vertices). As in GAP and brandes_centralities, src keeps its own
+// dependency. Returns false if ctl stopped it part way.
+static bool brandes_source(uint32_t * IA, uint32_t * JA, uint32_t N,
+  uint32_t src, uint32_t * depth, PATH_TYPE * paths, DELTA_T * delta,
+  uint32_t * queue, std::vector<uint32_t> & level_offsets, anytime_t * ctl)
+{
+#pragma omp parallel for
+ for (uint32_t v = 0; v < N; v++){
+  depth[v] = UNVISITED;
+  paths[v] = 0;
+  delta[v] = 0;
+ }
+ depth[src] = 0;
+ paths[src] = 1;
+ queue[0] = src;
+ level_offsets.assign(1, 0);
+ level_offsets.push_back(1);
+ bool stopped = false;
+
+ // Forward: BFS levels with shortest-path counts.
+ for (uint32_t d = 0; !stopped; d++){
+  uint32_t l_st = level_offsets[d], l_nd = level_offsets[d+1];
+  if (l_st == l_nd) break;
+  uint32_t q_size = l_nd;
+#pragma omp parallel for schedule(dynamic, 64)
+  for (uint32_t qdx = l_st; qdx < l_nd; qdx++){
+   if (stopped || ((qdx & 63) == 0 && anytime_expired(ctl))){
+    stopped = true;
+    continue;
+   }
+   uint32_t u = queue[qdx];
+   for (uint32_t edx = IA[u]; edx < IA[u+1]; edx++){
+    uint32_t v = JA[edx];
+    if (depth[v] == UNVISITED &&
+        __sync_bool_compare_and_swap(&depth[v], UNVISITED, d+1)){
+     queue[__sync_fetch_and_add(&q_size, 1)] = v;
+    }
+    if (depth[v] == d+1) atomic_add_double(&paths[v], paths[u]);
+   }
+  }
+  level_offsets.push_back(q_size);
+ }
+
+ // Backward: pull dependencies from the successors, deepest level first.
+ for (uint32_t d = level_offsets.size() - 2; d > 0 && !stopped; d--){
+  uint32_t l_st = level_offsets[d-1], l_nd = level_offsets[d];
+#pragma omp parallel for schedule(dynamic, 64)
+  for (uint32_t qdx = l_st; qdx < l_nd; qdx++){
+   if (stopped || ((qdx & 63) == 0 && anytime_expired(ctl))){
+    stopped = true;
+    continue;
+   }
+   uint32_t u = queue[qdx];
+   DELTA_T dep = 0;
+   for (uint32_t edx = IA[u]; edx < IA[u+1]; edx++){
+    uint32_t v = JA[edx];
+    if (depth[v] == depth[u] + 1) dep += paths[u] / paths[v] * (1 + delta[v]);
+   }
+   delta[u] = dep;
+  }
+ }
+ return !stopped;
+}
+
+uint32_t bc_anytime(uint32_t * IA, uint32_t * JA, uint32_t N,
+  CENT_T * centralities, uint32_t * sources, uint32_t num_srcs,
+  anytime_t * ctl)
+{
+ if (N == 0) return 0;
+ uint32_t * depth = (uint32_t *)malloc(N * sizeof(uint32_t));
+ uint32_t * queue = (uint32_t *)malloc(N * sizeof(uint32_t));
+ PATH_TYPE * paths = (PATH_TYPE *)malloc(N * sizeof(PATH_TYPE));
+ DELTA_T * delta = (DELTA_T *)malloc(N * sizeof(DELTA_T));
+ // Per-vertex sum of squared per-source dependencies, for the bound.
+ double * sum_sq = (double *)malloc(N * sizeof(double));
+ if (!depth || !queue || !paths || !delta || !sum_sq){
+  fprintf(stderr, "ERROR: could not allocate BC work arrays.\n");
+  exit(EXIT_FAILURE);
+ }
+ std::vector<uint32_t> level_offsets;
+#pragma omp parallel for
+ for (uint32_t v = 0; v < N; v++){
+  centralities[v] = 0;
+  sum_sq[v] = 0;
+ }
+
+ uint32_t done = 0;
+ double err_bound = 0;
+ while (done < num_srcs){
+  if (!brandes_source(IA, JA, N, sources[done], depth, paths, delta, queue,
+        level_offsets, ctl)){
+   break;
+  }
+  done++;
+  // Largest 95% half-width of num_srcs * mean, relative to the largest
+  // estimate, with the finite population correction.
+  double max_sum = 0, max_var = 0;
+#pragma omp parallel for reduction(max:max_sum, max_var)
+  for (uint32_t v = 0; v < N; v++){
+   centralities[v] += delta[v];
+   sum_sq[v] += (double)delta[v] * delta[v];
+   double mean = centralities[v] / done;
+   max_sum = MAX(max_sum, (double)centralities[v]);
+   max_var = MAX(max_var, sum_sq[v] / done - mean * mean);
+  }
+  if (done < num_srcs){
+   double max_est = max_sum * num_srcs / done;
+   double fpc = (double)(num_srcs - done) / MAX(num_srcs - 1, 1);
+   err_bound = done < 2 || max_est == 0 ? 1.0 :
+     1.96 * num_srcs * sqrt(max_var * done / (done - 1) / done * fpc) / max_est;
+  } else {
+   err_bound = 0;
+  }
+  if (anytime_step(ctl, (double)done / num_srcs, err_bound)) break;
+ }
+
+ // Normalizing by the maximum also takes care of scaling the partial sum up
+ // to the full source list.
+ CENT_T max_cent = 0;
+#pragma omp parallel for reduction(max:max_cent)
+ for (uint32_t v = 0; v < N; v++){
+  max_cent = MAX(max_cent, centralities[v]);
+ }
+ if (max_cent > 0){
+#pragma omp parallel for
+  for (uint32_t v = 0; v < N; v++){
+   centralities[v] /= max_cent;
+  }
+ }
+ if (ctl){
+  ctl->completed = (done == num_srcs);
+  ctl->err_bound = done == 0 ? 1.0 : err_bound;
+ }
+
+ free(depth);
+ free(queue);
+ free(paths);
+ free(delta);
+ free(sum_sq);
+ return done;
+}
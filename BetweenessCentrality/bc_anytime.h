@@ -0,0 +1,75 @@
+/*
+ * Graph Kernel Collection
+ *
+ * Copyright 2020 Carnegie Mellon University.
+ *
+ * NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ * INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON 
+ * UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR IMPLIED, 
+ * AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF FITNESS FOR 
+ * PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS OBTAINED FROM USE OF 
+ * THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES NOT MAKE ANY WARRANTY OF ANY
+ * KIND WITH RESPECT TO FREEDOM FROM PATENT, TRADEMARK, OR COPYRIGHT 
+ * INFRINGEMENT.
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or
+ * contact permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public
+ * release and unlimited distribution.  Please see Copyright notice for 
+ * non-US Government use and distribution.
+ *
+ * This Software includes and/or makes use of the following Third-Party
+ * Software subject to its own license:
+ *
+ * 1. Matrix Market Loader code (https://math.nist.gov/MatrixMarket/mmio-c.html).
+ *
+ *      The code made publicly available at nist.gov is not marked with a 
+ *      copyright notice and is therefore believed pursuant to section 105 of 
+ *      the Copyright Act, to not be entitled to domestic copyright protection 
+ *      under U.S. law and is therefore in the public domain.  Accordingly, it 
+ *      is believed that no license is required for its use.
+ *
+ * This Software may include certain portions of copyrighted code that is 
+ * initially being released only in binary form for validation and evaluation
+ * purposes. It is expected that source code will be released as open source at
+ * a future date. 
+ *
+ * DM20-0375
+ */
+ 
+#ifndef BC_ANYTIME_H
+#define BC_ANYTIME_H
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <omp.h>
+#include "bc.h"
+#include "anytime.h"
+#include "utils.h"
+
+/*
+ * Anytime betweenness centrality over a list of sources.
+ *
+ * Runs Brandes one source at a time (level-synchronous BFS with path counts,
+ * then dependency accumulation level by level) and can stop between sources
+ * or within one, in which case the partial source is discarded. The library
+ * brandes_centralities returns max-normalized scores, which cannot be summed
+ * across calls, so the accumulation is done here.
+ *
+ * centralities must hold N entries. On return it holds the estimate of the
+ * centralities over all num_srcs sources, normalized by its maximum like
+ * brandes_centralities: the exact result if every source was processed,
+ * otherwise the processed sources' sum scaled by num_srcs / processed.
+ * Returns the number of sources processed.
+ *
+ * ctl may be NULL. err_bound is the largest 95% confidence half-width, over
+ * all vertices and in normalized units, of the scaled estimate, treating the
+ * processed sources as a random sample without replacement from the list
+ * (so the list should be in random order). It is 0 once all sources are done.
+ */
+uint32_t bc_anytime(uint32_t * IA, uint32_t * JA, uint32_t N,
+  CENT_T * centralities, uint32_t * sources, uint32_t num_srcs,
+  anytime_t * ctl);
+#endif
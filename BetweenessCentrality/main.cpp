@@ -46,6 +46,12 @@
 #include "bc.h"
 #include "bc_checking.h"
 
+// -DANYTIME_MS=<ms> runs the in-tree anytime kernel over all sources with a
+// deadline instead of the trials of SRCS_PER_TRIAL sources.
+#ifdef ANYTIME_MS
+#include "bc_anytime.h"
+#endif
+
 #define NUM_SRCS 64
 #define SRCS_PER_TRIAL 4
 
@@ -123,9 +129,40 @@ int main(int argc, char** argv){
 
  double st, nd;
  char * trunc_fname = truncate_fname(argv[1]);
- double avg_time = 0;	
-
  PATH_TYPE * paths_out = NULL;
+#ifdef ANYTIME_MS
+ uint32_t num_threads = omp_get_max_threads();
+ centralities = (CENT_T *)malloc(N * sizeof(CENT_T));
+ anytime_t ctl;
+ anytime_init(&ctl, ANYTIME_MS / 1000.0, NULL, NULL);
+ st = omp_get_wtime();
+ uint32_t done = bc_anytime(IA, JA, N, centralities, sources, num_srcs, &ctl);
+ nd = omp_get_wtime();
+ printf("input,sources,processed,err_bound,time,threads\n");
+ printf("%s,%u,%u,%f,%f,%u\n", trunc_fname, num_srcs, done, ctl.err_bound,
+   nd-st, num_threads);
+#ifdef VERIFY
+ // Realized error of the estimate against the library on all sources.
+ CENT_T * exact = NULL;
+ brandes_centralities(IA, JA, N, exact, sources, num_srcs);
+ double max_err = 0;
+ for (uint32_t v = 0; v < N; v++){
+  max_err = MAX(max_err, fabs(exact[v] - centralities[v]));
+ }
+ printf("Max error vs all %u sources: %f (bound %f)\n", num_srcs, max_err,
+   ctl.err_bound);
+ if (done == num_srcs){
+  if (BC_checker(IA, JA, paths_out, centralities, sources, num_srcs, N)){
+   printf("++++++SUCCESS: PASSED CHECK!+++++\n");
+  } else {
+   printf("~~~~~~~~~FAILED CHECK!!~~~~~~~~~~\n");
+  }
+ }
+ free(exact);
+#endif
+ free(centralities);
+#else
+ double avg_time = 0;	
  printf("name,time(s),threads\n");
  uint32_t num_threads = omp_get_max_threads();
  printf("input,source1,source2,source3,source4,time,threads\n");
@@ -151,6 +188,7 @@ int main(int argc, char** argv){
 
 
  printf("Average time: %f seconds.\n\n", avg_time/(NUM_SRCS/SRCS_PER_TRIAL));
+#endif
  free(trunc_fname);
 
 
@@ -0,0 +1,205 @@
+/*
+ * Graph Kernel Collection
+ *
+ * Copyright 2020 Carnegie Mellon University.
+ *
+ * NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ * INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON 
+ * UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR IMPLIED, 
+ * AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF FITNESS FOR 
+ * PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS OBTAINED FROM USE OF 
+ * THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES NOT MAKE ANY WARRANTY OF ANY
+ * KIND WITH RESPECT TO FREEDOM FROM PATENT, TRADEMARK, OR COPYRIGHT 
+ * INFRINGEMENT.
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or
+ * contact permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public
+ * release and unlimited distribution.  Please see Copyright notice for 
+ * non-US Government use and distribution.
+ *
+ * This Software includes and/or makes use of the following Third-Party
+ * Software subject to its own license:
+ *
+ * 1. Matrix Market Loader code (https://math.nist.gov/MatrixMarket/mmio-c.html).
+ *
+ *      The code made publicly available at nist.gov is not marked with a 
+ *      copyright notice and is therefore believed pursuant to section 105 of 
+ *      the Copyright Act, to not be entitled to domestic copyright protection 
+ *      under U.S. law and is therefore in the public domain.  Accordingly, it 
+ *      is believed that no license is required for its use.
+ *
+ * This Software may include certain portions of copyrighted code that is 
+ * initially being released only in binary form for validation and evaluation
+ * purposes. It is expected that source code will be released as open source at
+ * a future date. 
+ *
+ * DM20-0375
+ */
+ 
+#include "afforest.h"
+#include <random>
+#include <unordered_map>
+
+// Most frequent label among a random sample of vertices (after compression
+// this is, with high probability, the label of the largest component).
+static uint32_t sample_frequent_label(uint32_t * comp, uint32_t N){
+ std::unordered_map<uint32_t, uint32_t> counts(32);
+ std::mt19937 gen(27491095);
+ std::uniform_int_distribution<uint32_t> dist(0, N-1);
+ for (uint32_t sdx = 0; sdx < AFFOREST_NUM_SAMPLES; sdx++){
+  counts[comp[dist(gen)]]++;
+ }
+ uint32_t best = 0, best_count = 0;
+ for (auto itr = counts.begin(); itr != counts.end(); itr++){
+  if (itr->second > best_count){
+   best = itr->first;
+   best_count = itr->second;
+  }
+ }
+ return best;
+}
+
+// Link edge (u, v). If hook_src is given, the edge is recorded at the root
+// it hooked, so the recorded edges form a spanning forest.
+static inline void link_edge(uint32_t u, uint32_t v, uint32_t * parents,
+  uint32_t * hook_src, uint32_t * hook_dst)
+{
+ uint32_t hooked = uf_link(parents, u, v);
+ if (hook_src != NULL && hooked != UF_NONE){
+  hook_src[hooked] = u;
+  hook_dst[hooked] = v;
+ }
+}
+
+// Link the edges of u not covered by the sampling rounds: the rest of its
+// out-edges, plus all of its in-edges when a separate transpose is given.
+// Returns the number of edges scanned.
+static inline uint64_t link_remaining(uint32_t u,
+  uint32_t * IA, uint32_t * JA, uint32_t * IAc, uint32_t * JAc,
+  uint32_t * parents, uint32_t * hook_src, uint32_t * hook_dst)
+{
+ uint64_t scanned = 0;
+ for (uint32_t edx = IA[u] + AFFOREST_NEIGHBOR_ROUNDS; edx < IA[u+1]; edx++){
+  link_edge(u, JA[edx], parents, hook_src, hook_dst);
+  scanned++;
+ }
+ if (IAc != NULL && IAc != IA){
+  // Recorded as (source, target) of the original directed edge.
+  for (uint32_t edx = IAc[u]; edx < IAc[u+1]; edx++){
+   link_edge(JAc[edx], u, parents, hook_src, hook_dst);
+  }
+  scanned += IAc[u+1] - IAc[u];
+ }
+ return scanned;
+}
+
+static uint32_t afforest(uint32_t * IA, uint32_t * JA,
+  uint32_t * IAc, uint32_t * JAc,
+  uint32_t N, uint32_t * parents,
+  uint32_t * hook_src, uint32_t * hook_dst)
+{
+ if (N == 0) return 0;
+ uf_init(parents, N);
+ uint64_t edges_touched = 0;
+
+ // Link a few neighbors of every vertex to grow large trees cheaply.
+ for (uint32_t r = 0; r < AFFOREST_NEIGHBOR_ROUNDS; r++){
+#pragma omp parallel for schedule(dynamic, 16384) reduction(+:edges_touched)
+  for (uint32_t u = 0; u < N; u++){
+   if (IA[u] + r < IA[u+1]){
+    link_edge(u, JA[IA[u] + r], parents, hook_src, hook_dst);
+    edges_touched++;
+   }
+  }
+  uf_compress(parents, N);
+ }
+
+ // Find the giant component; its members are already connected to the rest
+ // of it and can skip their remaining edges. Without the transpose an edge
+ // from the giant component into another vertex is only visible from its
+ // source, so nothing can be skipped.
+ uint32_t giant = UF_NONE;
+ if (IAc != NULL) giant = sample_frequent_label(parents, N);
+
+#pragma omp parallel for schedule(dynamic, 64) reduction(+:edges_touched)
+ for (uint32_t u = 0; u < N; u++){
+  if (parents[u] == giant) continue;
+  edges_touched += link_remaining(u, IA, JA, IAc, JAc, parents,
+    hook_src, hook_dst);
+ }
+ uf_compress(parents, N);
+
+#ifdef CC_STATS
+ uint64_t total_edges = IA[N];
+ if (IAc != NULL && IAc != IA) total_edges += IAc[N];
+ printf("Afforest touched %lu of %lu edges (%f)\n", edges_touched,
+   total_edges, (double)edges_touched / (double)MAX(total_edges, 1));
+#endif
+ return uf_count_roots(parents, N);
+}
+
+uint32_t afforest_CC(uint32_t * IA, uint32_t * JA,
+  uint32_t * IAc, uint32_t * JAc,
+  uint32_t N, uint32_t * parents)
+{
+ return afforest(IA, JA, IAc, JAc, N, parents, NULL, NULL);
+}
+
+uint32_t afforest_CC_forest(uint32_t * IA, uint32_t * JA,
+  uint32_t * IAc, uint32_t * JAc,
+  uint32_t N, uint32_t * parents,
+  uint32_t * forest_src, uint32_t * forest_dst)
+{
+ if (N == 0) return 0;
+ uint32_t * hook_src = (uint32_t *)malloc(N * sizeof(uint32_t));
+ uint32_t * hook_dst = (uint32_t *)malloc(N * sizeof(uint32_t));
+ if (!hook_src || !hook_dst){
+  fprintf(stderr, "ERROR: could not allocate spanning forest arrays.\n");
+  exit(EXIT_FAILURE);
+ }
+#pragma omp parallel for
+ for (uint32_t v = 0; v < N; v++){
+  hook_src[v] = UF_NONE;
+ }
+
+ uint32_t num_comps = afforest(IA, JA, IAc, JAc, N, parents,
+   hook_src, hook_dst);
+
+ // Compact the hooked roots' edges, in vertex order: count per thread
+ // block, prefix sum the counts, then copy.
+ uint32_t num_threads = omp_get_max_threads();
+ uint32_t * offsets = (uint32_t *)calloc(num_threads + 1, sizeof(uint32_t));
+#pragma omp parallel num_threads(num_threads)
+ {
+  uint32_t tid = omp_get_thread_num();
+  uint32_t nt = omp_get_num_threads();
+  uint32_t chunk = (N + nt - 1) / nt;
+  uint32_t st = MIN(N, tid * chunk);
+  uint32_t nd = MIN(N, st + chunk);
+  uint32_t count = 0;
+  for (uint32_t v = st; v < nd; v++){
+   if (hook_src[v] != UF_NONE) count++;
+  }
+  offsets[tid+1] = count;
+#pragma omp barrier
+#pragma omp single
+  for (uint32_t t = 0; t < nt; t++){
+   offsets[t+1] += offsets[t];
+  }
+  uint32_t out = offsets[tid];
+  for (uint32_t v = st; v < nd; v++){
+   if (hook_src[v] != UF_NONE){
+    forest_src[out] = hook_src[v];
+    forest_dst[out] = hook_dst[v];
+    out++;
+   }
+  }
+ }
+
+ free(offsets);
+ free(hook_src);
+ free(hook_dst);
+ return num_comps;
+}
@@ -0,0 +1,90 @@
+/*
+ * Graph Kernel Collection
+ *
+ * Copyright 2020 Carnegie Mellon University.
+ *
+ * NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ * INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON 
+ * UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR IMPLIED, 
+ * AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF FITNESS FOR 
+ * PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS OBTAINED FROM USE OF 
+ * THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES NOT MAKE ANY WARRANTY OF ANY
+ * KIND WITH RESPECT TO FREEDOM FROM PATENT, TRADEMARK, OR COPYRIGHT 
+ * INFRINGEMENT.
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or
+ * contact permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public
+ * release and unlimited distribution.  Please see Copyright notice for 
+ * non-US Government use and distribution.
+ *
+ * This Software includes and/or makes use of the following Third-Party
+ * Software subject to its own license:
+ *
+ * 1. Matrix Market Loader code (https://math.nist.gov/MatrixMarket/mmio-c.html).
+ *
+ *      The code made publicly available at nist.gov is not marked with a 
+ *      copyright notice and is therefore believed pursuant to section 105 of 
+ *      the Copyright Act, to not be entitled to domestic copyright protection 
+ *      under U.S. law and is therefore in the public domain.  Accordingly, it 
+ *      is believed that no license is required for its use.
+ *
+ * This Software may include certain portions of copyrighted code that is 
+ * initially being released only in binary form for validation and evaluation
+ * purposes. It is expected that source code will be released as open source at
+ * a future date. 
+ *
+ * DM20-0375
+ */
+ 
+#ifndef AFFOREST_H
+#define AFFOREST_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "utils.h"
+#include "union_find.h"
+
+// Number of leading neighbors per vertex linked before the giant component
+// is identified.
+#ifndef AFFOREST_NEIGHBOR_ROUNDS
+#define AFFOREST_NEIGHBOR_ROUNDS 2
+#endif
+
+// Number of vertices sampled to find the most frequent (giant) component.
+#ifndef AFFOREST_NUM_SAMPLES
+#define AFFOREST_NUM_SAMPLES 1024
+#endif
+
+/*
+ * Afforest connected components (Sutton et al., IPDPS 2018).
+ *
+ * Links the first AFFOREST_NEIGHBOR_ROUNDS neighbors of every vertex, samples
+ * the resulting labels to find the largest component, and then only scans
+ * the remaining edges of vertices outside of it. Same interface as CC: on
+ * return parents[v] is the smallest vertex id in v's component, and the
+ * number of components is returned.
+ *
+ * For the full symmetric matrix pass IA/JA again as IAc/JAc. For a directed
+ * graph pass its transpose (from csr_to_csc_parallel) to get weakly connected
+ * components: vertices outside the giant component then scan their in-edges
+ * as well. With IAc == NULL the directed CSR alone is used, which is correct
+ * but cannot skip the giant component.
+ */
+uint32_t afforest_CC(uint32_t * IA, uint32_t * JA,
+  uint32_t * IAc, uint32_t * JAc,
+  uint32_t N, uint32_t * parents);
+
+/*
+ * afforest_CC that also records, for every successful hook, the edge that
+ * caused it. These N - (number of components) edges form a spanning forest
+ * and are written to forest_src/forest_dst (each of at most N-1 entries),
+ * ordered by the root they hooked. Returns the number of components.
+ */
+uint32_t afforest_CC_forest(uint32_t * IA, uint32_t * JA,
+  uint32_t * IAc, uint32_t * JAc,
+  uint32_t N, uint32_t * parents,
+  uint32_t * forest_src, uint32_t * forest_dst);
+#endif
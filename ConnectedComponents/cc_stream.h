@@ -0,0 +1,72 @@
+/*
+ * Graph Kernel Collection
+ *
+ * Copyright 2020 Carnegie Mellon University.
+ *
+ * NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ * INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON 
+ * UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR IMPLIED, 
+ * AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF FITNESS FOR 
+ * PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS OBTAINED FROM USE OF 
+ * THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES NOT MAKE ANY WARRANTY OF ANY
+ * KIND WITH RESPECT TO FREEDOM FROM PATENT, TRADEMARK, OR COPYRIGHT 
+ * INFRINGEMENT.
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or
+ * contact permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public
+ * release and unlimited distribution.  Please see Copyright notice for 
+ * non-US Government use and distribution.
+ *
+ * This Software includes and/or makes use of the following Third-Party
+ * Software subject to its own license:
+ *
+ * 1. Matrix Market Loader code (https://math.nist.gov/MatrixMarket/mmio-c.html).
+ *
+ *      The code made publicly available at nist.gov is not marked with a 
+ *      copyright notice and is therefore believed pursuant to section 105 of 
+ *      the Copyright Act, to not be entitled to domestic copyright protection 
+ *      under U.S. law and is therefore in the public domain.  Accordingly, it 
+ *      is believed that no license is required for its use.
+ *
+ * This Software may include certain portions of copyrighted code that is 
+ * initially being released only in binary form for validation and evaluation
+ * purposes. It is expected that source code will be released as open source at
+ * a future date. 
+ *
+ * DM20-0375
+ */
+ 
+#ifndef CC_STREAM_H
+#define CC_STREAM_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "utils.h"
+#include "union_find.h"
+
+/*
+ * Streaming connected components under edge insertions.
+ *
+ * parents is the labeling from a previous CC, afforest_CC or
+ * cc_insert_batch call (every vertex points, possibly indirectly, at the
+ * smallest vertex id of its component). The batch of undirected edges
+ * (src[i], dst[i]) is linked into it in parallel; only the touched trees are
+ * modified, so the cost is proportional to the batch size rather than to M.
+ * Edges with an endpoint outside [0, N) are ignored.
+ *
+ * Returns the number of component merges, i.e. the old component count
+ * minus the new one. Afterwards parents is a valid union-find forest but no
+ * longer flat: use cc_stream_label for individual lookups, or uf_compress
+ * to restore a flat labeling identical to a full rerun.
+ */
+uint32_t cc_insert_batch(uint32_t * parents, uint32_t N,
+  const uint32_t * src, const uint32_t * dst, uint32_t batch_size);
+
+// Current component label (smallest vertex id) of v.
+inline uint32_t cc_stream_label(uint32_t * parents, uint32_t v){
+ return uf_find(parents, v);
+}
+#endif
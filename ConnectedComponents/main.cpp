@@ -59,6 +59,83 @@ uint32_t CC(uint32_t * IA, uint32_t * JA,
 		       uint32_t * IAc, uint32_t * JAc,
 		       uint32_t N, uint32_t * parents);
 
+// -DAFFOREST swaps the library CC for the in-tree sampling implementation.
+#ifdef AFFOREST
+#include "afforest.h"
+#define CC_KERNEL afforest_CC
+#else
+#define CC_KERNEL CC
+#endif
+
+// -DSPANNING_FOREST also emits a spanning forest (Afforest only).
+#if defined(SPANNING_FOREST) && defined(VERIFY)
+#include "union_find.h"
+// Check that the num_edges forest edges are graph edges, never close a
+// cycle, and that their trees are exactly the components in labels.
+bool check_spanning_forest(uint32_t * IA, uint32_t * JA, uint32_t N,
+			   uint32_t * src, uint32_t * dst, uint32_t num_edges,
+			   uint32_t * labels){
+  uint32_t * comp = (uint32_t *)malloc(N * sizeof(uint32_t));
+  for (uint32_t v = 0; v < N; v++) comp[v] = v;
+  bool passed = true;
+  for (uint32_t edx = 0; edx < num_edges && passed; edx++){
+    uint32_t u = src[edx], v = dst[edx];
+    if (!std::binary_search(JA + IA[u], JA + IA[u+1], v)){
+      printf("Forest edge (%u, %u) is not in the graph\n", u, v);
+      passed = false;
+    }
+    else if (uf_link(comp, u, v) == UF_NONE){
+      printf("Forest edge (%u, %u) closes a cycle\n", u, v);
+      passed = false;
+    }
+  }
+  if (passed){
+    uf_compress(comp, N);
+    for (uint32_t v = 0; v < N && passed; v++){
+      if (comp[v] != labels[v]){
+	printf("%u: forest tree %u != component %u\n", v, comp[v], labels[v]);
+	passed = false;
+      }
+    }
+  }
+  free(comp);
+  return passed;
+}
+#endif
+
+// -DSTREAM_BATCH=<k> additionally times inserting k random edges into the
+// final labeling with cc_insert_batch instead of rerunning CC.
+#ifdef STREAM_BATCH
+#include "cc_stream.h"
+
+#ifdef VERIFY
+// Symmetric CSR of the input graph plus the inserted edges (both ways).
+void csr_with_edges(uint32_t * IA, uint32_t * JA, uint32_t N,
+		    uint32_t * src, uint32_t * dst, uint32_t k,
+		    uint32_t ** IAn, uint32_t ** JAn){
+  uint32_t * deg = (uint32_t *)calloc(N, sizeof(uint32_t));
+  for (uint32_t bdx = 0; bdx < k; bdx++){
+    deg[src[bdx]]++;
+    deg[dst[bdx]]++;
+  }
+  *IAn = (uint32_t *)malloc((N+1)*sizeof(uint32_t));
+  *JAn = (uint32_t *)malloc(((uint64_t)IA[N] + 2*(uint64_t)k)*sizeof(uint32_t));
+  (*IAn)[0] = 0;
+  for (uint32_t v = 0; v < N; v++){
+    (*IAn)[v+1] = (*IAn)[v] + (IA[v+1] - IA[v]) + deg[v];
+    memcpy(*JAn + (*IAn)[v], JA + IA[v], (IA[v+1] - IA[v])*sizeof(uint32_t));
+    deg[v] = (*IAn)[v] + (IA[v+1] - IA[v]); // next free slot
+  }
+  for (uint32_t bdx = 0; bdx < k; bdx++){
+    (*JAn)[deg[src[bdx]]++] = dst[bdx];
+    (*JAn)[deg[dst[bdx]]++] = src[bdx];
+  }
+  sort_neighborhoods(*IAn, *JAn, N);
+  free(deg);
+}
+#endif
+#endif
+
 void usage(char * pname){
 	fprintf(stderr, "USAGE: %s <IA fname> <JA fname>\n", pname);
 	exit(EXIT_FAILURE);
@@ -72,6 +149,7 @@ int main(int argc, char ** argv){
   uint32_t iter=1, last_size;
 
   uint32_t NUM_EDGES;
+  double st, nd;
 
   if (argc < 3)
     {
@@ -95,13 +173,25 @@ int main(int argc, char ** argv){
   read_binary_buffers(argv[1], IA);
   read_binary_buffers(argv[2], JA);
 
+#ifdef WCC
+  // Weakly connected components of a directed graph: pass the transpose
+  // instead of requiring a symmetrized copy of the matrix.
+  IAc = NULL;
+  JAc = NULL;
+  st = omp_get_wtime();
+  if (!csr_to_csc_parallel(IA, JA, &IAc, &JAc, N)){
+    fprintf(stderr, "ERROR: failed to transpose matrix!\n");
+    exit(EXIT_FAILURE);
+  }
+  printf("Transpose time: %f sec\n", omp_get_wtime() - st);
+#else
   IAc = IA;
   JAc = JA;
+#endif
   printf(" %s %u nodes %u edges\n", argv[1], N, IAc[N]);
 
   uint32_t * parents;
 
-  double st, nd;
   char * trunc_fname = truncate_fname(argv[1]);
   double tot_time = 0.0;
 
@@ -114,7 +204,14 @@ int main(int argc, char ** argv){
 
     st = omp_get_wtime();
     parents = (uint32_t *)malloc(N * sizeof(uint32_t));
-    uint32_t num_comps = CC(IA,JA,IAc,JAc,N,parents);
+#ifdef SPANNING_FOREST
+    uint32_t * forest_src = (uint32_t *)malloc(N * sizeof(uint32_t));
+    uint32_t * forest_dst = (uint32_t *)malloc(N * sizeof(uint32_t));
+    uint32_t num_comps = afforest_CC_forest(IA,JA,IAc,JAc,N,parents,
+					    forest_src,forest_dst);
+#else
+    uint32_t num_comps = CC_KERNEL(IA,JA,IAc,JAc,N,parents);
+#endif
     nd = omp_get_wtime();
 
     printf("Round %u, %s, %u, %f sec, %u\n", iter, trunc_fname, num_comps, nd-st, num_threads);
@@ -126,9 +223,19 @@ int main(int argc, char ** argv){
 	  printf("Passed\n");
 	else
 	  printf("Failed\n");
-	
+#ifdef SPANNING_FOREST
+	if (check_spanning_forest(IA, JA, N, forest_src, forest_dst,
+				  N - num_comps, parents))
+	  printf("Passed forest check (%u edges)\n", N - num_comps);
+	else
+	  printf("Failed forest check\n");
+#endif
       }
 #endif
+#ifdef SPANNING_FOREST
+    free(forest_src);
+    free(forest_dst);
+#endif
 
     free(parents);
     tot_time += nd - st;
@@ -136,9 +243,51 @@ int main(int argc, char ** argv){
   }
   printf("Average time: %lf seconds.\n\n", tot_time/ITERS);
 
+#ifdef STREAM_BATCH
+  {
+    uint32_t * src = (uint32_t *)malloc(STREAM_BATCH * sizeof(uint32_t));
+    uint32_t * dst = (uint32_t *)malloc(STREAM_BATCH * sizeof(uint32_t));
+    srand(1);
+    for (uint32_t bdx = 0; bdx < STREAM_BATCH; bdx++){
+      src[bdx] = (uint32_t)((((uint64_t)rand() << 31) ^ rand()) % N);
+      dst[bdx] = (uint32_t)((((uint64_t)rand() << 31) ^ rand()) % N);
+    }
+    parents = (uint32_t *)malloc(N * sizeof(uint32_t));
+    uint32_t num_comps = CC_KERNEL(IA,JA,IAc,JAc,N,parents);
+
+    st = omp_get_wtime();
+    uint32_t merges = cc_insert_batch(parents, N, src, dst, STREAM_BATCH);
+    nd = omp_get_wtime();
+    uf_compress(parents, N);
+    double flat_time = omp_get_wtime() - nd;
+
+    printf("batch edges, merges, num of cc, insert time(s), flatten time(s)\n");
+    printf("Stream, %s, %u, %u, %u, %f sec, %f sec\n", trunc_fname,
+	   STREAM_BATCH, merges, num_comps - merges, nd-st, flat_time);
+#ifdef VERIFY
+    uint32_t * IAn, * JAn;
+    csr_with_edges(IA, JA, N, src, dst, STREAM_BATCH, &IAn, &JAn);
+    if (uf_count_roots(parents, N) == num_comps - merges &&
+	check_CC(IAn, JAn, IAn, JAn, N, parents))
+      printf("Passed\n");
+    else
+      printf("Failed\n");
+    free(IAn);
+    free(JAn);
+#endif
+    free(parents);
+    free(src);
+    free(dst);
+  }
+#endif
+
   free(trunc_fname);
   free(IA);
   free(JA);  
+#ifdef WCC
+  free(IAc);
+  free(JAc);
+#endif
 
   return 0;
 }
@@ -0,0 +1,117 @@
+/*
+ * Graph Kernel Collection
+ *
+ * Copyright 2020 Carnegie Mellon University.
+ *
+ * NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ * INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON 
+ * UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR IMPLIED, 
+ * AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF FITNESS FOR 
+ * PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS OBTAINED FROM USE OF 
+ * THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES NOT MAKE ANY WARRANTY OF ANY
+ * KIND WITH RESPECT TO FREEDOM FROM PATENT, TRADEMARK, OR COPYRIGHT 
+ * INFRINGEMENT.
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or
+ * contact permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public
+ * release and unlimited distribution.  Please see Copyright notice for 
+ * non-US Government use and distribution.
+ *
+ * This Software includes and/or makes use of the following Third-Party
+ * Software subject to its own license:
+ *
+ * 1. Matrix Market Loader code (https://math.nist.gov/MatrixMarket/mmio-c.html).
+ *
+ *      The code made publicly available at nist.gov is not marked with a 
+ *      copyright notice and is therefore believed pursuant to section 105 of 
+ *      the Copyright Act, to not be entitled to domestic copyright protection 
+ *      under U.S. law and is therefore in the public domain.  Accordingly, it 
+ *      is believed that no license is required for its use.
+ *
+ * This Software may include certain portions of copyrighted code that is 
+ * initially being released only in binary form for validation and evaluation
+ * purposes. It is expected that source code will be released as open source at
+ * a future date. 
+ *
+ * DM20-0375
+ */
+ 
+#ifndef UNION_FIND_H
+#define UNION_FIND_H
+
+#include <stdint.h>
+#include <omp.h>
+#include "utils.h"
+
+/*
+ * Lock-free union-find over a parent array.
+ *
+ * Every tree is rooted at its smallest vertex id (links always hook the larger
+ * root under the smaller one), so once the array is fully compressed each
+ * entry holds the minimum vertex id of its component.
+ */
+
+#define UF_NONE UINT32_MAX
+
+inline void uf_init(uint32_t * comp, uint32_t N){
+#pragma omp parallel for
+ for (uint32_t idx = 0; idx < N; idx++){
+  comp[idx] = idx;
+ }
+}
+
+// Find with path halving. Concurrent halving only ever replaces a parent
+// pointer with one of its ancestors, so it is safe alongside uf_link.
+inline uint32_t uf_find(uint32_t * comp, uint32_t v){
+ uint32_t p = comp[v];
+ while (p != comp[p]){
+  uint32_t gp = comp[p];
+  comp[v] = gp;
+  v = p;
+  p = gp;
+ }
+ return p;
+}
+
+// Merge the trees of u and v. Returns the root that was hooked under the
+// other one, or UF_NONE if u and v were already connected. Exactly one
+// successful call hooks any given root.
+inline uint32_t uf_link(uint32_t * comp, uint32_t u, uint32_t v){
+ uint32_t p1 = comp[u];
+ uint32_t p2 = comp[v];
+ while (p1 != p2){
+  uint32_t high = MAX(p1, p2);
+  uint32_t low  = MIN(p1, p2);
+  uint32_t p_high = comp[high];
+  // Already hooked under low by someone else:
+  if (p_high == low) break;
+  if (p_high == high && __sync_bool_compare_and_swap(&comp[high], high, low)){
+   return high;
+  }
+  p1 = comp[comp[high]];
+  p2 = comp[low];
+ }
+ return UF_NONE;
+}
+
+// Point every vertex directly at its root.
+inline void uf_compress(uint32_t * comp, uint32_t N){
+#pragma omp parallel for schedule(dynamic, 16384)
+ for (uint32_t idx = 0; idx < N; idx++){
+  while (comp[idx] != comp[comp[idx]]){
+   comp[idx] = comp[comp[idx]];
+  }
+ }
+}
+
+inline uint32_t uf_count_roots(uint32_t * comp, uint32_t N){
+ uint32_t num_roots = 0;
+#pragma omp parallel for reduction(+:num_roots)
+ for (uint32_t idx = 0; idx < N; idx++){
+  if (comp[idx] == idx) num_roots++;
+ }
+ return num_roots;
+}
+#endif
@@ -0,0 +1,225 @@
+/*
+ * Graph Kernel Collection
+ *
+ * Copyright 2020 Carnegie Mellon University.
+ *
+ * NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ * INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON 
+ * UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR IMPLIED, 
+ * AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF FITNESS FOR 
+ * PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS OBTAINED FROM USE OF 
+ * THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES NOT MAKE ANY WARRANTY OF ANY
+ * KIND WITH RESPECT TO FREEDOM FROM PATENT, TRADEMARK, OR COPYRIGHT 
+ * INFRINGEMENT.
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or
+ * contact permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public
+ * release and unlimited distribution.  Please see Copyright notice for 
+ * non-US Government use and distribution.
+ *
+ * This Software includes and/or makes use of the following Third-Party
+ * Software subject to its own license:
+ *
+ * 1. Matrix Market Loader code (https://math.nist.gov/MatrixMarket/mmio-c.html).
+ *
+ *      The code made publicly available at nist.gov is not marked with a 
+ *      copyright notice and is therefore believed pursuant to section 105 of 
+ *      the Copyright Act, to not be entitled to domestic copyright protection 
+ *      under U.S. law and is therefore in the public domain.  Accordingly, it 
+ *      is believed that no license is required for its use.
+ *
+ * This Software may include certain portions of copyrighted code that is 
+ * initially being released only in binary form for validation and evaluation
+ * purposes. It is expected that source code will be released as open source at
+ * a future date. 
+ *
+ * DM20-0375
+ */
+ 
+#include "graph.h"
+#include "utils.h"
+#include "oracle.h"
+#include "oracle_checker.h"
+#include <omp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <random>
+
+#ifndef ITERS
+#define ITERS 4
+#endif
+
+// Random pairs per round of queries.
+#ifndef ORACLE_QUERIES
+#define ORACLE_QUERIES (4*1024*1024)
+#endif
+
+// Sources whose bounds are checked against exact distances.
+#ifndef ORACLE_CHECK_SOURCES
+#define ORACLE_CHECK_SOURCES 4
+#endif
+
+#ifdef ORACLE_SELECT_DEGREE
+#define ORACLE_SELECT ORACLE_DEGREE
+#else
+#define ORACLE_SELECT ORACLE_FARTHEST
+#endif
+
+void usage(char * pname){
+	fprintf(stderr, "USAGE: %s <IA fname> <JA fname> [<VA fname>|hops [<index fname>]]\n", pname);
+	exit(EXIT_FAILURE);
+}
+
+int main(int argc, char ** argv){
+  uint32_t *IA;
+  uint32_t *JA;
+  uint32_t *A = NULL;
+  double st, nd;
+
+  if (argc < 3)
+    {
+      usage(argv[0]);
+      return 1;
+    }
+
+  uint32_t N = tell_size(argv[1])-1;
+  uint32_t M = tell_size(argv[2]);
+
+  IA = (uint32_t *)malloc((N+1)*sizeof(uint32_t));
+  JA = (uint32_t *)malloc(M*sizeof(uint32_t));
+  if (!IA || !JA ) {
+    fprintf(stderr, "COULD NOT ALLOCATE MEMORY\n");
+    exit(EXIT_FAILURE);
+  }
+  read_binary_buffers(argv[1], IA);
+  read_binary_buffers(argv[2], JA);
+
+  // Without a weights file distances are hop counts.
+  if (argc >= 4 && strcmp(argv[3], "hops") != 0){
+    if (tell_size(argv[3]) != M){
+      fprintf(stderr, "ERROR: %s does not hold %u weights.\n", argv[3], M);
+      exit(EXIT_FAILURE);
+    }
+    A = (uint32_t *)malloc(M*sizeof(uint32_t));
+    if (!A){
+      fprintf(stderr, "COULD NOT ALLOCATE MEMORY\n");
+      exit(EXIT_FAILURE);
+    }
+    read_binary_buffers(argv[3], A);
+  }
+  const char * index_fname = (argc >= 5) ? argv[4] : NULL;
+  printf(" %s %u nodes %u edges\n", argv[1], N, IA[N]);
+
+  // An existing index is mapped instead of rebuilt.
+  oracle_t * o = NULL;
+  if (index_fname){
+    st = omp_get_wtime();
+    o = oracle_map(index_fname);
+    nd = omp_get_wtime();
+    if (o){
+      if (o->N != N || o->weighted != (A != NULL)){
+        fprintf(stderr, "ERROR: %s indexes %u vertices by %s, not %u by %s.\n",
+          index_fname, o->N, o->weighted ? "weight" : "hops",
+          N, A ? "weight" : "hops");
+        exit(EXIT_FAILURE);
+      }
+      printf("Mapped index %s in %f sec\n", index_fname, nd-st);
+    }
+  }
+  if (!o){
+    uint32_t *IAc, *JAc, *Ac = NULL;
+    st = omp_get_wtime();
+#ifdef ORACLE_SYMMETRIC
+    IAc = IA;
+    JAc = JA;
+    Ac = A;
+#else
+    bool transposed = A ? csr_to_csc_weighted(IA, JA, A, &IAc, &JAc, &Ac, N) :
+      csr_to_csc_parallel(IA, JA, &IAc, &JAc, N);
+    if (!transposed){
+      fprintf(stderr, "ERROR: failed to transpose matrix!\n");
+      exit(EXIT_FAILURE);
+    }
+#endif
+    o = oracle_build(IA, JA, A, IAc, JAc, Ac, N, ORACLE_LANDMARKS,
+      ORACLE_SELECT, ORACLE_BITS, 0);
+    nd = omp_get_wtime();
+    printf("Build time: %f sec\n", nd-st);
+#ifndef ORACLE_SYMMETRIC
+    free(IAc);
+    free(JAc);
+    free(Ac);
+#endif
+    if (index_fname && !oracle_save(o, index_fname)){
+      printf("WARNING: could not write index to %s\n", index_fname);
+    }
+  }
+  printf("Landmarks: %u, %u bits, scale %u, table %lu bytes\n",
+    o->num_landmarks, o->bits, o->scale,
+    (unsigned long)oracle_table_bytes(o));
+
+  uint32_t * pairs = (uint32_t *)malloc(2 * (uint64_t)ORACLE_QUERIES * sizeof(uint32_t));
+  if (!pairs){
+    fprintf(stderr, "COULD NOT ALLOCATE MEMORY\n");
+    exit(EXIT_FAILURE);
+  }
+  std::mt19937 gen(27491095);
+  std::uniform_int_distribution<uint32_t> pick(0, MAX(N, 1) - 1);
+  for (uint64_t qdx = 0; qdx < 2 * (uint64_t)ORACLE_QUERIES; qdx++){
+    pairs[qdx] = pick(gen);
+  }
+
+  char * trunc_fname = truncate_fname(argv[1]);
+  double tot_time = 0.0;
+  uint32_t num_threads = omp_get_max_threads();
+
+  printf("Start Distance Oracle Queries\n");
+  printf("round, name, queries, unreachable, time(s), queries/sec, threads\n");
+  for (uint32_t iter = 0; iter < ITERS; iter++){
+    uint64_t unreachable = 0;
+    st = omp_get_wtime();
+#pragma omp parallel for schedule(static, 4096) reduction(+:unreachable)
+    for (uint32_t qdx = 0; qdx < ORACLE_QUERIES; qdx++){
+      oracle_bounds_t b = oracle_bounds(o, pairs[2*qdx], pairs[2*qdx+1]);
+      unreachable += (b.lower == UINT32_MAX);
+    }
+    nd = omp_get_wtime();
+    printf("Round %u, %s, %u, %lu, %f sec, %f, %u\n", iter, trunc_fname,
+      ORACLE_QUERIES, (unsigned long)unreachable, nd-st,
+      ORACLE_QUERIES / (nd-st), num_threads);
+    tot_time += nd - st;
+  }
+  printf("Average time: %lf seconds.\n", tot_time/ITERS);
+
+#ifdef VERIFY
+  oracle_quality_t quality = {0, 0, 0.0, 0, 0.0};
+  bool passed = true;
+  for (uint32_t sdx = 0; sdx < ORACLE_CHECK_SOURCES && sdx < N; sdx++){
+    passed = check_oracle(o, IA, JA, A, N, pairs[sdx], &quality) && passed;
+  }
+  if (quality.pairs){
+    printf("Exact %f, lower/d %f over %lu pairs, upper/d %f over %lu\n",
+      (double)quality.exact / quality.pairs,
+      quality.lower_ratio / quality.pairs, (unsigned long)quality.pairs,
+      quality.with_upper ? quality.upper_ratio / quality.with_upper : 0.0,
+      (unsigned long)quality.with_upper);
+  }
+  if (passed)
+    printf("Passed\n");
+  else
+    printf("Failed\n");
+#endif
+
+  free(pairs);
+  free(trunc_fname);
+  oracle_free(o);
+  free(IA);
+  free(JA);
+  free(A);
+
+  return 0;
+}
@@ -0,0 +1,548 @@
+/*
+ * Graph Kernel Collection
+ *
+ * Copyright 2020 Carnegie Mellon University.
+ *
+ * NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ * INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON 
+ * UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR IMPLIED, 
+ * AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF FITNESS FOR 
+ * PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS OBTAINED FROM USE OF 
+ * THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES NOT MAKE ANY WARRANTY OF ANY
+ * KIND WITH RESPECT TO FREEDOM FROM PATENT, TRADEMARK, OR COPYRIGHT 
+ * INFRINGEMENT.
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or
+ * contact permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public
+ * release and unlimited distribution.  Please see Copyright notice for 
+ * non-US Government use and distribution.
+ *
+ * This Software includes and/or makes use of the following Third-Party
+ * Software subject to its own license:
+ *
+ * 1. Matrix Market Loader code (https://math.nist.gov/MatrixMarket/mmio-c.html).
+ *
+ *      The code made publicly available at nist.gov is not marked with a 
+ *      copyright notice and is therefore believed pursuant to section 105 of 
+ *      the Copyright Act, to not be entitled to domestic copyright protection 
+ *      under U.S. law and is therefore in the public domain.  Accordingly, it 
+ *      is believed that no license is required for its use.
+ *
+ * This Software may include certain portions of copyrighted code that is 
+ * initially being released only in binary form for validation and evaluation
+ * purposes. It is expected that source code will be released as open source at
+ * a future date. 
+ *
+ * DM20-0375
+ */
+ 
+#include "oracle.h"
+#include "graph.h"
+#include "bfs_core.h"
+#include "auto_delta.h"
+#include <immintrin.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <algorithm>
+#include <random>
+
+extern uint32_t sssp( uint32_t * IA, uint32_t * JA, uint32_t *A,
+  uint32_t N, uint32_t * lens, uint32_t src, uint32_t delta);
+
+#define ORACLE_MAGIC "GKCORCL1"
+#define DEPTH_UNKNOWN (UINT32_MAX - 1)
+
+// On-disk header, 64 bytes.
+typedef struct {
+ char magic[8];
+ uint32_t N;
+ uint32_t num_landmarks;
+ uint32_t bits;
+ uint32_t row_len;
+ uint32_t scale;
+ uint32_t symmetric;
+ uint32_t weighted;
+ uint32_t reserved[7];
+} oracle_header_t;
+
+static inline uint32_t inf_code(uint32_t bits){
+ return (uint32_t)((1ull << bits) - 1);
+}
+
+static inline uint32_t max_code(uint32_t bits){
+ return (uint32_t)((1ull << (bits - 1)) - 1);
+}
+
+static inline uint64_t align64(uint64_t bytes){
+ return (bytes + 63) & ~(uint64_t)63;
+}
+
+static uint64_t table_bytes(uint32_t N, uint32_t row_len, uint32_t bits){
+ return align64((uint64_t)N * row_len * (bits / 8));
+}
+
+// Hop counts from the parent tree of par_bfs (parent[src] == src, N for
+// unreached vertices). Each vertex climbs to the nearest vertex whose depth
+// is known and fills in the path on the way back; concurrent climbs over
+// the same path write the same values.
+static void bfs_depths(const PTYPE * parent, uint32_t src, uint32_t * depth,
+  uint32_t N)
+{
+#pragma omp parallel for
+ for (uint32_t v = 0; v < N; v++){
+  depth[v] = (parent[v] == N) ? UINT32_MAX : DEPTH_UNKNOWN;
+ }
+ depth[src] = 0;
+#pragma omp parallel
+ {
+  std::vector<uint32_t> path;
+#pragma omp for schedule(dynamic, 1024)
+  for (uint32_t v = 0; v < N; v++){
+   if (depth[v] != DEPTH_UNKNOWN) continue;
+   path.clear();
+   uint32_t x = v;
+   while (depth[x] == DEPTH_UNKNOWN){
+    path.push_back(x);
+    x = (uint32_t)parent[x];
+   }
+   uint32_t d = depth[x];
+   for (size_t idx = path.size(); idx > 0; idx--){
+    depth[path[idx-1]] = ++d;
+   }
+  }
+ }
+}
+
+// Distances from src over (IA, JA, A) into dist: par_bfs hop counts if A is
+// NULL (IAc/JAc is the transpose it needs), the library sssp otherwise.
+static void distances_from(uint32_t * IA, uint32_t * JA, uint32_t * A,
+  uint32_t * IAc, uint32_t * JAc, uint32_t N, uint32_t src,
+  uint32_t delta, PTYPE * parent, uint32_t * dist)
+{
+ if (A == NULL){
+  par_bfs(src, parent, IA, JA, IAc, JAc, N);
+  bfs_depths(parent, src, dist, N);
+ } else {
+  sssp(IA, JA, A, N, dist, src, delta);
+ }
+}
+
+// Vertex with the largest finite dist (smallest id on ties), or N if none
+// is above zero.
+static uint32_t farthest_vertex(const uint32_t * dist, uint32_t N){
+ uint32_t best_v = N;
+ uint32_t best = 0;
+#pragma omp parallel
+ {
+  uint32_t t_v = N;
+  uint32_t t_best = 0;
+#pragma omp for nowait
+  for (uint32_t v = 0; v < N; v++){
+   if (dist[v] != UINT32_MAX && dist[v] > t_best){
+    t_best = dist[v];
+    t_v = v;
+   }
+  }
+#pragma omp critical
+  if (t_best > best || (t_best == best && t_v < best_v)){
+   best = t_best;
+   best_v = t_v;
+  }
+ }
+ return best_v;
+}
+
+// First vertex at or after start (cyclically) that no landmark reaches, or
+// N if they all do.
+static uint32_t uncovered_vertex(const uint32_t * mind, uint32_t N,
+  uint32_t start)
+{
+ for (uint32_t idx = 0; idx < N; idx++){
+  uint32_t v = (start + idx) % N;
+  if (mind[v] == UINT32_MAX) return v;
+ }
+ return N;
+}
+
+// Quantize the columns into vertex-major rows of T, padding with infinity.
+template <typename T>
+static void fill_rows(const uint32_t * cols, T * rows, uint32_t K,
+  uint32_t row_len, uint32_t N, uint32_t scale, uint32_t bits)
+{
+ T inf = (T)inf_code(bits);
+#pragma omp parallel for schedule(dynamic, 1024)
+ for (uint32_t v = 0; v < N; v++){
+  T * row = rows + (uint64_t)v * row_len;
+  for (uint32_t i = 0; i < K; i++){
+   uint32_t d = cols[(uint64_t)i * N + v];
+   row[i] = (d == UINT32_MAX) ? inf : (T)(d / scale);
+  }
+  for (uint32_t i = K; i < row_len; i++){
+   row[i] = inf;
+  }
+ }
+}
+
+static void * alloc_rows(const uint32_t * cols, uint32_t K,
+  uint32_t row_len, uint32_t N, uint32_t scale, uint32_t bits)
+{
+ void * rows = aligned_alloc(64, MAX(table_bytes(N, row_len, bits), 64));
+ if (!rows){
+  fprintf(stderr, "ERROR: could not allocate oracle table.\n");
+  exit(EXIT_FAILURE);
+ }
+ if (bits == 8){
+  fill_rows(cols, (uint8_t *)rows, K, row_len, N, scale, bits);
+ } else if (bits == 16){
+  fill_rows(cols, (uint16_t *)rows, K, row_len, N, scale, bits);
+ } else {
+  fill_rows(cols, (uint32_t *)rows, K, row_len, N, scale, bits);
+ }
+ return rows;
+}
+
+oracle_t * oracle_build(uint32_t * IA, uint32_t * JA, uint32_t * A,
+  uint32_t * IAc, uint32_t * JAc, uint32_t * Ac, uint32_t N,
+  uint32_t num_landmarks, oracle_select_t select, uint32_t bits,
+  uint32_t delta)
+{
+ if (bits != 8 && bits != 16 && bits != 32){
+  fprintf(stderr, "ERROR: oracle distances must be 8, 16 or 32 bits.\n");
+  exit(EXIT_FAILURE);
+ }
+ oracle_t * o = (oracle_t *)calloc(1, sizeof(oracle_t));
+ if (!o){
+  fprintf(stderr, "ERROR: could not allocate oracle.\n");
+  exit(EXIT_FAILURE);
+ }
+ uint32_t K = MIN(num_landmarks, N);
+ bool symmetric = (IAc == IA);
+ uint32_t * cols = (uint32_t *)malloc(MAX((uint64_t)K * N, 1) *
+   (symmetric ? 1 : 2) * sizeof(uint32_t));
+ uint32_t * mind = (uint32_t *)malloc(MAX(N, 1) * sizeof(uint32_t));
+ PTYPE * parent = (A == NULL) ?
+   (PTYPE *)malloc(MAX(N, 1) * sizeof(PTYPE)) : NULL;
+ o->landmarks = (uint32_t *)malloc(MAX(K, 1) * sizeof(uint32_t));
+ if (!cols || !mind || (A == NULL && !parent) || !o->landmarks){
+  fprintf(stderr, "ERROR: could not allocate oracle work arrays.\n");
+  exit(EXIT_FAILURE);
+ }
+ if (A != NULL && delta == 0) delta = sssp_auto_delta(IA, JA, A, N);
+
+ // Distances from the landmarks, column by column.
+ uint32_t num = 0;
+ if (select == ORACLE_DEGREE){
+  std::vector<uint32_t> by_degree(N);
+  for (uint32_t v = 0; v < N; v++) by_degree[v] = v;
+  auto degree = [&](uint32_t v){
+   uint32_t deg = IA[v+1] - IA[v];
+   return symmetric ? deg : deg + (IAc[v+1] - IAc[v]);
+  };
+  std::partial_sort(by_degree.begin(), by_degree.begin() + K,
+    by_degree.end(), [&](uint32_t a, uint32_t b){
+     uint32_t da = degree(a), db = degree(b);
+     return da > db || (da == db && a < b);
+    });
+  for (num = 0; num < K; num++){
+   o->landmarks[num] = by_degree[num];
+   distances_from(IA, JA, A, IAc, JAc, N, o->landmarks[num], delta, parent,
+     cols + (uint64_t)num * N);
+  }
+ } else if (K > 0){
+  std::mt19937 gen(27491095);
+  std::uniform_int_distribution<uint32_t> pick(0, N-1);
+  uint32_t start = pick(gen);
+  distances_from(IA, JA, A, IAc, JAc, N, start, delta, parent, cols);
+  uint32_t next = farthest_vertex(cols, N);
+  if (next == N) next = start;
+  while (num < K){
+   uint32_t * col = cols + (uint64_t)num * N;
+   o->landmarks[num] = next;
+   distances_from(IA, JA, A, IAc, JAc, N, next, delta, parent, col);
+#pragma omp parallel for
+   for (uint32_t v = 0; v < N; v++){
+    mind[v] = (num == 0) ? col[v] : MIN(mind[v], col[v]);
+   }
+   num++;
+   // Once the reachable part is covered, start on another component.
+   next = farthest_vertex(mind, N);
+   if (next == N) next = uncovered_vertex(mind, N, pick(gen));
+   if (next == N) break;
+  }
+ }
+ K = num;
+
+ // Distances to the landmarks, on the transpose.
+ uint32_t * to_cols = symmetric ? cols : cols + (uint64_t)K * N;
+ if (!symmetric){
+  for (uint32_t i = 0; i < K; i++){
+   distances_from(IAc, JAc, Ac, IA, JA, N, o->landmarks[i], delta, parent,
+     to_cols + (uint64_t)i * N);
+  }
+ }
+
+ uint32_t max_dist = 0;
+ uint64_t num_dists = (uint64_t)K * N * (symmetric ? 1 : 2);
+#pragma omp parallel for reduction(max:max_dist)
+ for (uint64_t idx = 0; idx < num_dists; idx++){
+  if (cols[idx] != UINT32_MAX) max_dist = MAX(max_dist, cols[idx]);
+ }
+
+ o->N = N;
+ o->num_landmarks = K;
+ o->bits = bits;
+ o->row_len = (uint32_t)((((uint64_t)K * (bits / 8) + 15) / 16) * 16 /
+   (bits / 8));
+ o->scale = MAX(1, (uint32_t)(((uint64_t)max_dist + max_code(bits) - 1) /
+   max_code(bits)));
+ o->symmetric = symmetric;
+ o->weighted = (A != NULL);
+ o->from = alloc_rows(cols, K, o->row_len, N, o->scale, bits);
+ o->to = symmetric ? o->from :
+   alloc_rows(to_cols, K, o->row_len, N, o->scale, bits);
+ free(cols);
+ free(mind);
+ free(parent);
+ return o;
+}
+
+static bool write_padded(FILE * fptr, const void * data, uint64_t bytes){
+ static const char zeros[64] = {0};
+ if (bytes && fwrite(data, 1, bytes, fptr) != bytes) return false;
+ uint64_t pad = align64(bytes) - bytes;
+ return pad == 0 || fwrite(zeros, 1, pad, fptr) == pad;
+}
+
+bool oracle_save(const oracle_t * o, const char * fname){
+ FILE * fptr = fopen(fname, "wb");
+ if (fptr == NULL) return false;
+ oracle_header_t hdr;
+ memset(&hdr, 0, sizeof(hdr));
+ memcpy(hdr.magic, ORACLE_MAGIC, sizeof(hdr.magic));
+ hdr.N = o->N;
+ hdr.num_landmarks = o->num_landmarks;
+ hdr.bits = o->bits;
+ hdr.row_len = o->row_len;
+ hdr.scale = o->scale;
+ hdr.symmetric = o->symmetric;
+ hdr.weighted = o->weighted;
+ uint64_t bytes = table_bytes(o->N, o->row_len, o->bits);
+ bool ok = write_padded(fptr, &hdr, sizeof(hdr)) &&
+   write_padded(fptr, o->landmarks,
+     (uint64_t)o->num_landmarks * sizeof(uint32_t)) &&
+   write_padded(fptr, o->from, bytes) &&
+   (o->symmetric || write_padded(fptr, o->to, bytes));
+ return (fclose(fptr) == 0) && ok;
+}
+
+oracle_t * oracle_map(const char * fname){
+ int fd = open(fname, O_RDONLY);
+ if (fd < 0) return NULL;
+ struct stat sb;
+ if (fstat(fd, &sb) != 0 || (size_t)sb.st_size < sizeof(oracle_header_t)){
+  close(fd);
+  return NULL;
+ }
+ size_t map_bytes = sb.st_size;
+ void * map = mmap(NULL, map_bytes, PROT_READ, MAP_SHARED, fd, 0);
+ close(fd);
+ if (map == MAP_FAILED) return NULL;
+
+ const oracle_header_t * hdr = (const oracle_header_t *)map;
+ uint64_t lm_bytes = align64((uint64_t)hdr->num_landmarks * sizeof(uint32_t));
+ bool valid = memcmp(hdr->magic, ORACLE_MAGIC, sizeof(hdr->magic)) == 0 &&
+   (hdr->bits == 8 || hdr->bits == 16 || hdr->bits == 32) &&
+   hdr->row_len >= hdr->num_landmarks &&
+   ((uint64_t)hdr->row_len * (hdr->bits / 8)) % 16 == 0;
+ uint64_t bytes = valid ? table_bytes(hdr->N, hdr->row_len, hdr->bits) : 0;
+ if (!valid || map_bytes != sizeof(oracle_header_t) + lm_bytes +
+     bytes * (hdr->symmetric ? 1 : 2)){
+  munmap(map, map_bytes);
+  return NULL;
+ }
+ oracle_t * o = (oracle_t *)calloc(1, sizeof(oracle_t));
+ if (!o){
+  fprintf(stderr, "ERROR: could not allocate oracle.\n");
+  exit(EXIT_FAILURE);
+ }
+ char * base = (char *)map;
+ o->N = hdr->N;
+ o->num_landmarks = hdr->num_landmarks;
+ o->bits = hdr->bits;
+ o->row_len = hdr->row_len;
+ o->scale = hdr->scale;
+ o->symmetric = hdr->symmetric;
+ o->weighted = hdr->weighted;
+ o->landmarks = (uint32_t *)(base + sizeof(oracle_header_t));
+ o->from = base + sizeof(oracle_header_t) + lm_bytes;
+ o->to = o->symmetric ? o->from : (char *)o->from + bytes;
+ o->map = map;
+ o->map_bytes = map_bytes;
+ return o;
+}
+
+void oracle_free(oracle_t * o){
+ if (o->map){
+  munmap(o->map, o->map_bytes);
+ } else {
+  if (o->to != o->from) free(o->to);
+  free(o->from);
+  free(o->landmarks);
+ }
+ free(o);
+}
+
+uint64_t oracle_table_bytes(const oracle_t * o){
+ return table_bytes(o->N, o->row_len, o->bits) * (o->symmetric ? 1 : 2);
+}
+
+// Saturating code arithmetic. The sum saturates at the infinity code (the
+// largest value of T); finite codes are small enough never to reach it.
+template <typename T>
+static inline T code_sub(T a, T b){
+ return a > b ? a - b : 0;
+}
+
+template <typename T>
+static inline T code_add(T a, T b){
+ uint64_t sum = (uint64_t)a + b;
+ return sum > (T)~(T)0 ? (T)~(T)0 : (T)sum;
+}
+
+#ifdef __AVX2__
+// Unsigned lane operations per code width. AVX2 has no saturating 32-bit
+// forms: subtraction goes through the maximum, and since finite codes are
+// below 2^31 a 32-bit sum can only wrap when one side is infinite, in which
+// case the maximum of the operands is the infinity code. The 128-bit forms
+// handle a row (or row tail) of 16 bytes.
+template <typename T> struct oracle_lanes_t;
+
+template <> struct oracle_lanes_t<uint8_t> {
+ static inline __m256i sub(__m256i a, __m256i b){ return _mm256_subs_epu8(a, b); }
+ static inline __m256i add(__m256i a, __m256i b){ return _mm256_adds_epu8(a, b); }
+ static inline __m256i min(__m256i a, __m256i b){ return _mm256_min_epu8(a, b); }
+ static inline __m256i max(__m256i a, __m256i b){ return _mm256_max_epu8(a, b); }
+ static inline __m128i sub(__m128i a, __m128i b){ return _mm_subs_epu8(a, b); }
+ static inline __m128i add(__m128i a, __m128i b){ return _mm_adds_epu8(a, b); }
+ static inline __m128i min(__m128i a, __m128i b){ return _mm_min_epu8(a, b); }
+ static inline __m128i max(__m128i a, __m128i b){ return _mm_max_epu8(a, b); }
+};
+
+template <> struct oracle_lanes_t<uint16_t> {
+ static inline __m256i sub(__m256i a, __m256i b){ return _mm256_subs_epu16(a, b); }
+ static inline __m256i add(__m256i a, __m256i b){ return _mm256_adds_epu16(a, b); }
+ static inline __m256i min(__m256i a, __m256i b){ return _mm256_min_epu16(a, b); }
+ static inline __m256i max(__m256i a, __m256i b){ return _mm256_max_epu16(a, b); }
+ static inline __m128i sub(__m128i a, __m128i b){ return _mm_subs_epu16(a, b); }
+ static inline __m128i add(__m128i a, __m128i b){ return _mm_adds_epu16(a, b); }
+ static inline __m128i min(__m128i a, __m128i b){ return _mm_min_epu16(a, b); }
+ static inline __m128i max(__m128i a, __m128i b){ return _mm_max_epu16(a, b); }
+};
+
+template <> struct oracle_lanes_t<uint32_t> {
+ static inline __m256i sub(__m256i a, __m256i b){
+  return _mm256_sub_epi32(_mm256_max_epu32(a, b), b);
+ }
+ static inline __m256i add(__m256i a, __m256i b){
+  return _mm256_max_epu32(_mm256_add_epi32(a, b), _mm256_max_epu32(a, b));
+ }
+ static inline __m256i min(__m256i a, __m256i b){ return _mm256_min_epu32(a, b); }
+ static inline __m256i max(__m256i a, __m256i b){ return _mm256_max_epu32(a, b); }
+ static inline __m128i sub(__m128i a, __m128i b){
+  return _mm_sub_epi32(_mm_max_epu32(a, b), b);
+ }
+ static inline __m128i add(__m128i a, __m128i b){
+  return _mm_max_epu32(_mm_add_epi32(a, b), _mm_max_epu32(a, b));
+ }
+ static inline __m128i min(__m128i a, __m128i b){ return _mm_min_epu32(a, b); }
+ static inline __m128i max(__m128i a, __m128i b){ return _mm_max_epu32(a, b); }
+};
+#endif
+
+// Largest landmark difference (lower) and smallest landmark sum (upper), in
+// codes, over the rows of u and v.
+template <typename T>
+static inline void scan_rows(const oracle_t * o, uint32_t u, uint32_t v,
+  uint32_t * lower, uint32_t * upper)
+{
+ uint64_t len = o->row_len;
+ const T * fu = (const T *)o->from + u * len;
+ const T * fv = (const T *)o->from + v * len;
+ const T * tu = (const T *)o->to + u * len;
+ const T * tv = (const T *)o->to + v * len;
+ T lo = 0, up = (T)~(T)0;
+#ifdef __AVX2__
+ typedef oracle_lanes_t<T> L;
+ const uint32_t width = 32 / sizeof(T);
+ __m256i vlo = _mm256_setzero_si256();
+ __m256i vup = _mm256_set1_epi8((char)0xFF);
+ uint32_t i = 0;
+ for (; i + width <= len; i += width){
+  __m256i a = _mm256_loadu_si256((const __m256i *)(fu + i));
+  __m256i b = _mm256_loadu_si256((const __m256i *)(fv + i));
+  __m256i c = _mm256_loadu_si256((const __m256i *)(tu + i));
+  __m256i d = _mm256_loadu_si256((const __m256i *)(tv + i));
+  vlo = L::max(vlo, L::max(L::sub(b, a), L::sub(c, d)));
+  vup = L::min(vup, L::add(c, b));
+ }
+ // Fold to 128 bits; rows are padded to 16 bytes, so at most one half
+ // vector is left.
+ __m128i hlo = L::max(_mm256_castsi256_si128(vlo),
+   _mm256_extracti128_si256(vlo, 1));
+ __m128i hup = L::min(_mm256_castsi256_si128(vup),
+   _mm256_extracti128_si256(vup, 1));
+ if (i < len){
+  __m128i a = _mm_loadu_si128((const __m128i *)(fu + i));
+  __m128i b = _mm_loadu_si128((const __m128i *)(fv + i));
+  __m128i c = _mm_loadu_si128((const __m128i *)(tu + i));
+  __m128i d = _mm_loadu_si128((const __m128i *)(tv + i));
+  hlo = L::max(hlo, L::max(L::sub(b, a), L::sub(c, d)));
+  hup = L::min(hup, L::add(c, b));
+ }
+ T lanes_lo[16 / sizeof(T)], lanes_up[16 / sizeof(T)];
+ _mm_storeu_si128((__m128i *)lanes_lo, hlo);
+ _mm_storeu_si128((__m128i *)lanes_up, hup);
+ for (i = 0; i < 16 / sizeof(T); i++){
+  lo = MAX(lo, lanes_lo[i]);
+  up = MIN(up, lanes_up[i]);
+ }
+#else
+ for (uint32_t i = 0; i < len; i++){
+  lo = MAX(lo, MAX(code_sub(fv[i], fu[i]), code_sub(tu[i], tv[i])));
+  up = MIN(up, code_add(tu[i], fv[i]));
+ }
+#endif
+ *lower = lo;
+ *upper = up;
+}
+
+oracle_bounds_t oracle_bounds(const oracle_t * o, uint32_t u, uint32_t v){
+ oracle_bounds_t bounds = {0, 0};
+ if (u == v) return bounds;
+ uint32_t lo, up;
+ if (o->bits == 8){
+  scan_rows<uint8_t>(o, u, v, &lo, &up);
+ } else if (o->bits == 16){
+  scan_rows<uint16_t>(o, u, v, &lo, &up);
+ } else {
+  scan_rows<uint32_t>(o, u, v, &lo, &up);
+ }
+ // A difference above every finite code involves the infinity code on the
+ // side that proves v unreachable: a landmark reaches u but not v, or v
+ // reaches a landmark that u cannot.
+ if (lo > max_code(o->bits)){
+  bounds.lower = UINT32_MAX;
+  bounds.upper = UINT32_MAX;
+  return bounds;
+ }
+ // A code c stands for a distance in [c*scale, c*scale + scale - 1].
+ uint64_t scale = o->scale, slack = scale - 1;
+ bounds.lower = (lo == 0) ? 0 : (uint32_t)MIN(lo * scale - slack,
+   (uint64_t)UINT32_MAX - 1);
+ bounds.upper = (up == inf_code(o->bits)) ? UINT32_MAX :
+   (uint32_t)MIN(up * scale + 2 * slack, (uint64_t)UINT32_MAX - 1);
+ return bounds;
+}
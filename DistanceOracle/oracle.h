@@ -0,0 +1,142 @@
+/*
+ * Graph Kernel Collection
+ *
+ * Copyright 2020 Carnegie Mellon University.
+ *
+ * NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ * INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON 
+ * UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR IMPLIED, 
+ * AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF FITNESS FOR 
+ * PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS OBTAINED FROM USE OF 
+ * THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES NOT MAKE ANY WARRANTY OF ANY
+ * KIND WITH RESPECT TO FREEDOM FROM PATENT, TRADEMARK, OR COPYRIGHT 
+ * INFRINGEMENT.
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or
+ * contact permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public
+ * release and unlimited distribution.  Please see Copyright notice for 
+ * non-US Government use and distribution.
+ *
+ * This Software includes and/or makes use of the following Third-Party
+ * Software subject to its own license:
+ *
+ * 1. Matrix Market Loader code (https://math.nist.gov/MatrixMarket/mmio-c.html).
+ *
+ *      The code made publicly available at nist.gov is not marked with a 
+ *      copyright notice and is therefore believed pursuant to section 105 of 
+ *      the Copyright Act, to not be entitled to domestic copyright protection 
+ *      under U.S. law and is therefore in the public domain.  Accordingly, it 
+ *      is believed that no license is required for its use.
+ *
+ * This Software may include certain portions of copyrighted code that is 
+ * initially being released only in binary form for validation and evaluation
+ * purposes. It is expected that source code will be released as open source at
+ * a future date. 
+ *
+ * DM20-0375
+ */
+ 
+#ifndef ORACLE_H
+#define ORACLE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <omp.h>
+#include "utils.h"
+
+// Default number of landmarks.
+#ifndef ORACLE_LANDMARKS
+#define ORACLE_LANDMARKS 16
+#endif
+
+// Default bits per stored distance: 8, 16 or 32.
+#ifndef ORACLE_BITS
+#define ORACLE_BITS 16
+#endif
+
+typedef enum {
+ ORACLE_FARTHEST,         // farthest-first from a random start
+ ORACLE_DEGREE            // highest out- plus in-degree
+} oracle_select_t;
+
+/*
+ * Landmark distance oracle.
+ *
+ * For every vertex v and landmark i the index stores d(landmark i, v) in
+ * from and d(v, landmark i) in to, vertex-major: the K codes of a vertex
+ * are one row of row_len entries, padded to a multiple of 16 bytes with
+ * the infinity code so a row is whole 256-bit vectors plus at most one
+ * 128-bit half. For a symmetric graph to aliases from.
+ *
+ * A distance d is stored as the code d / scale. Finite codes are at most
+ * 2^(bits-1) - 1 and unreachable vertices hold 2^bits - 1, so the sum of
+ * two finite codes still fits and every difference involving the infinity
+ * code is larger than any finite one. With scale == 1 the table is exact.
+ *
+ * map is non-NULL for an index opened with oracle_map; the tables then
+ * point into the read-only mapping.
+ */
+typedef struct {
+ uint32_t N;
+ uint32_t num_landmarks;
+ uint32_t bits;
+ uint32_t row_len;        // entries per row, including padding
+ uint32_t scale;
+ bool symmetric;
+ bool weighted;           // false for hop counts
+ uint32_t * landmarks;
+ void * from;
+ void * to;
+ void * map;
+ size_t map_bytes;
+} oracle_t;
+
+typedef struct {
+ uint32_t lower;          // UINT32_MAX: v is unreachable from u
+ uint32_t upper;          // UINT32_MAX: no landmark path from u to v
+} oracle_bounds_t;
+
+/*
+ * Build the index over the CSR (IA, JA).
+ *
+ * With A == NULL distances are hop counts from par_bfs (depths recovered
+ * from its parent tree); otherwise A holds the weights and the library
+ * sssp is run with bucket width delta (0 for sssp_auto_delta). Pass the
+ * transpose as IAc/JAc/Ac for the distances to the landmarks, or IA/JA/A
+ * again for a symmetric graph, which halves the index. Farthest-first
+ * moves on to a vertex no landmark reaches once every reachable one is
+ * covered, and keeps fewer than num_landmarks only if all vertices are
+ * landmarks or at distance 0 from one. While building, the distances are
+ * held at 32 bits, column by column, before being quantized to bits (8, 16
+ * or 32) into the rows, so weighted distances must fit in 32 bits.
+ */
+oracle_t * oracle_build(uint32_t * IA, uint32_t * JA, uint32_t * A,
+  uint32_t * IAc, uint32_t * JAc, uint32_t * Ac, uint32_t N,
+  uint32_t num_landmarks, oracle_select_t select, uint32_t bits,
+  uint32_t delta);
+
+// Write the index as one file: a 64-byte header, the landmark ids and the
+// tables, each section 64-byte aligned. Returns false on a write error.
+bool oracle_save(const oracle_t * o, const char * fname);
+
+// Open an index written by oracle_save with mmap, without reading the
+// tables. Returns NULL if the file is missing or not an index.
+oracle_t * oracle_map(const char * fname);
+
+void oracle_free(oracle_t * o);
+
+// Bytes taken by the tables.
+uint64_t oracle_table_bytes(const oracle_t * o);
+
+/*
+ * Bounds on d(u, v): the largest difference d(L, v) - d(L, u) or
+ * d(u, L) - d(v, L) over the landmarks L below, and the smallest
+ * d(u, L) + d(L, v) above, widened by the quantization error when
+ * scale > 1. Both rows are scanned with AVX2 min/max when available.
+ * Thread safe.
+ */
+oracle_bounds_t oracle_bounds(const oracle_t * o, uint32_t u, uint32_t v);
+#endif
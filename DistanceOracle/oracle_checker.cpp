@@ -0,0 +1,105 @@
+/*
+ * Graph Kernel Collection
+ *
+ * Copyright 2020 Carnegie Mellon University.
+ *
+ * NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ * INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON 
+ * UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR IMPLIED, 
+ * AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF FITNESS FOR 
+ * PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS OBTAINED FROM USE OF 
+ * THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES NOT MAKE ANY WARRANTY OF ANY
+ * KIND WITH RESPECT TO FREEDOM FROM PATENT, TRADEMARK, OR COPYRIGHT 
+ * INFRINGEMENT.
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or
+ * contact permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public
+ * release and unlimited distribution.  Please see Copyright notice for 
+ * non-US Government use and distribution.
+ *
+ * This Software includes and/or makes use of the following Third-Party
+ * Software subject to its own license:
+ *
+ * 1. Matrix Market Loader code (https://math.nist.gov/MatrixMarket/mmio-c.html).
+ *
+ *      The code made publicly available at nist.gov is not marked with a 
+ *      copyright notice and is therefore believed pursuant to section 105 of 
+ *      the Copyright Act, to not be entitled to domestic copyright protection 
+ *      under U.S. law and is therefore in the public domain.  Accordingly, it 
+ *      is believed that no license is required for its use.
+ *
+ * This Software may include certain portions of copyrighted code that is 
+ * initially being released only in binary form for validation and evaluation
+ * purposes. It is expected that source code will be released as open source at
+ * a future date. 
+ *
+ * DM20-0375
+ */
+ 
+#include "oracle_checker.h"
+#include <queue>
+#include <functional>
+#include <utility>
+
+bool check_oracle(const oracle_t * o, uint32_t * IA, uint32_t * JA,
+  uint32_t * A, uint32_t N, uint32_t src, oracle_quality_t * quality)
+{
+ typedef std::pair<uint64_t, uint32_t> entry_t;
+ const uint64_t INF = UINT64_MAX;
+ std::vector<uint64_t> dist(N, INF);
+ std::priority_queue<entry_t, std::vector<entry_t>, std::greater<entry_t> > pq;
+ dist[src] = 0;
+ pq.push(entry_t(0, src));
+ while (!pq.empty()){
+  entry_t top = pq.top();
+  pq.pop();
+  uint32_t u = top.second;
+  if (top.first > dist[u]) continue;
+  for (uint32_t edx = IA[u]; edx < IA[u+1]; edx++){
+   uint64_t nd = dist[u] + (A ? A[edx] : 1);
+   if (nd < dist[JA[edx]]){
+    dist[JA[edx]] = nd;
+    pq.push(entry_t(nd, JA[edx]));
+   }
+  }
+ }
+
+ uint32_t num_errors = 0, overflows = 0;
+ for (uint32_t v = 0; v < N; v++){
+  if (dist[v] != INF && dist[v] >= UINT32_MAX){
+   overflows++;
+   continue;
+  }
+  oracle_bounds_t b = oracle_bounds(o, src, v);
+  bool ok;
+  if (dist[v] == INF){
+   ok = (b.upper == UINT32_MAX);
+  } else {
+   ok = (b.lower != UINT32_MAX && b.lower <= dist[v] &&
+     (b.upper == UINT32_MAX || b.upper >= dist[v]));
+   if (ok && quality && dist[v] > 0){
+    quality->pairs++;
+    quality->exact += (b.lower == b.upper);
+    quality->lower_ratio += (double)b.lower / dist[v];
+    if (b.upper != UINT32_MAX){
+     quality->with_upper++;
+     quality->upper_ratio += (double)b.upper / dist[v];
+    }
+   }
+  }
+  if (!ok){
+   if (num_errors < 10){
+    printf("%u -> %u: distance %lu outside [%u, %u]\n", src, v,
+      (unsigned long)dist[v], b.lower, b.upper);
+   }
+   num_errors++;
+  }
+ }
+ if (overflows){
+  printf("%u distances from %u overflow 32 bits\n", overflows, src);
+ }
+ if (num_errors) printf("%u bounds from %u are wrong\n", num_errors, src);
+ return num_errors == 0 && overflows == 0;
+}
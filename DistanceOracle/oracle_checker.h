@@ -0,0 +1,72 @@
+/*
+ * Graph Kernel Collection
+ *
+ * Copyright 2020 Carnegie Mellon University.
+ *
+ * NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ * INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON 
+ * UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR IMPLIED, 
+ * AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF FITNESS FOR 
+ * PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS OBTAINED FROM USE OF 
+ * THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES NOT MAKE ANY WARRANTY OF ANY
+ * KIND WITH RESPECT TO FREEDOM FROM PATENT, TRADEMARK, OR COPYRIGHT 
+ * INFRINGEMENT.
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or
+ * contact permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public
+ * release and unlimited distribution.  Please see Copyright notice for 
+ * non-US Government use and distribution.
+ *
+ * This Software includes and/or makes use of the following Third-Party
+ * Software subject to its own license:
+ *
+ * 1. Matrix Market Loader code (https://math.nist.gov/MatrixMarket/mmio-c.html).
+ *
+ *      The code made publicly available at nist.gov is not marked with a 
+ *      copyright notice and is therefore believed pursuant to section 105 of 
+ *      the Copyright Act, to not be entitled to domestic copyright protection 
+ *      under U.S. law and is therefore in the public domain.  Accordingly, it 
+ *      is believed that no license is required for its use.
+ *
+ * This Software may include certain portions of copyrighted code that is 
+ * initially being released only in binary form for validation and evaluation
+ * purposes. It is expected that source code will be released as open source at
+ * a future date. 
+ *
+ * DM20-0375
+ */
+ 
+#ifndef __ORACLE_CHECKER_H__
+#define __ORACLE_CHECKER_H__
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <vector>
+#include "utils.h"
+#include "oracle.h"
+
+// How tight the bounds are, summed over the pairs checked that are
+// reachable and at positive distance.
+typedef struct {
+ uint64_t pairs;
+ uint64_t exact;          // lower == upper
+ double lower_ratio;      // sum of lower / d
+ uint64_t with_upper;     // pairs with a finite upper bound
+ double upper_ratio;      // sum of upper / d over those
+} oracle_quality_t;
+
+/*
+ * Compare oracle_bounds(o, src, v) for every v with exact distances from a
+ * serial BFS (A == NULL) or Dijkstra over the CSR: lower <= d <= upper,
+ * with lower == UINT32_MAX only for unreachable v and upper == UINT32_MAX
+ * for all of them. Distances that do not fit in 32 bits (which the library
+ * sssp cannot produce) fail the check as overflows. quality is added to
+ * and may be NULL.
+ */
+bool check_oracle(const oracle_t * o, uint32_t * IA, uint32_t * JA,
+  uint32_t * A, uint32_t N, uint32_t src, oracle_quality_t * quality);
+
+#endif
@@ -40,25 +40,162 @@
  
 #include "graph.h"
 #include "utils.h"
+#include "anytime.h"
 #include <omp.h>
 #include <math.h>
 #include <immintrin.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdint.h>
+#include <string.h>
+#include <vector>
 
 #ifndef ITERS
 #define ITERS 16
 #endif
 
+// -DANYTIME_MS=<ms> stops the in-tree kernels (-DSEGMENTED or -DDELTA) at a
+// deadline and reports the error bound of the returned ranks.
+#if defined(ANYTIME_MS) && !defined(SEGMENTED) && !defined(DELTA)
+#error "ANYTIME_MS requires SEGMENTED or DELTA"
+#endif
+
 typedef float F_TYPE;
 
+// -DSEGMENTED runs the in-tree cache-blocked (CSR segmented) kernel.
+#ifdef SEGMENTED
+#include "pr_segmented.h"
+#endif
+
+// -DDELTA runs the in-tree residual-driven (push) kernel and reports its
+// error and edge work against a Jacobi reference. -DWARM_START removes a
+// random batch of edges, solves that graph, and then times the warm-started
+// update back to the full graph against a cold start.
+#if defined(DELTA) || defined(WARM_START)
+#include "pr_delta.h"
+
+#ifndef PR_UPDATE_EDGES
+#define PR_UPDATE_EDGES 1024
+#endif
+
+// Jacobi iteration in double precision, run well past PR_EPSILON. Returns the
+// number of iterations the same update needs to reach an L1 change below
+// PR_EPSILON, i.e. the work a full-sweep kernel does.
+uint32_t ref_pagerank(uint32_t * IA, uint32_t * IAc, uint32_t * JAc, uint32_t N, double * x){
+  double * cur = x;
+  double * nxt = (double *)malloc(N * sizeof(double));
+  double * nxt_buf = nxt;
+  uint32_t full_iters = 0;
+  for (uint32_t v = 0; v < N; v++) cur[v] = 1.0 / N;
+  for (uint32_t it = 1; it <= PR_MAX_ITERS; it++){
+    double err = 0;
+#pragma omp parallel for reduction(+:err)
+    for (uint32_t v = 0; v < N; v++){
+      double sum = 0;
+      for (uint32_t edx = IAc[v]; edx < IAc[v+1]; edx++){
+	uint32_t u = JAc[edx];
+	sum += cur[u] / (IA[u+1] - IA[u]);
+      }
+      nxt[v] = (1.0 - PR_DAMPING) / N + PR_DAMPING * sum;
+      err += fabs(nxt[v] - cur[v]);
+    }
+    double * tmp = cur;
+    cur = nxt;
+    nxt = tmp;
+    if (full_iters == 0 && err < PR_EPSILON) full_iters = it;
+    if (err < PR_EPSILON * 1e-3) break;
+  }
+  if (cur != x) memcpy(x, cur, N * sizeof(double));
+  free(nxt_buf);
+  return full_iters;
+}
+#endif
+
+// -DPPR_BATCH runs batched personalized PageRank over many seed sets, read
+// one set per line from the optional third argument or drawn at random.
+#ifdef PPR_BATCH
+#include "ppr_batch.h"
+
+#ifndef PPR_NUM_SETS
+#define PPR_NUM_SETS 256
+#endif
+
+typedef struct {
+  uint32_t * out_degrees;
+  uint32_t * IAc;
+  uint32_t * JAc;
+  uint32_t N;
+  const uint32_t * set_offsets;
+  const uint32_t * set_vertices;
+  uint64_t lane_iters;
+  double check_time;
+  uint32_t failed;
+  bool verify;
+} ppr_driver_ctx_t;
+
+// Serial power iteration for one seed set, run until the L1 change is far
+// below PR_EPSILON.
+void ref_ppr(ppr_driver_ctx_t * c, uint32_t s, double * x){
+  uint32_t N = c->N;
+  double * x_new = (double *)malloc(N * sizeof(double));
+  uint32_t num_seeds = 0;
+  for (uint32_t idx = c->set_offsets[s]; idx < c->set_offsets[s+1]; idx++)
+    if (c->set_vertices[idx] < N) num_seeds++;
+  for (uint32_t v = 0; v < N; v++) x[v] = 0;
+  for (uint32_t idx = c->set_offsets[s]; idx < c->set_offsets[s+1]; idx++)
+    if (c->set_vertices[idx] < N) x[c->set_vertices[idx]] += 1.0 / num_seeds;
+  for (uint32_t it = 0; it < PR_MAX_ITERS && num_seeds > 0; it++){
+    double err = 0;
+    for (uint32_t v = 0; v < N; v++){
+      double sum = 0;
+      for (uint32_t edx = c->IAc[v]; edx < c->IAc[v+1]; edx++){
+	uint32_t u = c->JAc[edx];
+	sum += x[u] / (c->out_degrees[u+1] - c->out_degrees[u]);
+      }
+      x_new[v] = PR_DAMPING * sum;
+    }
+    for (uint32_t idx = c->set_offsets[s]; idx < c->set_offsets[s+1]; idx++)
+      if (c->set_vertices[idx] < N)
+	x_new[c->set_vertices[idx]] += (1.0 - PR_DAMPING) / num_seeds;
+    for (uint32_t v = 0; v < N; v++){
+      err += fabs(x_new[v] - x[v]);
+      x[v] = x_new[v];
+    }
+    if (err < PR_EPSILON * 1e-3) break;
+  }
+  free(x_new);
+}
+
+void ppr_done(uint32_t set_idx, const F_TYPE * scores, uint32_t iters, void * ctx){
+  ppr_driver_ctx_t * c = (ppr_driver_ctx_t *)ctx;
+  c->lane_iters += iters;
+  if (!c->verify) return;
+  double check_st = omp_get_wtime();
+  // Both stop at an L1 change of PR_EPSILON, which bounds the distance to
+  // the fixed point by PR_EPSILON*d/(1-d).
+  double * ref = (double *)malloc(c->N * sizeof(double));
+  ref_ppr(c, set_idx, ref);
+  double diff = 0;
+  for (uint32_t v = 0; v < c->N; v++) diff += fabs(ref[v] - scores[v]);
+  if (diff > 2 * PR_EPSILON * PR_DAMPING / (1.0 - PR_DAMPING)){
+    if (c->failed < 10) printf("Set %u: L1 distance %e\n", set_idx, diff);
+    c->failed++;
+  }
+  free(ref);
+  c->check_time += omp_get_wtime() - check_st;
+}
+#endif
+
 uint32_t check_pagerank(uint32_t *out_degrees, uint32_t *IA, uint32_t *JA, uint32_t N, F_TYPE *pr);
 extern uint32_t par_pagerank(uint32_t *out_degrees, uint32_t* IA, uint32_t *JA, uint32_t N,  F_TYPE *pr);
 
 
 void usage(char * pname){
+#ifdef PPR_BATCH
+   fprintf(stderr, "USAGE: %s IA_FILE JA_FILE [SEED_SET_FILE]\n", pname);
+#else
    fprintf(stderr, "USAGE: %s IA_FILE JA_FILE\n", pname);
+#endif
    exit(EXIT_FAILURE);
 }
 
@@ -98,7 +235,84 @@ int main(int argc, char ** argv){
   csr_to_csc_parallel(IA, JA, &IAc, &JAc, N);
   printf(" %s %u nodes %u edges\n", argv[1], N, IAc[N]);
 
+#if defined(DELTA) || defined(WARM_START)
+  double * ref_pr = (double *)malloc(N * sizeof(double));
+#ifdef DELTA
+  uint32_t ref_iters = ref_pagerank(IA, IAc, JAc, N, ref_pr);
+#else
+  ref_pagerank(IA, IAc, JAc, N, ref_pr);
+#endif
+  pr_delta_stats_t delta_stats;
+#endif
+
+#ifdef WARM_START
+  // The graph before the update: all edges but a random batch, whose
+  // sources are the changed vertices.
+  uint32_t M_total = IA[N];
+  uint8_t * removed = (uint8_t *)calloc(MAX(M_total, 1), sizeof(uint8_t));
+  std::vector<uint32_t> changed;
+  srand(1);
+  for (uint32_t bdx = 0; bdx < PR_UPDATE_EDGES && M_total > 0; bdx++)
+    removed[((uint64_t)rand() * RAND_MAX + rand()) % M_total] = 1;
+  uint32_t * old_IA = (uint32_t *)malloc((N+1) * sizeof(uint32_t));
+  uint32_t * old_JA = (uint32_t *)malloc(MAX(M_total, 1) * sizeof(uint32_t));
+  old_IA[0] = 0;
+  for (uint32_t u = 0; u < N; u++){
+    old_IA[u+1] = old_IA[u];
+    for (uint32_t edx = IA[u]; edx < IA[u+1]; edx++){
+      if (removed[edx]) changed.push_back(u);
+      else old_JA[old_IA[u+1]++] = JA[edx];
+    }
+  }
+  printf("Update: %u edges appended at %lu vertices\n",
+	 M_total - old_IA[N], changed.size());
+  F_TYPE * old_pr = (F_TYPE *)malloc(N * sizeof(F_TYPE));
+  delta_pagerank(old_IA, old_JA, N, old_pr, NULL, NULL);
+  pr_delta_stats_t cold_stats;
+#endif
+
+#ifdef PPR_BATCH
+  std::vector<uint32_t> set_offsets(1, 0), set_vertices;
+  FILE * set_file = argc > 3 ? fopen(argv[3], "r") : NULL;
+  if (set_file){
+    char * line = NULL;
+    size_t line_len = 0;
+    while (getline(&line, &line_len, set_file) != -1){
+      char * pos = line, * end;
+      for (uint32_t v = strtoul(pos, &end, 10); end != pos; v = strtoul(pos, &end, 10)){
+	set_vertices.push_back(v);
+	pos = end;
+      }
+      if (set_vertices.size() > set_offsets.back())
+	set_offsets.push_back(set_vertices.size());
+    }
+    free(line);
+    fclose(set_file);
+  } else {
+    srand(1);
+    for (uint32_t s = 0; s < PPR_NUM_SETS; s++){
+      set_vertices.push_back(rand() % N);
+      set_offsets.push_back(set_vertices.size());
+    }
+  }
+  uint32_t num_sets = set_offsets.size() - 1;
+  printf("PPR over %u seed sets, %u lanes\n", num_sets, PPR_LANES);
+  ppr_driver_ctx_t ctx = {IA, IAc, JAc, N, set_offsets.data(),
+    set_vertices.data(), 0, 0.0, 0, false};
+#endif
+
+#ifdef SEGMENTED
+  // The segmented layout is built once and reused by every round.
+  double seg_st = omp_get_wtime();
+  pr_segmented_t * seg = pr_segment_graph(IAc, JAc, N, 0);
+  printf("Segmented layout: %u segments of %u vertices, %lu rows, %f sec\n",
+	 seg->num_segments, seg->seg_size, seg->seg_rows[seg->num_segments],
+	 omp_get_wtime() - seg_st);
+#endif
+
+#ifndef PPR_BATCH
   F_TYPE * pr;
+#endif
 
   double st, nd;
   char * trunc_fname = truncate_fname(argv[1]);
@@ -109,14 +323,86 @@ int main(int argc, char ** argv){
   printf("Start Pagerank\n");
   printf("round, name, iterations, time(s), threads\n");
 
+#ifdef PPR_BATCH
+  for (uint32_t iter=0; iter < ITERS; iter++){
+    ctx.lane_iters = 0;
+    ctx.check_time = 0.0;
+#ifdef VERIFY
+    ctx.verify = (iter == ITERS - 1);
+#endif
+    st = omp_get_wtime();
+    uint32_t sweeps = batch_ppr(IA, IAc, JAc, N, set_offsets.data(),
+				set_vertices.data(), num_sets, ppr_done, &ctx);
+    // Not counting the time spent checking results in the callback.
+    nd = omp_get_wtime() - ctx.check_time;
+    printf("Round %u, %s, %u sweeps, %lu set-iterations, %f sec, %f sets/sec, %u\n",
+	   iter, trunc_fname, sweeps, ctx.lane_iters, nd-st, num_sets/(nd-st), num_threads);
+    tot_time += nd - st;
+  }
+#ifdef VERIFY
+  if (ctx.failed == 0)
+    printf("Passed\n");
+  else
+    printf("Failed: %u of %u sets\n", ctx.failed, num_sets);
+#endif
+#elif defined(WARM_START)
+  for (uint32_t iter=0; iter < ITERS; iter++){
+    pr = (F_TYPE *)malloc(N * sizeof(F_TYPE));
+    memcpy(pr, old_pr, N * sizeof(F_TYPE));
+    st = omp_get_wtime();
+    uint32_t it = delta_pagerank_update(IA, JA, IAc, JAc, N, pr, changed.data(),
+					changed.size(), &delta_stats, NULL);
+    nd = omp_get_wtime();
+    printf("Round %u, %s, %u, %f sec, %u\n", iter, trunc_fname, it, nd-st, num_threads);
+
+    if (iter == ITERS - 1)
+      {
+	if (check_pagerank(IA, IAc, JAc, N, pr))
+	  printf("Passed\n");
+	else
+	  printf("Failed\n");
+	double l1_err = 0;
+	for (uint32_t v = 0; v < N; v++) l1_err += fabs(ref_pr[v] - pr[v]);
+	printf("L1 error vs reference: %e (bound %e)\n", l1_err,
+	       2 * PR_EPSILON / (1.0 - PR_DAMPING));
+	double cold_st = omp_get_wtime();
+	delta_pagerank(IA, JA, N, pr, &cold_stats, NULL);
+	double cold_time = omp_get_wtime() - cold_st;
+	printf("Warm: %lu edge ops, %f sec. Cold: %lu edge ops, %f sec (%.2f%% of the edge work)\n",
+	       delta_stats.edge_ops, nd-st, cold_stats.edge_ops, cold_time,
+	       100.0 * (double)delta_stats.edge_ops / (double)MAX(cold_stats.edge_ops, 1));
+      }
+
+    free(pr);
+    tot_time += nd - st;
+  }
+#else
   for (uint32_t iter=0; iter < ITERS; iter++){
 
     st = omp_get_wtime();
     pr = (F_TYPE *)malloc(N * sizeof(F_TYPE));
+#if defined(SEGMENTED) || defined(DELTA)
+    anytime_t * ctl = NULL;
+#endif
+#ifdef ANYTIME_MS
+    anytime_t ctl_blk;
+    anytime_init(&ctl_blk, ANYTIME_MS / 1000.0, NULL, NULL);
+    ctl = &ctl_blk;
+#endif
+#ifdef SEGMENTED
+    uint32_t it = seg_pagerank(IA, seg, pr, ctl);
+#elif defined(DELTA)
+    uint32_t it = delta_pagerank(IA, JA, N, pr, &delta_stats, ctl);
+#else
     uint32_t it = par_pagerank(IA, IAc, JAc, N, pr);
+#endif
     nd = omp_get_wtime();
 
     printf("Round %u, %s, %u, %f sec, %u\n", iter, trunc_fname, it, nd-st, num_threads);
+#ifdef ANYTIME_MS
+    printf("Anytime: %s, L1 error bound %e\n",
+	   ctl->completed ? "converged" : "stopped", ctl->err_bound);
+#endif
 
     if (iter == ITERS - 1)
       {
@@ -124,14 +410,37 @@ int main(int argc, char ** argv){
 	  printf("Passed\n");
 	else
 	  printf("Failed\n");
+#ifdef DELTA
+	double l1_err = 0;
+	for (uint32_t v = 0; v < N; v++) l1_err += fabs(ref_pr[v] - pr[v]);
+	uint64_t full_edge_ops = (uint64_t)ref_iters * IA[N];
+	printf("L1 error vs reference: %e (bound %e)\n", l1_err,
+	       PR_EPSILON / (1.0 - PR_DAMPING));
+	printf("Pushes: %lu, edge ops: %lu vs %lu for %u full iterations (%.1f%% saved)\n",
+	       delta_stats.vertex_ops, delta_stats.edge_ops, full_edge_ops, ref_iters,
+	       100.0 * (1.0 - (double)delta_stats.edge_ops / (double)MAX(full_edge_ops, 1)));
+#endif
       }
 
     free(pr);
     tot_time += nd - st;
 
   }
+#endif
   printf("Average time: %lf seconds.\n\n", tot_time/ITERS);
 
+#ifdef SEGMENTED
+  pr_free_segmented(seg);
+#endif
+#if defined(DELTA) || defined(WARM_START)
+  free(ref_pr);
+#endif
+#ifdef WARM_START
+  free(removed);
+  free(old_IA);
+  free(old_JA);
+  free(old_pr);
+#endif
   free(trunc_fname);
   free(IA);
   free(JA);
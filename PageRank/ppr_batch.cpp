@@ -0,0 +1,194 @@
+/*
+ * Graph Kernel Collection
+ *
+ * Copyright 2020 Carnegie Mellon University.
+ *
+ * NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ * INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON 
+ * UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR IMPLIED, 
+ * AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF FITNESS FOR 
+ * PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS OBTAINED FROM USE OF 
+ * THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES NOT MAKE ANY WARRANTY OF ANY
+ * KIND WITH RESPECT TO FREEDOM FROM PATENT, TRADEMARK, OR COPYRIGHT 
+ * INFRINGEMENT.
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or
+ * contact permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public
+ * release and unlimited distribution.  Please see Copyright notice for 
+ * non-US Government use and distribution.
+ *
+ * This Software includes and/or makes use of the following Third-Party
+ * Software subject to its own license:
+ *
+ * 1. Matrix Market Loader code (https://math.nist.gov/MatrixMarket/mmio-c.html).
+ *
+ *      The code made publicly available at nist.gov is not marked with a 
+ *      copyright notice and is therefore believed pursuant to section 105 of 
+ *      the Copyright Act, to not be entitled to domestic copyright protection 
+ *      under U.S. law and is therefore in the public domain.  Accordingly, it 
+ *      is believed that no license is required for its use.
+ *
+ * This Software may include certain portions of copyrighted code that is 
+ * initially being released only in binary form for validation and evaluation
+ * purposes. It is expected that source code will be released as open source at
+ * a future date. 
+ *
+ * DM20-0375
+ */
+ 
+#include "ppr_batch.h"
+#include <math.h>
+#include <string.h>
+
+#define IDLE_LANE UINT32_MAX
+
+// Load the starting vector of set s (uniform over its seeds) into lane k of
+// x, which must be all zeros. Returns the teleport
+// weight per seed, (1-d)/|S|, or 0 for a set without valid seeds.
+static F_TYPE load_lane(F_TYPE * x, uint32_t N, uint32_t k, uint32_t s,
+  const uint32_t * set_offsets, const uint32_t * set_vertices)
+{
+ uint32_t num_seeds = 0;
+ for (uint32_t idx = set_offsets[s]; idx < set_offsets[s+1]; idx++){
+  if (set_vertices[idx] < N) num_seeds++;
+ }
+ if (num_seeds == 0) return 0;
+ for (uint32_t idx = set_offsets[s]; idx < set_offsets[s+1]; idx++){
+  if (set_vertices[idx] < N){
+   x[(uint64_t)set_vertices[idx] * PPR_LANES + k] += (F_TYPE)1.0 / num_seeds;
+  }
+ }
+ return (1.0 - PR_DAMPING) / num_seeds;
+}
+
+uint32_t batch_ppr(uint32_t * out_degrees,
+  uint32_t * IAc, uint32_t * JAc, uint32_t N,
+  const uint32_t * set_offsets, const uint32_t * set_vertices,
+  uint32_t num_sets, ppr_done_cb_t cb, void * cb_ctx)
+{
+ if (N == 0 || num_sets == 0) return 0;
+ uint64_t bytes = (uint64_t)N * PPR_LANES * sizeof(F_TYPE);
+ F_TYPE * x = (F_TYPE *)aligned_alloc(64, bytes);
+ F_TYPE * x_new = (F_TYPE *)aligned_alloc(64, bytes);
+ F_TYPE * inv_deg = (F_TYPE *)malloc(N * sizeof(F_TYPE));
+ F_TYPE * out = (F_TYPE *)malloc(N * sizeof(F_TYPE));
+ if (!x || !x_new || !inv_deg || !out){
+  fprintf(stderr, "ERROR: could not allocate PPR vectors.\n");
+  exit(EXIT_FAILURE);
+ }
+#pragma omp parallel for
+ for (uint32_t u = 0; u < N; u++){
+  uint32_t deg = out_degrees[u+1] - out_degrees[u];
+  inv_deg[u] = deg ? (F_TYPE)1.0 / deg : 0;
+ }
+
+ uint32_t lane_set[PPR_LANES];
+ uint32_t lane_iters[PPR_LANES];
+ F_TYPE lane_tele[PPR_LANES];
+ uint32_t next_set = 0, num_active = 0;
+ for (uint32_t k = 0; k < PPR_LANES; k++){
+  lane_set[k] = IDLE_LANE;
+ }
+#pragma omp parallel for
+ for (uint64_t idx = 0; idx < (uint64_t)N * PPR_LANES; idx++){
+  x[idx] = 0;
+ }
+
+ uint32_t sweeps = 0;
+ while (true){
+  // Refill idle lanes. Sets without seeds finish immediately.
+  for (uint32_t k = 0; k < PPR_LANES; k++){
+   while (lane_set[k] == IDLE_LANE && next_set < num_sets){
+    uint32_t s = next_set++;
+    lane_tele[k] = load_lane(x, N, k, s, set_offsets, set_vertices);
+    if (lane_tele[k] == 0){
+     if (cb){
+      memset(out, 0, N * sizeof(F_TYPE));
+      cb(s, out, 0, cb_ctx);
+     }
+     continue;
+    }
+    lane_set[k] = s;
+    lane_iters[k] = 0;
+    num_active++;
+   }
+  }
+  if (num_active == 0) break;
+  sweeps++;
+
+  double err[PPR_LANES] = {0};
+#pragma omp parallel
+  {
+   double t_err[PPR_LANES] = {0};
+#pragma omp for schedule(dynamic, 64) nowait
+   for (uint32_t v = 0; v < N; v++){
+    F_TYPE acc[PPR_LANES] __attribute__((aligned(64))) = {0};
+    for (uint32_t edx = IAc[v]; edx < IAc[v+1]; edx++){
+     uint32_t u = JAc[edx];
+     F_TYPE w = inv_deg[u];
+     const F_TYPE * xu = x + (uint64_t)u * PPR_LANES;
+#pragma omp simd aligned(xu:64)
+     for (uint32_t k = 0; k < PPR_LANES; k++){
+      acc[k] += w * xu[k];
+     }
+    }
+    F_TYPE * xv_new = x_new + (uint64_t)v * PPR_LANES;
+    const F_TYPE * xv = x + (uint64_t)v * PPR_LANES;
+#pragma omp simd aligned(xv, xv_new:64)
+    for (uint32_t k = 0; k < PPR_LANES; k++){
+     xv_new[k] = PR_DAMPING * acc[k];
+     t_err[k] += fabs(xv_new[k] - xv[k]);
+    }
+   }
+#pragma omp critical
+   for (uint32_t k = 0; k < PPR_LANES; k++){
+    err[k] += t_err[k];
+   }
+  }
+
+  // Teleport back to the seeds, correcting the lane error for each one.
+  for (uint32_t k = 0; k < PPR_LANES; k++){
+   if (lane_set[k] == IDLE_LANE) continue;
+   uint32_t s = lane_set[k];
+   for (uint32_t idx = set_offsets[s]; idx < set_offsets[s+1]; idx++){
+    if (set_vertices[idx] >= N) continue;
+    uint64_t pos = (uint64_t)set_vertices[idx] * PPR_LANES + k;
+    err[k] -= fabs(x_new[pos] - x[pos]);
+    x_new[pos] += lane_tele[k];
+    err[k] += fabs(x_new[pos] - x[pos]);
+   }
+  }
+  F_TYPE * tmp = x;
+  x = x_new;
+  x_new = tmp;
+
+  // Retire converged lanes.
+  for (uint32_t k = 0; k < PPR_LANES; k++){
+   if (lane_set[k] == IDLE_LANE) continue;
+   lane_iters[k]++;
+   if (err[k] >= PR_EPSILON && lane_iters[k] < PR_MAX_ITERS) continue;
+   if (cb){
+#pragma omp parallel for
+    for (uint32_t v = 0; v < N; v++){
+     out[v] = x[(uint64_t)v * PPR_LANES + k];
+    }
+    cb(lane_set[k], out, lane_iters[k], cb_ctx);
+   }
+   // Idle lanes hold zeros, which stay zero.
+#pragma omp parallel for
+   for (uint32_t v = 0; v < N; v++){
+    x[(uint64_t)v * PPR_LANES + k] = 0;
+   }
+   lane_set[k] = IDLE_LANE;
+   num_active--;
+  }
+ }
+
+ free(x);
+ free(x_new);
+ free(inv_deg);
+ free(out);
+ return sweeps;
+}
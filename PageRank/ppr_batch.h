@@ -0,0 +1,84 @@
+/*
+ * Graph Kernel Collection
+ *
+ * Copyright 2020 Carnegie Mellon University.
+ *
+ * NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ * INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON 
+ * UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR IMPLIED, 
+ * AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF FITNESS FOR 
+ * PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS OBTAINED FROM USE OF 
+ * THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES NOT MAKE ANY WARRANTY OF ANY
+ * KIND WITH RESPECT TO FREEDOM FROM PATENT, TRADEMARK, OR COPYRIGHT 
+ * INFRINGEMENT.
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or
+ * contact permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public
+ * release and unlimited distribution.  Please see Copyright notice for 
+ * non-US Government use and distribution.
+ *
+ * This Software includes and/or makes use of the following Third-Party
+ * Software subject to its own license:
+ *
+ * 1. Matrix Market Loader code (https://math.nist.gov/MatrixMarket/mmio-c.html).
+ *
+ *      The code made publicly available at nist.gov is not marked with a 
+ *      copyright notice and is therefore believed pursuant to section 105 of 
+ *      the Copyright Act, to not be entitled to domestic copyright protection 
+ *      under U.S. law and is therefore in the public domain.  Accordingly, it 
+ *      is believed that no license is required for its use.
+ *
+ * This Software may include certain portions of copyrighted code that is 
+ * initially being released only in binary form for validation and evaluation
+ * purposes. It is expected that source code will be released as open source at
+ * a future date. 
+ *
+ * DM20-0375
+ */
+ 
+#ifndef PPR_BATCH_H
+#define PPR_BATCH_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <omp.h>
+#include "utils.h"
+#include "pr_common.h"
+
+// Number of seed sets propagated together. Scores are stored vertex-major
+// with PPR_LANES consecutive entries per vertex, so each edge feeds one SIMD
+// update of every lane (16 floats = two AVX2 or one AVX-512 register).
+#ifndef PPR_LANES
+#define PPR_LANES 16
+#endif
+
+// Called once per finished seed set, from the calling thread. scores holds
+// N entries and is only valid for the duration of the call.
+typedef void (*ppr_done_cb_t)(
+    uint32_t set_idx,
+    const F_TYPE * scores,
+    uint32_t iters,
+    void * ctx);
+
+/*
+ * Batched personalized PageRank.
+ *
+ * Seed set s is set_vertices[set_offsets[s] .. set_offsets[s+1]); its
+ * teleport vector is uniform over those vertices (ids >= N are ignored).
+ * Each set is iterated as x = (1-d)*p_s + d * sum over in-edges of
+ * x[u]/deg(u), with degree-0 vertices contributing nothing as in
+ * check_pagerank, until the L1 change of its own lane drops below
+ * PR_EPSILON. A converged set is handed to cb and its lane is refilled with
+ * the next pending set, so the batch stays full until the sets run out.
+ *
+ * out_degrees is the CSR offset array; IAc/JAc is the transpose. Returns the
+ * number of sweeps over the graph.
+ */
+uint32_t batch_ppr(uint32_t * out_degrees,
+  uint32_t * IAc, uint32_t * JAc, uint32_t N,
+  const uint32_t * set_offsets, const uint32_t * set_vertices,
+  uint32_t num_sets, ppr_done_cb_t cb, void * cb_ctx);
+#endif
@@ -0,0 +1,73 @@
+/*
+ * Graph Kernel Collection
+ *
+ * Copyright 2020 Carnegie Mellon University.
+ *
+ * NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ * INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON 
+ * UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR IMPLIED, 
+ * AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF FITNESS FOR 
+ * PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS OBTAINED FROM USE OF 
+ * THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES NOT MAKE ANY WARRANTY OF ANY
+ * KIND WITH RESPECT TO FREEDOM FROM PATENT, TRADEMARK, OR COPYRIGHT 
+ * INFRINGEMENT.
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or
+ * contact permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public
+ * release and unlimited distribution.  Please see Copyright notice for 
+ * non-US Government use and distribution.
+ *
+ * This Software includes and/or makes use of the following Third-Party
+ * Software subject to its own license:
+ *
+ * 1. Matrix Market Loader code (https://math.nist.gov/MatrixMarket/mmio-c.html).
+ *
+ *      The code made publicly available at nist.gov is not marked with a 
+ *      copyright notice and is therefore believed pursuant to section 105 of 
+ *      the Copyright Act, to not be entitled to domestic copyright protection 
+ *      under U.S. law and is therefore in the public domain.  Accordingly, it 
+ *      is believed that no license is required for its use.
+ *
+ * This Software may include certain portions of copyrighted code that is 
+ * initially being released only in binary form for validation and evaluation
+ * purposes. It is expected that source code will be released as open source at
+ * a future date. 
+ *
+ * DM20-0375
+ */
+ 
+#ifndef PR_COMMON_H
+#define PR_COMMON_H
+
+#include <stdint.h>
+#include <math.h>
+
+// Parameters shared by the in-tree PageRank kernels. They match
+// par_pagerank, so results can be checked with check_pagerank.
+typedef float F_TYPE;
+
+#ifndef PR_DAMPING
+#define PR_DAMPING 0.85f
+#endif
+
+// Stop once the L1 change of the score vector in an iteration is below this.
+#ifndef PR_EPSILON
+#define PR_EPSILON 1e-4
+#endif
+
+// Safety cap on the number of iterations.
+#ifndef PR_MAX_ITERS
+#define PR_MAX_ITERS 1000
+#endif
+
+// Anytime progress of a power iteration whose last L1 change was err: the
+// fraction of the way, in orders of magnitude, from 2 down to PR_EPSILON.
+inline double pr_progress(double err){
+ if (err <= PR_EPSILON) return 1.0;
+ double p = log(2.0 / err) / log(2.0 / PR_EPSILON);
+ return p < 0 ? 0 : p;
+}
+
+#endif
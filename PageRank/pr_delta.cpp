@@ -0,0 +1,279 @@
+/*
+ * Graph Kernel Collection
+ *
+ * Copyright 2020 Carnegie Mellon University.
+ *
+ * NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ * INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON 
+ * UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR IMPLIED, 
+ * AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF FITNESS FOR 
+ * PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS OBTAINED FROM USE OF 
+ * THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES NOT MAKE ANY WARRANTY OF ANY
+ * KIND WITH RESPECT TO FREEDOM FROM PATENT, TRADEMARK, OR COPYRIGHT 
+ * INFRINGEMENT.
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or
+ * contact permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public
+ * release and unlimited distribution.  Please see Copyright notice for 
+ * non-US Government use and distribution.
+ *
+ * This Software includes and/or makes use of the following Third-Party
+ * Software subject to its own license:
+ *
+ * 1. Matrix Market Loader code (https://math.nist.gov/MatrixMarket/mmio-c.html).
+ *
+ *      The code made publicly available at nist.gov is not marked with a 
+ *      copyright notice and is therefore believed pursuant to section 105 of 
+ *      the Copyright Act, to not be entitled to domestic copyright protection 
+ *      under U.S. law and is therefore in the public domain.  Accordingly, it 
+ *      is believed that no license is required for its use.
+ *
+ * This Software may include certain portions of copyrighted code that is 
+ * initially being released only in binary form for validation and evaluation
+ * purposes. It is expected that source code will be released as open source at
+ * a future date. 
+ *
+ * DM20-0375
+ */
+ 
+#include "pr_delta.h"
+#include <math.h>
+
+// Float atomics on the bit pattern.
+static inline F_TYPE atomic_add_float(F_TYPE * loc, F_TYPE val){
+ union { F_TYPE f; uint32_t u; } cur, nxt;
+ cur.f = *loc;
+ while (true){
+  nxt.f = cur.f + val;
+  uint32_t old = __sync_val_compare_and_swap((uint32_t *)loc, cur.u, nxt.u);
+  if (old == cur.u) return nxt.f;
+  cur.u = old;
+ }
+}
+
+static inline F_TYPE atomic_take_float(F_TYPE * loc){
+ union { F_TYPE f; uint32_t u; } old;
+ old.u = __atomic_exchange_n((uint32_t *)loc, 0, __ATOMIC_SEQ_CST);
+ return old.f;
+}
+
+static double residual_l1(F_TYPE * residual, uint32_t N){
+ double sum = 0;
+#pragma omp parallel for reduction(+:sum)
+ for (uint32_t v = 0; v < N; v++){
+  sum += fabs(residual[v]);
+ }
+ return sum;
+}
+
+// A vertex is pushed while its residual is above theta per unit of push
+// work (out-degree + 1).
+static inline bool above(F_TYPE r, double theta, uint32_t * IA, uint32_t v){
+ return fabs(r) > theta * (IA[v+1] - IA[v] + 1);
+}
+
+// Push until the residual L1 is at most target or no vertex is above
+// tau_min = PR_EPSILON / (M + N); either way the residual L1 is at most
+// PR_EPSILON. Each round first takes the residual of every queued vertex
+// above theta and then spreads it, so a round is a Jacobi sweep over the
+// active vertices only (as in PR-Delta). theta starts at theta_mul * tau_min
+// and is halved whenever the worklist drains, at which point the vertices
+// above it are queued again. queued[v] is set for every vertex in frontier
+// and cleared when the vertex is taken, so a vertex is on at most one list at
+// a time.
+static uint32_t push_rounds(uint32_t * IA, uint32_t * JA, uint32_t N,
+  F_TYPE * pr, F_TYPE * residual, uint8_t * queued,
+  uint32_t * frontier, uint32_t f_size, double theta_mul, double target,
+  pr_delta_stats_t * stats, anytime_t * ctl)
+{
+ const double tau_min = PR_EPSILON / ((double)IA[N] + N);
+ uint32_t * next = (uint32_t *)malloc(N * sizeof(uint32_t));
+ uint32_t * next_buf = next;
+ F_TYPE * taken = (F_TYPE *)malloc(N * sizeof(F_TYPE));
+ if (!next || !taken){
+  fprintf(stderr, "ERROR: could not allocate PageRank worklist.\n");
+  exit(EXIT_FAILURE);
+ }
+ double theta = theta_mul * tau_min;
+ double res = residual_l1(residual, N);
+ uint32_t rounds = 0;
+ uint64_t vertex_ops = 0, edge_ops = 0;
+ bool stopped = anytime_expired(ctl);
+ while (res > target && !stopped){
+  if (f_size == 0){
+   // Worklist drained: lower the threshold and requeue.
+   if (theta <= tau_min) break;
+   theta = MAX(theta * 0.5, tau_min);
+#pragma omp parallel for
+   for (uint32_t v = 0; v < N; v++){
+    if (above(residual[v], theta, IA, v)){
+     queued[v] = 1;
+     frontier[__sync_fetch_and_add(&f_size, 1)] = v;
+    }
+   }
+   continue;
+  }
+  uint32_t n_size = 0;
+  double d_res = 0;
+  rounds++;
+#pragma omp parallel for reduction(+:vertex_ops, d_res)
+  for (uint32_t fdx = 0; fdx < f_size; fdx++){
+   uint32_t v = frontier[fdx];
+   queued[v] = 0;
+   taken[fdx] = 0;
+   if (stopped || !above(residual[v], theta, IA, v)) continue;
+   F_TYPE r = atomic_take_float(&residual[v]);
+   pr[v] += r;
+   taken[fdx] = r;
+   d_res -= fabs(r);
+   vertex_ops++;
+  }
+#pragma omp parallel for schedule(dynamic, 64) reduction(+:edge_ops, d_res)
+  for (uint32_t fdx = 0; fdx < f_size; fdx++){
+   uint32_t v = frontier[fdx];
+   uint32_t deg = IA[v+1] - IA[v];
+   if ((fdx & 63) == 0 && !stopped && anytime_expired(ctl)) stopped = true;
+   if (taken[fdx] == 0 || deg == 0) continue;
+   if (stopped){
+    // Hand back what was taken but not spread, so residual still accounts
+    // for everything not yet in pr.
+    pr[v] -= taken[fdx];
+    atomic_add_float(&residual[v], taken[fdx]);
+    continue;
+   }
+   F_TYPE delta = PR_DAMPING * taken[fdx] / deg;
+   edge_ops += deg;
+   for (uint32_t edx = IA[v]; edx < IA[v+1]; edx++){
+    uint32_t w = JA[edx];
+    F_TYPE r_w = atomic_add_float(&residual[w], delta);
+    d_res += fabs(r_w) - fabs(r_w - delta);
+    if (above(r_w, theta, IA, w) && queued[w] == 0 &&
+        __sync_bool_compare_and_swap(&queued[w], 0, 1)){
+     next[__sync_fetch_and_add(&n_size, 1)] = w;
+    }
+   }
+  }
+  uint32_t * tmp = frontier;
+  frontier = next;
+  next = tmp;
+  f_size = n_size;
+  // Tracked from the updates; recomputed before it is trusted to stop.
+  res += d_res;
+  if (res <= target) res = residual_l1(residual, N);
+  if (ctl && !stopped){
+   stopped = anytime_step(ctl, pr_progress(res), res / (1.0 - PR_DAMPING));
+  }
+ }
+ if (ctl){
+  ctl->completed = !stopped;
+  ctl->err_bound = residual_l1(residual, N) / (1.0 - PR_DAMPING);
+ }
+ if (stats){
+  stats->rounds = rounds;
+  stats->vertex_ops = vertex_ops;
+  stats->edge_ops = edge_ops;
+ }
+ free(next_buf);
+ free(taken);
+ return rounds;
+}
+
+uint32_t delta_pagerank(uint32_t * IA, uint32_t * JA, uint32_t N,
+  F_TYPE * pr, pr_delta_stats_t * stats, anytime_t * ctl)
+{
+ if (N == 0) return 0;
+ F_TYPE * residual = (F_TYPE *)malloc(N * sizeof(F_TYPE));
+ uint8_t * queued = (uint8_t *)malloc(N * sizeof(uint8_t));
+ uint32_t * frontier = (uint32_t *)malloc(N * sizeof(uint32_t));
+ if (!residual || !queued || !frontier){
+  fprintf(stderr, "ERROR: could not allocate PageRank residuals.\n");
+  exit(EXIT_FAILURE);
+ }
+ // Start from the uniform vector, as the full-sweep kernels do. Its
+ // residual costs one sweep over the edges and is far smaller than that of
+ // pr = 0, whose residual is the teleport term everywhere.
+ F_TYPE x0 = 1.0 / N;
+#pragma omp parallel for
+ for (uint32_t v = 0; v < N; v++){
+  pr[v] = x0;
+  residual[v] = (1.0 - PR_DAMPING) / N - x0;
+  queued[v] = 1;
+  frontier[v] = v;
+ }
+#pragma omp parallel for schedule(dynamic, 64)
+ for (uint32_t u = 0; u < N; u++){
+  uint32_t deg = IA[u+1] - IA[u];
+  if (deg == 0) continue;
+  F_TYPE share = PR_DAMPING * x0 / deg;
+  for (uint32_t edx = IA[u]; edx < IA[u+1]; edx++){
+   atomic_add_float(&residual[JA[edx]], share);
+  }
+ }
+ uint32_t rounds = push_rounds(IA, JA, N, pr, residual, queued,
+   frontier, N, PR_DELTA_START, PR_EPSILON, stats, ctl);
+ if (stats) stats->edge_ops += IA[N];
+ free(residual);
+ free(queued);
+ free(frontier);
+ return rounds;
+}
+
+uint32_t delta_pagerank_update(uint32_t * IA, uint32_t * JA,
+  uint32_t * IAc, uint32_t * JAc, uint32_t N, F_TYPE * pr,
+  const uint32_t * changed, uint32_t num_changed, pr_delta_stats_t * stats,
+  anytime_t * ctl)
+{
+ if (N == 0) return 0;
+ F_TYPE * residual = (F_TYPE *)malloc(N * sizeof(F_TYPE));
+ uint8_t * queued = (uint8_t *)malloc(N * sizeof(uint8_t));
+ uint32_t * frontier = (uint32_t *)malloc(N * sizeof(uint32_t));
+ if (!residual || !queued || !frontier){
+  fprintf(stderr, "ERROR: could not allocate PageRank residuals.\n");
+  exit(EXIT_FAILURE);
+ }
+#pragma omp parallel for
+ for (uint32_t v = 0; v < N; v++){
+  residual[v] = 0;
+  queued[v] = 0;
+ }
+
+ // Collect the out-neighbors of the changed vertices.
+ uint32_t f_size = 0;
+ uint64_t seed_edges = 0;
+#pragma omp parallel for schedule(dynamic, 64) reduction(+:seed_edges)
+ for (uint32_t cdx = 0; cdx < num_changed; cdx++){
+  uint32_t u = changed[cdx];
+  if (u >= N) continue;
+  for (uint32_t edx = IA[u]; edx < IA[u+1]; edx++){
+   uint32_t w = JA[edx];
+   if (queued[w] == 0 && __sync_bool_compare_and_swap(&queued[w], 0, 1)){
+    frontier[__sync_fetch_and_add(&f_size, 1)] = w;
+   }
+  }
+  seed_edges += IA[u+1] - IA[u];
+ }
+
+ // Residual of the fixed-point equation under the new degrees.
+ F_TYPE base = (1.0 - PR_DAMPING) / N;
+#pragma omp parallel for schedule(dynamic, 64) reduction(+:seed_edges)
+ for (uint32_t fdx = 0; fdx < f_size; fdx++){
+  uint32_t v = frontier[fdx];
+  F_TYPE sum = 0;
+  for (uint32_t edx = IAc[v]; edx < IAc[v+1]; edx++){
+   uint32_t u = JAc[edx];
+   sum += pr[u] / (IA[u+1] - IA[u]);
+  }
+  residual[v] = base + PR_DAMPING * sum - pr[v];
+  seed_edges += IAc[v+1] - IAc[v];
+ }
+
+ uint32_t rounds = push_rounds(IA, JA, N, pr, residual, queued,
+   frontier, f_size, PR_DELTA_START, 0, stats, ctl);
+ if (stats) stats->edge_ops += seed_edges;
+ free(residual);
+ free(queued);
+ free(frontier);
+ return rounds;
+}
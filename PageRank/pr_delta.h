@@ -0,0 +1,108 @@
+/*
+ * Graph Kernel Collection
+ *
+ * Copyright 2020 Carnegie Mellon University.
+ *
+ * NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ * INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON 
+ * UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR IMPLIED, 
+ * AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF FITNESS FOR 
+ * PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS OBTAINED FROM USE OF 
+ * THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES NOT MAKE ANY WARRANTY OF ANY
+ * KIND WITH RESPECT TO FREEDOM FROM PATENT, TRADEMARK, OR COPYRIGHT 
+ * INFRINGEMENT.
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or
+ * contact permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public
+ * release and unlimited distribution.  Please see Copyright notice for 
+ * non-US Government use and distribution.
+ *
+ * This Software includes and/or makes use of the following Third-Party
+ * Software subject to its own license:
+ *
+ * 1. Matrix Market Loader code (https://math.nist.gov/MatrixMarket/mmio-c.html).
+ *
+ *      The code made publicly available at nist.gov is not marked with a 
+ *      copyright notice and is therefore believed pursuant to section 105 of 
+ *      the Copyright Act, to not be entitled to domestic copyright protection 
+ *      under U.S. law and is therefore in the public domain.  Accordingly, it 
+ *      is believed that no license is required for its use.
+ *
+ * This Software may include certain portions of copyrighted code that is 
+ * initially being released only in binary form for validation and evaluation
+ * purposes. It is expected that source code will be released as open source at
+ * a future date. 
+ *
+ * DM20-0375
+ */
+ 
+#ifndef PR_DELTA_H
+#define PR_DELTA_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <omp.h>
+#include "utils.h"
+#include "anytime.h"
+#include "pr_common.h"
+
+// A vertex is only pushed while its residual is above a threshold per unit
+// of push work (out-degree + 1). Neither kernel stops while a vertex is above
+// PR_EPSILON / (M + N), so the final L1 error is at most PR_EPSILON / (1 - d).
+// The threshold starts PR_DELTA_START times higher and is halved whenever no
+// vertex is left above it; the cold start also stops as soon as the residual
+// L1 is at most PR_EPSILON.
+#ifndef PR_DELTA_START
+#define PR_DELTA_START 32
+#endif
+
+typedef struct {
+ uint32_t rounds;      // worklist rounds
+ uint64_t vertex_ops;  // residual pushes
+ uint64_t edge_ops;    // edges traversed by those pushes
+} pr_delta_stats_t;
+
+/*
+ * Residual-driven (push) PageRank.
+ *
+ * Starts from the uniform vector, whose residual takes one sweep over the
+ * edges, and keeps a signed residual per vertex. Only vertices whose
+ * residual is above the threshold are processed: the residual is moved into
+ * pr and d*r/deg is added to each out-neighbor's residual (float atomic add),
+ * which queues neighbors that cross the threshold. Each round takes the
+ * residuals of all its vertices before spreading any of them, as in
+ * PR-Delta, so it is a Jacobi sweep restricted to the active vertices.
+ *
+ * Uses the CSR (out-edges) only and converges to the same fixed point as
+ * check_pagerank. stats may be NULL; its edge_ops include the initial sweep.
+ * Returns the number of rounds.
+ *
+ * ctl may be NULL. The kernel can stop after any push, so pr is always
+ * usable; err_bound is the L1 bound sum(|residual|)/(1-d) on its distance to
+ * the fixed point.
+ */
+uint32_t delta_pagerank(uint32_t * IA, uint32_t * JA, uint32_t N,
+  F_TYPE * pr, pr_delta_stats_t * stats, anytime_t * ctl);
+
+/*
+ * Warm start after edges were appended to the graph.
+ *
+ * pr holds the scores for the graph before the update (e.g. from
+ * delta_pagerank) and is updated in place. IA/JA and its transpose IAc/JAc
+ * are the graph after the update, with the same N. changed lists the
+ * vertices that gained out-edges (duplicates are fine). Their larger
+ * out-degree changes the share they pass to every out-neighbor, old and
+ * new, so the residuals of all those out-neighbors are recomputed by
+ * pulling over the CSC, and the push kernel then runs from them alone; the
+ * edge work scales with the size of the update rather than the graph. stats
+ * and ctl may be NULL; err_bound covers the update's residuals only. Returns
+ * the number of rounds.
+ */
+uint32_t delta_pagerank_update(uint32_t * IA, uint32_t * JA,
+  uint32_t * IAc, uint32_t * JAc, uint32_t N, F_TYPE * pr,
+  const uint32_t * changed, uint32_t num_changed, pr_delta_stats_t * stats,
+  anytime_t * ctl);
+#endif
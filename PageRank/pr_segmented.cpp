@@ -0,0 +1,205 @@
+/*
+ * Graph Kernel Collection
+ *
+ * Copyright 2020 Carnegie Mellon University.
+ *
+ * NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ * INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON 
+ * UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR IMPLIED, 
+ * AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF FITNESS FOR 
+ * PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS OBTAINED FROM USE OF 
+ * THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES NOT MAKE ANY WARRANTY OF ANY
+ * KIND WITH RESPECT TO FREEDOM FROM PATENT, TRADEMARK, OR COPYRIGHT 
+ * INFRINGEMENT.
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or
+ * contact permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public
+ * release and unlimited distribution.  Please see Copyright notice for 
+ * non-US Government use and distribution.
+ *
+ * This Software includes and/or makes use of the following Third-Party
+ * Software subject to its own license:
+ *
+ * 1. Matrix Market Loader code (https://math.nist.gov/MatrixMarket/mmio-c.html).
+ *
+ *      The code made publicly available at nist.gov is not marked with a 
+ *      copyright notice and is therefore believed pursuant to section 105 of 
+ *      the Copyright Act, to not be entitled to domestic copyright protection 
+ *      under U.S. law and is therefore in the public domain.  Accordingly, it 
+ *      is believed that no license is required for its use.
+ *
+ * This Software may include certain portions of copyrighted code that is 
+ * initially being released only in binary form for validation and evaluation
+ * purposes. It is expected that source code will be released as open source at
+ * a future date. 
+ *
+ * DM20-0375
+ */
+ 
+#include "pr_segmented.h"
+#include <math.h>
+#include <vector>
+
+pr_segmented_t * pr_segment_graph(uint32_t * IAc, uint32_t * JAc,
+  uint32_t N, uint32_t seg_size)
+{
+ if (seg_size == 0) seg_size = PR_SEGMENT_BYTES / sizeof(F_TYPE);
+ pr_segmented_t * seg = (pr_segmented_t *)malloc(sizeof(pr_segmented_t));
+ uint32_t S = (uint32_t)(((uint64_t)N + seg_size - 1) / seg_size);
+ uint32_t nt = omp_get_max_threads();
+ seg->N = N;
+ seg->seg_size = seg_size;
+ seg->num_segments = S;
+ seg->seg_rows = (uint64_t *)malloc((S+1) * sizeof(uint64_t));
+ seg->src = (uint32_t *)malloc(MAX((uint64_t)IAc[N], 1) * sizeof(uint32_t));
+
+ // Rows and edges per (thread, segment) over a static split of the
+ // destinations, laid out segment-major so each segment's rows stay in
+ // destination order.
+ uint64_t * row_off = (uint64_t *)calloc((uint64_t)S * nt + 1, sizeof(uint64_t));
+ uint64_t * edge_off = (uint64_t *)calloc((uint64_t)S * nt + 1, sizeof(uint64_t));
+ if (!seg->seg_rows || !seg->src || !row_off || !edge_off){
+  fprintf(stderr, "ERROR: could not allocate segmented graph.\n");
+  exit(EXIT_FAILURE);
+ }
+
+#pragma omp parallel num_threads(nt)
+ {
+  uint32_t tid = omp_get_thread_num();
+  uint32_t chunk = (N + nt - 1) / nt;
+  uint32_t v_st = MIN((uint64_t)N, (uint64_t)tid * chunk);
+  uint32_t v_nd = MIN((uint64_t)N, (uint64_t)v_st + chunk);
+
+  // Count. Neighborhoods are sorted, so each segment is one run.
+  for (uint32_t v = v_st; v < v_nd; v++){
+   uint32_t edx = IAc[v];
+   while (edx < IAc[v+1]){
+    uint32_t s = JAc[edx] / seg_size;
+    uint32_t run_nd = edx;
+    while (run_nd < IAc[v+1] && JAc[run_nd] / seg_size == s) run_nd++;
+    row_off[(uint64_t)s * nt + tid + 1]++;
+    edge_off[(uint64_t)s * nt + tid + 1] += run_nd - edx;
+    edx = run_nd;
+   }
+  }
+#pragma omp barrier
+#pragma omp single
+  {
+   for (uint64_t bdx = 0; bdx < (uint64_t)S * nt; bdx++){
+    row_off[bdx+1] += row_off[bdx];
+    edge_off[bdx+1] += edge_off[bdx];
+   }
+   uint64_t num_rows = row_off[(uint64_t)S * nt];
+   for (uint32_t s = 0; s <= S; s++){
+    seg->seg_rows[s] = row_off[(uint64_t)s * nt];
+   }
+   seg->row_dst = (uint32_t *)malloc(MAX(num_rows, 1) * sizeof(uint32_t));
+   seg->row_edges = (uint64_t *)malloc((num_rows+1) * sizeof(uint64_t));
+   if (!seg->row_dst || !seg->row_edges){
+    fprintf(stderr, "ERROR: could not allocate segmented graph rows.\n");
+    exit(EXIT_FAILURE);
+   }
+   seg->row_edges[num_rows] = IAc[N];
+  }
+
+  // Fill.
+  std::vector<uint64_t> row_cur(S), edge_cur(S);
+  for (uint32_t s = 0; s < S; s++){
+   row_cur[s] = row_off[(uint64_t)s * nt + tid];
+   edge_cur[s] = edge_off[(uint64_t)s * nt + tid];
+  }
+  for (uint32_t v = v_st; v < v_nd; v++){
+   uint32_t edx = IAc[v];
+   while (edx < IAc[v+1]){
+    uint32_t s = JAc[edx] / seg_size;
+    uint64_t r = row_cur[s]++;
+    seg->row_dst[r] = v;
+    seg->row_edges[r] = edge_cur[s];
+    while (edx < IAc[v+1] && JAc[edx] / seg_size == s){
+     seg->src[edge_cur[s]++] = JAc[edx++];
+    }
+   }
+  }
+ }
+
+ free(row_off);
+ free(edge_off);
+ return seg;
+}
+
+void pr_free_segmented(pr_segmented_t * seg){
+ free(seg->seg_rows);
+ free(seg->row_dst);
+ free(seg->row_edges);
+ free(seg->src);
+ free(seg);
+}
+
+uint32_t seg_pagerank(uint32_t * out_degrees, pr_segmented_t * seg,
+  F_TYPE * pr, anytime_t * ctl)
+{
+ uint32_t N = seg->N;
+ F_TYPE base = (1.0 - PR_DAMPING) / N;
+ F_TYPE * contrib = (F_TYPE *)malloc(N * sizeof(F_TYPE));
+ F_TYPE * sums = (F_TYPE *)malloc(N * sizeof(F_TYPE));
+ if (!contrib || !sums){
+  fprintf(stderr, "ERROR: could not allocate PageRank vectors.\n");
+  exit(EXIT_FAILURE);
+ }
+#pragma omp parallel for
+ for (uint32_t v = 0; v < N; v++){
+  pr[v] = 1.0 / N;
+ }
+
+ uint32_t iter = 0;
+ bool stopped = anytime_expired(ctl);
+ double err = 2.0;
+ while (iter < PR_MAX_ITERS && !stopped){
+#pragma omp parallel for
+  for (uint32_t u = 0; u < N; u++){
+   uint32_t deg = out_degrees[u+1] - out_degrees[u];
+   contrib[u] = deg ? pr[u] / deg : 0;
+   sums[u] = 0;
+  }
+  // One segment at a time: every gather hits the segment's slice of
+  // contrib, and each destination appears at most once per segment.
+  for (uint32_t s = 0; s < seg->num_segments; s++){
+   uint64_t r_st = seg->seg_rows[s];
+   uint64_t r_nd = seg->seg_rows[s+1];
+#pragma omp parallel for schedule(dynamic, 64)
+   for (uint64_t r = r_st; r < r_nd; r++){
+    if (stopped || ((r & 255) == 0 && anytime_expired(ctl))){
+     stopped = true;
+     continue;
+    }
+    F_TYPE acc = 0;
+    for (uint64_t edx = seg->row_edges[r]; edx < seg->row_edges[r+1]; edx++){
+     acc += contrib[seg->src[edx]];
+    }
+    sums[seg->row_dst[r]] += acc;
+   }
+  }
+  if (stopped) break;
+  iter++;
+  err = 0;
+#pragma omp parallel for reduction(+:err)
+  for (uint32_t v = 0; v < N; v++){
+   F_TYPE new_pr = base + PR_DAMPING * sums[v];
+   err += fabs(new_pr - pr[v]);
+   pr[v] = new_pr;
+  }
+  if (err < PR_EPSILON) break;
+  stopped = anytime_step(ctl, pr_progress(err),
+    err * PR_DAMPING / (1.0 - PR_DAMPING));
+ }
+ if (ctl){
+  ctl->completed = (err < PR_EPSILON);
+  ctl->err_bound = err * PR_DAMPING / (1.0 - PR_DAMPING);
+ }
+
+ free(contrib);
+ free(sums);
+ return iter;
+}
@@ -0,0 +1,95 @@
+/*
+ * Graph Kernel Collection
+ *
+ * Copyright 2020 Carnegie Mellon University.
+ *
+ * NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ * INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON 
+ * UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR IMPLIED, 
+ * AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF FITNESS FOR 
+ * PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS OBTAINED FROM USE OF 
+ * THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES NOT MAKE ANY WARRANTY OF ANY
+ * KIND WITH RESPECT TO FREEDOM FROM PATENT, TRADEMARK, OR COPYRIGHT 
+ * INFRINGEMENT.
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or
+ * contact permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public
+ * release and unlimited distribution.  Please see Copyright notice for 
+ * non-US Government use and distribution.
+ *
+ * This Software includes and/or makes use of the following Third-Party
+ * Software subject to its own license:
+ *
+ * 1. Matrix Market Loader code (https://math.nist.gov/MatrixMarket/mmio-c.html).
+ *
+ *      The code made publicly available at nist.gov is not marked with a 
+ *      copyright notice and is therefore believed pursuant to section 105 of 
+ *      the Copyright Act, to not be entitled to domestic copyright protection 
+ *      under U.S. law and is therefore in the public domain.  Accordingly, it 
+ *      is believed that no license is required for its use.
+ *
+ * This Software may include certain portions of copyrighted code that is 
+ * initially being released only in binary form for validation and evaluation
+ * purposes. It is expected that source code will be released as open source at
+ * a future date. 
+ *
+ * DM20-0375
+ */
+ 
+#ifndef PR_SEGMENTED_H
+#define PR_SEGMENTED_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <omp.h>
+#include "utils.h"
+#include "anytime.h"
+#include "pr_common.h"
+
+// Bytes of source contributions per segment. Each segment's slice of the
+// contribution vector should stay resident in the LLC (22 MB on the 8153).
+#ifndef PR_SEGMENT_BYTES
+#define PR_SEGMENT_BYTES (8*1024*1024)
+#endif
+
+/*
+ * CSR-segmented transpose for cache-blocked pull PageRank.
+ *
+ * Source vertices are split into ranges of seg_size. For every segment, the
+ * in-edges of each destination that come from that range form one row, so
+ * pulling a segment only gathers from a cache-resident slice of the
+ * contribution vector. Rows of a segment are in destination order.
+ */
+typedef struct {
+ uint32_t N;
+ uint32_t seg_size;      // sources per segment
+ uint32_t num_segments;
+ uint64_t * seg_rows;    // num_segments+1 offsets into row_dst/row_edges
+ uint32_t * row_dst;     // destination of each row
+ uint64_t * row_edges;   // num_rows+1 offsets into src
+ uint32_t * src;         // sources, M entries
+} pr_segmented_t;
+
+// Build the segmented layout once from the CSC (e.g. csr_to_csc_parallel
+// output, with sorted neighborhoods). seg_size of 0 picks it from
+// PR_SEGMENT_BYTES.
+pr_segmented_t * pr_segment_graph(uint32_t * IAc, uint32_t * JAc,
+  uint32_t N, uint32_t seg_size);
+
+void pr_free_segmented(pr_segmented_t * seg);
+
+/*
+ * Pull PageRank over the segmented layout. out_degrees is the CSR offset
+ * array (as passed to par_pagerank). Returns the number of iterations.
+ *
+ * With an anytime control block (or NULL), an iteration cut short by the
+ * deadline is discarded and pr holds the last complete iterate; err_bound is
+ * then an L1 bound on its distance to the fixed point, d/(1-d) times the
+ * last iteration's L1 change.
+ */
+uint32_t seg_pagerank(uint32_t * out_degrees, pr_segmented_t * seg,
+  F_TYPE * pr, anytime_t * ctl);
+#endif
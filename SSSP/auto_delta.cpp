@@ -0,0 +1,93 @@
+/*
+ * Graph Kernel Collection
+ *
+ * Copyright 2020 Carnegie Mellon University.
+ *
+ * NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ * INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON 
+ * UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR IMPLIED, 
+ * AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF FITNESS FOR 
+ * PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS OBTAINED FROM USE OF 
+ * THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES NOT MAKE ANY WARRANTY OF ANY
+ * KIND WITH RESPECT TO FREEDOM FROM PATENT, TRADEMARK, OR COPYRIGHT 
+ * INFRINGEMENT.
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or
+ * contact permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public
+ * release and unlimited distribution.  Please see Copyright notice for 
+ * non-US Government use and distribution.
+ *
+ * This Software includes and/or makes use of the following Third-Party
+ * Software subject to its own license:
+ *
+ * 1. Matrix Market Loader code (https://math.nist.gov/MatrixMarket/mmio-c.html).
+ *
+ *      The code made publicly available at nist.gov is not marked with a 
+ *      copyright notice and is therefore believed pursuant to section 105 of 
+ *      the Copyright Act, to not be entitled to domestic copyright protection 
+ *      under U.S. law and is therefore in the public domain.  Accordingly, it 
+ *      is believed that no license is required for its use.
+ *
+ * This Software may include certain portions of copyrighted code that is 
+ * initially being released only in binary form for validation and evaluation
+ * purposes. It is expected that source code will be released as open source at
+ * a future date. 
+ *
+ * DM20-0375
+ */
+ 
+#include "auto_delta.h"
+#include <math.h>
+#include <random>
+#include <vector>
+
+template <typename W>
+W sssp_auto_delta(uint32_t * IA, uint32_t * JA, W * A, uint32_t N)
+{
+ uint32_t M = IA[N];
+ if (N == 0 || M == 0) return 1;
+ std::mt19937 gen(27491095);
+
+ // Weight percentile.
+ std::vector<W> weights;
+ uint32_t num_w = MIN(M, AUTO_DELTA_SAMPLES);
+ std::uniform_int_distribution<uint32_t> edge_dist(0, M-1);
+ weights.reserve(num_w);
+ for (uint32_t sdx = 0; sdx < num_w; sdx++){
+  weights.push_back(A[num_w == M ? sdx : edge_dist(gen)]);
+ }
+ uint32_t w_idx = (uint32_t)(0.999 * (num_w - 1));
+ std::nth_element(weights.begin(), weights.begin() + w_idx, weights.end());
+ double w_hi = (double)weights[w_idx];
+ if (!(w_hi > 0)) w_hi = 1;
+
+ // Median degree of vertices with edges.
+ std::vector<uint32_t> degrees;
+ std::uniform_int_distribution<uint32_t> vert_dist(0, N-1);
+ for (uint32_t sdx = 0; sdx < 4 * AUTO_DELTA_SAMPLES &&
+      degrees.size() < AUTO_DELTA_SAMPLES; sdx++){
+  uint32_t v = N <= AUTO_DELTA_SAMPLES ? sdx : vert_dist(gen);
+  if (v >= N) break;
+  if (IA[v+1] > IA[v]) degrees.push_back(IA[v+1] - IA[v]);
+ }
+ uint32_t med_deg = 1;
+ if (!degrees.empty()){
+  std::nth_element(degrees.begin(), degrees.begin() + degrees.size() / 2,
+    degrees.end());
+  med_deg = MAX(degrees[degrees.size() / 2], 1);
+ }
+
+ // Nearest power of two (in log scale): the smallest one that is at least
+ // raw/sqrt(2).
+ double raw = w_hi / med_deg;
+ int exp2 = (int)ceil(log2(raw) - 0.5);
+ if (std::is_integral<W>::value) exp2 = MIN(MAX(exp2, 0), 31);
+ return (W)ldexp(1.0, exp2);
+}
+
+template uint32_t sssp_auto_delta(uint32_t *, uint32_t *, uint32_t *, uint32_t);
+template uint64_t sssp_auto_delta(uint32_t *, uint32_t *, uint64_t *, uint32_t);
+template float sssp_auto_delta(uint32_t *, uint32_t *, float *, uint32_t);
+template double sssp_auto_delta(uint32_t *, uint32_t *, double *, uint32_t);
@@ -0,0 +1,72 @@
+/*
+ * Graph Kernel Collection
+ *
+ * Copyright 2020 Carnegie Mellon University.
+ *
+ * NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ * INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON 
+ * UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR IMPLIED, 
+ * AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF FITNESS FOR 
+ * PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS OBTAINED FROM USE OF 
+ * THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES NOT MAKE ANY WARRANTY OF ANY
+ * KIND WITH RESPECT TO FREEDOM FROM PATENT, TRADEMARK, OR COPYRIGHT 
+ * INFRINGEMENT.
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or
+ * contact permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public
+ * release and unlimited distribution.  Please see Copyright notice for 
+ * non-US Government use and distribution.
+ *
+ * This Software includes and/or makes use of the following Third-Party
+ * Software subject to its own license:
+ *
+ * 1. Matrix Market Loader code (https://math.nist.gov/MatrixMarket/mmio-c.html).
+ *
+ *      The code made publicly available at nist.gov is not marked with a 
+ *      copyright notice and is therefore believed pursuant to section 105 of 
+ *      the Copyright Act, to not be entitled to domestic copyright protection 
+ *      under U.S. law and is therefore in the public domain.  Accordingly, it 
+ *      is believed that no license is required for its use.
+ *
+ * This Software may include certain portions of copyrighted code that is 
+ * initially being released only in binary form for validation and evaluation
+ * purposes. It is expected that source code will be released as open source at
+ * a future date. 
+ *
+ * DM20-0375
+ */
+ 
+#ifndef AUTO_DELTA_H
+#define AUTO_DELTA_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <omp.h>
+#include "utils.h"
+#include "sssp_types.h"
+
+// Number of edges and vertices sampled for the weight and degree statistics.
+#ifndef AUTO_DELTA_SAMPLES
+#define AUTO_DELTA_SAMPLES (64*1024)
+#endif
+
+/*
+ * Pick a delta for delta-stepping from the graph: a high percentile (99.9%)
+ * of the edge weights divided by the median out-degree of the vertices that
+ * have edges, rounded to the nearest power of two. With uniform weights this
+ * is the classic max_weight/degree choice; using the median degree makes
+ * skewed graphs, whose typical vertex has few edges, use wider buckets, and
+ * the weight percentile keeps long outlier edges (road graphs) from
+ * dominating.
+ *
+ * Usable with the library sssp as well as the in-tree engines. For integer
+ * weights the result is at least 1; floating point weights may give a
+ * fractional power of two. Instantiated for the weight types in
+ * sssp_types.h.
+ */
+template <typename W>
+W sssp_auto_delta(uint32_t * IA, uint32_t * JA, W * A, uint32_t N);
+#endif
@@ -0,0 +1,193 @@
+/*
+ * Graph Kernel Collection
+ *
+ * Copyright 2020 Carnegie Mellon University.
+ *
+ * NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ * INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON 
+ * UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR IMPLIED, 
+ * AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF FITNESS FOR 
+ * PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS OBTAINED FROM USE OF 
+ * THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES NOT MAKE ANY WARRANTY OF ANY
+ * KIND WITH RESPECT TO FREEDOM FROM PATENT, TRADEMARK, OR COPYRIGHT 
+ * INFRINGEMENT.
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or
+ * contact permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public
+ * release and unlimited distribution.  Please see Copyright notice for 
+ * non-US Government use and distribution.
+ *
+ * This Software includes and/or makes use of the following Third-Party
+ * Software subject to its own license:
+ *
+ * 1. Matrix Market Loader code (https://math.nist.gov/MatrixMarket/mmio-c.html).
+ *
+ *      The code made publicly available at nist.gov is not marked with a 
+ *      copyright notice and is therefore believed pursuant to section 105 of 
+ *      the Copyright Act, to not be entitled to domestic copyright protection 
+ *      under U.S. law and is therefore in the public domain.  Accordingly, it 
+ *      is believed that no license is required for its use.
+ *
+ * This Software may include certain portions of copyrighted code that is 
+ * initially being released only in binary form for validation and evaluation
+ * purposes. It is expected that source code will be released as open source at
+ * a future date. 
+ *
+ * DM20-0375
+ */
+ 
+#include "bucket_fusion.h"
+#include "auto_delta.h"
+#include <string.h>
+#include <vector>
+
+#define NO_BUCKET UINT64_MAX
+
+typedef std::vector<std::vector<uint32_t> > bucket_array_t;
+
+static inline void min_CAS(uint64_t * loc, uint64_t swp){
+ uint64_t cmp = *loc;
+ while (swp < cmp){
+  uint64_t tmp = __sync_val_compare_and_swap(loc, cmp, swp);
+  if (tmp == cmp) break;
+  cmp = tmp;
+ }
+}
+
+// Relax the out-edges of u, filing every improved vertex in this thread's
+// bucket of its new distance.
+template <typename D, typename W>
+static inline void relax_out(uint32_t u, uint32_t * IA, uint32_t * JA,
+  W * A, D * lens, D delta, bucket_array_t & buckets)
+{
+ D du = lens[u];
+ for (uint32_t edx = IA[u]; edx < IA[u+1]; edx++){
+  uint32_t v = JA[edx];
+  D nd = sssp_add(du, A[edx]);
+  if (nd < lens[v] && sssp_lower(&lens[v], nd)){
+   uint64_t b = sssp_bucket_t<D>::of(nd, delta);
+   if (b >= buckets.size()) buckets.resize(b + 1);
+   buckets[b].push_back(v);
+  }
+ }
+}
+
+template <typename D, typename W>
+uint32_t fused_sssp(uint32_t * IA, uint32_t * JA, W * A,
+  uint32_t N, D * lens, uint32_t src, D delta)
+{
+ if (N == 0 || src >= N) return 0;
+ D width = (delta == 0) ? (D)sssp_auto_delta(IA, JA, A, N) : delta;
+ // A vertex can sit in several threads' buckets, so the frontier is sized
+ // by edges and grown in the rare case that is not enough.
+ uint64_t capacity = MAX(IA[N], 1);
+ uint32_t * frontier = (uint32_t *)malloc(capacity * sizeof(uint32_t));
+ if (!frontier){
+  fprintf(stderr, "ERROR: could not allocate SSSP frontier.\n");
+  exit(EXIT_FAILURE);
+ }
+#pragma omp parallel for
+ for (uint32_t v = 0; v < N; v++){
+  lens[v] = sssp_inf<D>();
+ }
+ lens[src] = 0;
+ frontier[0] = src;
+
+ // Round r reads index r&1 and builds index (r+1)&1; each is reset by a
+ // single thread once everyone is past the barrier that made it stale.
+ uint64_t bucket_index[2] = {0, NO_BUCKET};
+ uint64_t tails[2] = {1, 0};
+ bool overflow[2] = {false, false};
+ uint32_t rounds = 0;
+
+#pragma omp parallel
+ {
+  bucket_array_t buckets;
+  uint32_t round = 0;
+  while (bucket_index[round & 1] != NO_BUCKET){
+   uint64_t curr = bucket_index[round & 1];
+   uint64_t curr_tail = tails[round & 1];
+   uint64_t & next = bucket_index[(round + 1) & 1];
+   uint64_t & next_tail = tails[(round + 1) & 1];
+
+#pragma omp for nowait schedule(dynamic, 64)
+   for (uint64_t fdx = 0; fdx < curr_tail; fdx++){
+    uint32_t u = frontier[fdx];
+    // Skip entries settled in an earlier bucket.
+    if (sssp_bucket_t<D>::of(lens[u], width) >= curr){
+     relax_out(u, IA, JA, A, lens, width, buckets);
+    }
+   }
+
+   // Bucket fusion.
+   while (curr < buckets.size() && !buckets[curr].empty() &&
+          buckets[curr].size() < SSSP_FUSION_THRESHOLD){
+    std::vector<uint32_t> local;
+    local.swap(buckets[curr]);
+    for (size_t ldx = 0; ldx < local.size(); ldx++){
+     relax_out(local[ldx], IA, JA, A, lens, width, buckets);
+    }
+   }
+
+   // Nothing is ever filed below the current bucket.
+   for (uint64_t b = curr; b < buckets.size(); b++){
+    if (!buckets[b].empty()){
+     min_CAS(&next, b);
+     break;
+    }
+   }
+#pragma omp barrier
+#pragma omp single nowait
+   {
+    bucket_index[round & 1] = NO_BUCKET;
+    tails[round & 1] = 0;
+    overflow[(round + 1) & 1] = false;
+    rounds++;
+   }
+
+   // Append this thread's share of the next bucket to the frontier.
+   uint64_t copy_start = 0, copy_size = 0;
+   if (next < buckets.size() && !buckets[next].empty()){
+    copy_size = buckets[next].size();
+    copy_start = __sync_fetch_and_add(&next_tail, copy_size);
+    if (copy_start + copy_size <= capacity){
+     memcpy(frontier + copy_start, buckets[next].data(),
+       copy_size * sizeof(uint32_t));
+     buckets[next].clear();
+     copy_size = 0;
+    } else {
+     overflow[round & 1] = true;
+    }
+   }
+#pragma omp barrier
+   if (overflow[round & 1]){
+#pragma omp single
+    {
+     capacity = MAX(2 * capacity, next_tail);
+     frontier = (uint32_t *)realloc(frontier, capacity * sizeof(uint32_t));
+     if (!frontier){
+      fprintf(stderr, "ERROR: could not grow SSSP frontier.\n");
+      exit(EXIT_FAILURE);
+     }
+    }
+    if (copy_size > 0){
+     memcpy(frontier + copy_start, buckets[next].data(),
+       copy_size * sizeof(uint32_t));
+     buckets[next].clear();
+    }
+#pragma omp barrier
+   }
+   round++;
+  }
+ }
+
+ free(frontier);
+ return rounds;
+}
+
+#define FUSED_SSSP_INST(D, W) \
+ template uint32_t fused_sssp(uint32_t *, uint32_t *, W *, uint32_t, D *, \
+   uint32_t, D);
+SSSP_INSTANTIATE(FUSED_SSSP_INST)
@@ -0,0 +1,80 @@
+/*
+ * Graph Kernel Collection
+ *
+ * Copyright 2020 Carnegie Mellon University.
+ *
+ * NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ * INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON 
+ * UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR IMPLIED, 
+ * AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF FITNESS FOR 
+ * PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS OBTAINED FROM USE OF 
+ * THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES NOT MAKE ANY WARRANTY OF ANY
+ * KIND WITH RESPECT TO FREEDOM FROM PATENT, TRADEMARK, OR COPYRIGHT 
+ * INFRINGEMENT.
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or
+ * contact permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public
+ * release and unlimited distribution.  Please see Copyright notice for 
+ * non-US Government use and distribution.
+ *
+ * This Software includes and/or makes use of the following Third-Party
+ * Software subject to its own license:
+ *
+ * 1. Matrix Market Loader code (https://math.nist.gov/MatrixMarket/mmio-c.html).
+ *
+ *      The code made publicly available at nist.gov is not marked with a 
+ *      copyright notice and is therefore believed pursuant to section 105 of 
+ *      the Copyright Act, to not be entitled to domestic copyright protection 
+ *      under U.S. law and is therefore in the public domain.  Accordingly, it 
+ *      is believed that no license is required for its use.
+ *
+ * This Software may include certain portions of copyrighted code that is 
+ * initially being released only in binary form for validation and evaluation
+ * purposes. It is expected that source code will be released as open source at
+ * a future date. 
+ *
+ * DM20-0375
+ */
+ 
+#ifndef BUCKET_FUSION_H
+#define BUCKET_FUSION_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <omp.h>
+#include "utils.h"
+#include "sssp_types.h"
+
+// A thread keeps draining its own copy of the current bucket, without a
+// global round, while it holds fewer than this many entries.
+#ifndef SSSP_FUSION_THRESHOLD
+#define SSSP_FUSION_THRESHOLD 1000
+#endif
+
+/*
+ * Delta-stepping SSSP with thread-local buckets and bucket fusion.
+ *
+ * Same interface as the library sssp: CSR (IA, JA) with weights A,
+ * distances written to lens, sssp_inf<D>() (UINT32_MAX for the library's
+ * types) for unreachable vertices. Distance type D and weight type W are
+ * any pair from sssp_types.h; with uint32_t for both this is a drop-in
+ * replacement for sssp. Each thread files the vertices it improves into
+ * its own bucket array, so no shared queue is contended while relaxing.
+ * After a round every thread proposes its lowest non-empty bucket with a
+ * compare-and-swap minimum, and the owners of the winning bucket append it
+ * to the shared frontier. A thread whose copy of the current bucket is
+ * refilled with fewer than SSSP_FUSION_THRESHOLD vertices processes it
+ * immediately instead of waiting for the next round, which removes most
+ * global barriers on high-diameter graphs.
+ *
+ * delta == 0 uses the width from sssp_auto_delta. Buckets are indexed by
+ * distance / delta, so a very small delta on a graph with long paths costs
+ * memory in every thread. Returns the number of global rounds.
+ */
+template <typename D, typename W>
+uint32_t fused_sssp(uint32_t * IA, uint32_t * JA, W * A,
+  uint32_t N, D * lens, uint32_t src, D delta);
+#endif
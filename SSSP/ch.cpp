@@ -0,0 +1,682 @@
+/*
+ * Graph Kernel Collection
+ *
+ * Copyright 2020 Carnegie Mellon University.
+ *
+ * NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ * INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON 
+ * UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR IMPLIED, 
+ * AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF FITNESS FOR 
+ * PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS OBTAINED FROM USE OF 
+ * THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES NOT MAKE ANY WARRANTY OF ANY
+ * KIND WITH RESPECT TO FREEDOM FROM PATENT, TRADEMARK, OR COPYRIGHT 
+ * INFRINGEMENT.
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or
+ * contact permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public
+ * release and unlimited distribution.  Please see Copyright notice for 
+ * non-US Government use and distribution.
+ *
+ * This Software includes and/or makes use of the following Third-Party
+ * Software subject to its own license:
+ *
+ * 1. Matrix Market Loader code (https://math.nist.gov/MatrixMarket/mmio-c.html).
+ *
+ *      The code made publicly available at nist.gov is not marked with a 
+ *      copyright notice and is therefore believed pursuant to section 105 of 
+ *      the Copyright Act, to not be entitled to domestic copyright protection 
+ *      under U.S. law and is therefore in the public domain.  Accordingly, it 
+ *      is believed that no license is required for its use.
+ *
+ * This Software may include certain portions of copyrighted code that is 
+ * initially being released only in binary form for validation and evaluation
+ * purposes. It is expected that source code will be released as open source at
+ * a future date. 
+ *
+ * DM20-0375
+ */
+ 
+#include "ch.h"
+#include "graph.h"
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#define CH_INF UINT32_MAX
+// Priority of a vertex left for the core.
+#define CH_DEFERRED INT32_MAX
+
+typedef struct {
+ uint32_t v;
+ uint32_t w;
+} ch_arc_t;
+
+typedef std::vector<ch_arc_t> arc_list_t;
+
+typedef struct {
+ uint32_t from;
+ uint32_t to;
+ uint32_t w;
+} ch_shortcut_t;
+
+// The remaining graph during contraction. A contracted vertex is detached
+// from its neighbors' lists, and its own lists are then its final up and
+// down edges. The destructor is out of line: the implicit one is too large
+// to inline and trips -Winline.
+struct ch_state_t {
+ std::vector<arc_list_t> out;
+ std::vector<arc_list_t> in;
+ std::vector<int32_t> prio;
+ std::vector<uint32_t> deleted;  // contracted neighbors
+ std::vector<uint32_t> level;
+ std::vector<uint8_t> busy;      // contracted in the current round
+ std::vector<uint8_t> dirty;     // priority needs an update
+ ~ch_state_t();
+};
+
+ch_state_t::~ch_state_t(){
+}
+
+static inline bool entry_after(const p2p_entry_t<uint32_t> & a,
+  const p2p_entry_t<uint32_t> & b)
+{
+ return a.key > b.key;
+}
+
+static inline void heap_push(std::vector<p2p_entry_t<uint32_t> > & heap,
+  uint32_t d, uint32_t v)
+{
+ p2p_entry_t<uint32_t> entry = {(double)d, d, v};
+ heap.push_back(entry);
+ std::push_heap(heap.begin(), heap.end(), entry_after);
+}
+
+static inline p2p_entry_t<uint32_t> heap_pop(
+  std::vector<p2p_entry_t<uint32_t> > & heap)
+{
+ std::pop_heap(heap.begin(), heap.end(), entry_after);
+ p2p_entry_t<uint32_t> top = heap.back();
+ heap.pop_back();
+ return top;
+}
+
+static inline bool arc_before(const ch_arc_t & a, const ch_arc_t & b){
+ return a.v < b.v || (a.v == b.v && a.w < b.w);
+}
+
+// Row v of (I, J, W) without self loops, keeping the lightest of parallel
+// edges.
+static void load_arcs(arc_list_t & list, uint32_t * I, uint32_t * J,
+  uint32_t * W, uint32_t v)
+{
+ for (uint32_t edx = I[v]; edx < I[v+1]; edx++){
+  if (J[edx] == v) continue;
+  ch_arc_t arc = {J[edx], W[edx]};
+  list.push_back(arc);
+ }
+ std::sort(list.begin(), list.end(), arc_before);
+ size_t kept = 0;
+ for (size_t idx = 0; idx < list.size(); idx++){
+  if (kept == 0 || list[kept-1].v != list[idx].v) list[kept++] = list[idx];
+ }
+ list.resize(kept);
+}
+
+// Insert v -> w, or lower the weight of an existing arc to v.
+static void add_arc(arc_list_t & list, uint32_t v, uint32_t w){
+ for (size_t idx = 0; idx < list.size(); idx++){
+  if (list[idx].v == v){
+   list[idx].w = MIN(list[idx].w, w);
+   return;
+  }
+ }
+ ch_arc_t arc = {v, w};
+ list.push_back(arc);
+}
+
+static void remove_arc(arc_list_t & list, uint32_t v){
+ for (size_t idx = 0; idx < list.size(); idx++){
+  if (list[idx].v == v){
+   list[idx] = list.back();
+   list.pop_back();
+   return;
+  }
+ }
+}
+
+// Bounded Dijkstra from u over the remaining graph that avoids v and the
+// other vertices of the round, settling at most max_settled vertices and
+// relaxing at most max_relaxed edges (a partial search only leaves longer
+// distances, so it can add shortcuts but never miss one). It stops early
+// once all num_targets vertices marked in sc->dist[1] are settled.
+// Distances are left in sc->dist[0] for the caller, who resets them with
+// witness_reset.
+static void witness_search(ch_state_t & st, p2p_scratch_t<uint32_t> * sc,
+  uint32_t u, uint32_t v, uint32_t bound, uint32_t num_targets,
+  uint32_t max_settled, uint32_t max_relaxed)
+{
+ uint32_t * dist = sc->dist[0];
+ std::vector<p2p_entry_t<uint32_t> > & heap = sc->heap[0];
+ dist[u] = 0;
+ sc->touched.push_back(u);
+ heap_push(heap, 0, u);
+ uint32_t settled = 0, relaxed = 0;
+ while (!heap.empty() && relaxed < max_relaxed){
+  p2p_entry_t<uint32_t> top = heap_pop(heap);
+  uint32_t x = top.v;
+  if (top.dist != dist[x]) continue;
+  if (top.dist > bound || ++settled > max_settled) break;
+  if (x != u && sc->dist[1][x] != CH_INF && --num_targets == 0) break;
+  for (size_t adx = 0; adx < st.out[x].size() && relaxed < max_relaxed;
+       adx++, relaxed++){
+   uint32_t y = st.out[x][adx].v;
+   if (y == v || st.busy[y]) continue;
+   uint32_t nd = sssp_add(top.dist, st.out[x][adx].w);
+   if (nd > bound || nd >= dist[y]) continue;
+   if (dist[y] == CH_INF) sc->touched.push_back(y);
+   dist[y] = nd;
+   heap_push(heap, nd, y);
+  }
+ }
+ heap.clear();
+}
+
+static void witness_reset(p2p_scratch_t<uint32_t> * sc){
+ for (size_t idx = 0; idx < sc->touched.size(); idx++){
+  sc->dist[0][sc->touched[idx]] = CH_INF;
+ }
+ sc->touched.clear();
+}
+
+// Shortcuts needed to contract v: u -> x for every in-neighbor u and
+// out-neighbor x without a witness path as short as u -> v -> x. Appended
+// to shortcuts if given. Returns how many there are.
+static uint32_t simulate_contraction(ch_state_t & st,
+  p2p_scratch_t<uint32_t> * sc, uint32_t v, uint32_t max_settled,
+  uint32_t max_relaxed, std::vector<ch_shortcut_t> * shortcuts)
+{
+ uint32_t num = 0;
+ uint32_t max_out = 0;
+ for (size_t bdx = 0; bdx < st.out[v].size(); bdx++){
+  max_out = MAX(max_out, st.out[v][bdx].w);
+  sc->dist[1][st.out[v][bdx].v] = 0;
+ }
+ for (size_t adx = 0; adx < st.in[v].size(); adx++){
+  uint32_t u = st.in[v][adx].v;
+  uint32_t w_in = st.in[v][adx].w;
+  uint32_t num_targets = st.out[v].size() - (sc->dist[1][u] != CH_INF);
+  if (num_targets == 0) continue;
+  witness_search(st, sc, u, v, sssp_add(w_in, max_out), num_targets,
+    max_settled, max_relaxed);
+  for (size_t bdx = 0; bdx < st.out[v].size(); bdx++){
+   uint32_t x = st.out[v][bdx].v;
+   if (x == u) continue;
+   uint32_t via = sssp_add(w_in, st.out[v][bdx].w);
+   if (sc->dist[0][x] > via){
+    num++;
+    if (shortcuts){
+     ch_shortcut_t sh = {u, x, via};
+     shortcuts->push_back(sh);
+    }
+   }
+  }
+  witness_reset(sc);
+ }
+ for (size_t bdx = 0; bdx < st.out[v].size(); bdx++){
+  sc->dist[1][st.out[v][bdx].v] = CH_INF;
+ }
+ return num;
+}
+
+// Edge difference plus the number of contracted neighbors, which spreads
+// the contraction evenly over the graph. Hubs are not simulated at all.
+static int32_t priority(ch_state_t & st, p2p_scratch_t<uint32_t> * sc,
+  uint32_t v)
+{
+ if ((uint64_t)st.in[v].size() * st.out[v].size() > CH_MAX_PAIRS){
+  return CH_DEFERRED;
+ }
+ int32_t added = simulate_contraction(st, sc, v, CH_PRIORITY_SETTLED,
+   CH_PRIORITY_RELAXED, NULL);
+ int32_t removed = st.in[v].size() + st.out[v].size();
+ return added - removed + (int32_t)st.deleted[v];
+}
+
+static inline uint32_t tie_hash(uint32_t v){
+ return v * 2654435761u;
+}
+
+// Strict order on the remaining vertices: priority, then a hash of the id
+// so that ties do not line up along the vertex numbering.
+static inline bool contract_before(const ch_state_t & st, uint32_t a,
+  uint32_t b)
+{
+ if (st.prio[a] != st.prio[b]) return st.prio[a] < st.prio[b];
+ if (tie_hash(a) != tie_hash(b)) return tie_hash(a) < tie_hash(b);
+ return a < b;
+}
+
+static bool is_local_min(const ch_state_t & st, uint32_t v){
+ if (st.prio[v] == CH_DEFERRED) return false;
+ for (size_t adx = 0; adx < st.out[v].size(); adx++){
+  if (!contract_before(st, v, st.out[v][adx].v)) return false;
+ }
+ for (size_t adx = 0; adx < st.in[v].size(); adx++){
+  if (!contract_before(st, v, st.in[v][adx].v)) return false;
+ }
+ return true;
+}
+
+// CSR of the given lists.
+static void lists_to_csr(const std::vector<arc_list_t> & lists, uint32_t N,
+  uint32_t ** I, uint32_t ** J, uint32_t ** W)
+{
+ *I = (uint32_t *)malloc((N + 1) * sizeof(uint32_t));
+ if (!*I){
+  fprintf(stderr, "ERROR: could not allocate hierarchy.\n");
+  exit(EXIT_FAILURE);
+ }
+ (*I)[0] = 0;
+ for (uint32_t v = 0; v < N; v++){
+  (*I)[v+1] = (*I)[v] + lists[v].size();
+ }
+ uint32_t M = (*I)[N];
+ *J = (uint32_t *)malloc(MAX(M, 1) * sizeof(uint32_t));
+ *W = (uint32_t *)malloc(MAX(M, 1) * sizeof(uint32_t));
+ if (!*J || !*W){
+  fprintf(stderr, "ERROR: could not allocate hierarchy.\n");
+  exit(EXIT_FAILURE);
+ }
+#pragma omp parallel for schedule(dynamic, 64)
+ for (uint32_t v = 0; v < N; v++){
+  for (size_t adx = 0; adx < lists[v].size(); adx++){
+   (*J)[(*I)[v] + adx] = lists[v][adx].v;
+   (*W)[(*I)[v] + adx] = lists[v][adx].w;
+  }
+ }
+}
+
+ch_graph_t * ch_build(uint32_t * IA, uint32_t * JA, uint32_t * A, uint32_t N){
+ ch_state_t st;
+ st.out.resize(N);
+ st.in.resize(N);
+ st.prio.resize(N);
+ st.deleted.assign(N, 0);
+ st.level.assign(N, 0);
+ st.busy.assign(N, 0);
+ st.dirty.assign(N, 0);
+
+ uint32_t * IAc = NULL, * JAc = NULL, * Ac = NULL;
+ if (!csr_to_csc_weighted(IA, JA, A, &IAc, &JAc, &Ac, N)){
+  fprintf(stderr, "ERROR: could not allocate weighted transpose.\n");
+  exit(EXIT_FAILURE);
+ }
+#pragma omp parallel for schedule(dynamic, 64)
+ for (uint32_t v = 0; v < N; v++){
+  load_arcs(st.out[v], IA, JA, A, v);
+  load_arcs(st.in[v], IAc, JAc, Ac, v);
+ }
+ free(IAc);
+ free(JAc);
+ free(Ac);
+
+ uint32_t num_threads = omp_get_max_threads();
+ std::vector<p2p_scratch_t<uint32_t> *> scratch(num_threads);
+ std::vector<std::vector<ch_shortcut_t> > shortcuts(num_threads);
+ for (uint32_t tid = 0; tid < num_threads; tid++){
+  scratch[tid] = p2p_scratch_alloc<uint32_t>(N);
+ }
+
+ // A graph already denser than CH_CORE_DEGREE is all core, and the first
+ // round stops before any priority is looked at.
+ uint64_t num_arcs = 0;
+#pragma omp parallel for schedule(static) reduction(+:num_arcs)
+ for (uint32_t v = 0; v < N; v++){
+  num_arcs += st.out[v].size();
+ }
+ if (CH_CORE_DEGREE == 0 || num_arcs <= (uint64_t)CH_CORE_DEGREE * N){
+#pragma omp parallel for schedule(dynamic, 64) num_threads(num_threads)
+  for (uint32_t v = 0; v < N; v++){
+   st.prio[v] = priority(st, scratch[omp_get_thread_num()], v);
+  }
+ }
+
+ std::vector<uint32_t> rem(N), sel(N);
+ for (uint32_t v = 0; v < N; v++){
+  rem[v] = v;
+ }
+ uint32_t num_rem = N;
+ uint32_t round = 0;
+ while (num_rem > 0){
+  uint64_t rem_edges = 0;
+  uint32_t num_sel = 0;
+#pragma omp parallel for schedule(dynamic, 1024) reduction(+:rem_edges)
+  for (uint32_t rdx = 0; rdx < num_rem; rdx++){
+   uint32_t v = rem[rdx];
+   rem_edges += st.out[v].size();
+   if (is_local_min(st, v)){
+    sel[__sync_fetch_and_add(&num_sel, 1)] = v;
+   }
+  }
+  // Stop at a dense core, or when only deferred hubs are left. The core
+  // vertices keep all their edges.
+  if (num_sel == 0 ||
+      (CH_CORE_DEGREE > 0 && rem_edges > (uint64_t)CH_CORE_DEGREE * num_rem)){
+   for (uint32_t rdx = 0; rdx < num_rem; rdx++){
+    st.level[rem[rdx]] = round;
+   }
+   round++;
+   break;
+  }
+  for (uint32_t sdx = 0; sdx < num_sel; sdx++){
+   st.busy[sel[sdx]] = 1;
+  }
+
+  // Witness searches for the whole independent set at once.
+#pragma omp parallel num_threads(num_threads)
+  {
+   uint32_t tid = omp_get_thread_num();
+   shortcuts[tid].clear();
+#pragma omp for schedule(dynamic, 16)
+   for (uint32_t sdx = 0; sdx < num_sel; sdx++){
+    simulate_contraction(st, scratch[tid], sel[sdx], CH_WITNESS_SETTLED,
+      CH_WITNESS_RELAXED, &shortcuts[tid]);
+   }
+  }
+
+  // Detach the contracted vertices and insert their shortcuts. Neighboring
+  // lists are shared between contracted vertices, so this part is serial.
+  for (uint32_t sdx = 0; sdx < num_sel; sdx++){
+   uint32_t v = sel[sdx];
+   st.level[v] = round;
+   for (size_t adx = 0; adx < st.out[v].size(); adx++){
+    uint32_t x = st.out[v][adx].v;
+    remove_arc(st.in[x], v);
+    st.deleted[x]++;
+    st.dirty[x] = 1;
+   }
+   for (size_t adx = 0; adx < st.in[v].size(); adx++){
+    uint32_t u = st.in[v][adx].v;
+    remove_arc(st.out[u], v);
+    st.deleted[u]++;
+    st.dirty[u] = 1;
+   }
+  }
+  for (uint32_t tid = 0; tid < num_threads; tid++){
+   for (size_t idx = 0; idx < shortcuts[tid].size(); idx++){
+    const ch_shortcut_t & sh = shortcuts[tid][idx];
+    add_arc(st.out[sh.from], sh.to, sh.w);
+    add_arc(st.in[sh.to], sh.from, sh.w);
+   }
+  }
+
+  uint32_t kept = 0;
+  for (uint32_t rdx = 0; rdx < num_rem; rdx++){
+   if (!st.busy[rem[rdx]]) rem[kept++] = rem[rdx];
+  }
+  num_rem = kept;
+#pragma omp parallel for schedule(dynamic, 64) num_threads(num_threads)
+  for (uint32_t rdx = 0; rdx < num_rem; rdx++){
+   uint32_t v = rem[rdx];
+   if (st.dirty[v]){
+    st.prio[v] = priority(st, scratch[omp_get_thread_num()], v);
+    st.dirty[v] = 0;
+   }
+  }
+  round++;
+ }
+ for (uint32_t tid = 0; tid < num_threads; tid++){
+  p2p_scratch_free(scratch[tid]);
+ }
+
+ ch_graph_t * ch = (ch_graph_t *)calloc(1, sizeof(ch_graph_t));
+ if (!ch){
+  fprintf(stderr, "ERROR: could not allocate hierarchy.\n");
+  exit(EXIT_FAILURE);
+ }
+ ch->N = N;
+ ch->rank = (uint32_t *)malloc(MAX(N, 1) * sizeof(uint32_t));
+ ch->order = (uint32_t *)malloc(MAX(N, 1) * sizeof(uint32_t));
+ if (!ch->rank || !ch->order){
+  fprintf(stderr, "ERROR: could not allocate hierarchy.\n");
+  exit(EXIT_FAILURE);
+ }
+ // Rank by round; vertices of a round are never adjacent, so any order
+ // within it is consistent. The core, if any, is the last round.
+ std::vector<uint32_t> level_start(round + 1, 0);
+ for (uint32_t v = 0; v < N; v++){
+  level_start[st.level[v] + 1]++;
+ }
+ for (uint32_t l = 0; l < round; l++){
+  level_start[l+1] += level_start[l];
+ }
+ for (uint32_t v = 0; v < N; v++){
+  ch->rank[v] = level_start[st.level[v]]++;
+  ch->order[ch->rank[v]] = v;
+ }
+ lists_to_csr(st.out, N, &ch->up_IA, &ch->up_JA, &ch->up_A);
+ lists_to_csr(st.in, N, &ch->down_IA, &ch->down_JA, &ch->down_A);
+ return ch;
+}
+
+void ch_free(ch_graph_t * ch){
+ free(ch->rank);
+ free(ch->order);
+ free(ch->up_IA);
+ free(ch->up_JA);
+ free(ch->up_A);
+ free(ch->down_IA);
+ free(ch->down_JA);
+ free(ch->down_A);
+ free(ch);
+}
+
+uint64_t ch_num_edges(const ch_graph_t * ch){
+ return (uint64_t)ch->up_IA[ch->N] + ch->down_IA[ch->N];
+}
+
+static bool write_bin(const char * prefix, const char * suffix,
+  const uint32_t * array, uint32_t n)
+{
+ std::string fname = std::string(prefix) + suffix;
+ FILE * fptr = fopen(fname.c_str(), "wb");
+ if (fptr == NULL) return false;
+ bool ok = fwrite(&n, sizeof(uint32_t), 1, fptr) == 1 &&
+   fwrite(array, sizeof(uint32_t), n, fptr) == n;
+ fclose(fptr);
+ return ok;
+}
+
+static uint32_t * read_bin(const char * prefix, const char * suffix,
+  uint32_t * n)
+{
+ std::string fname = std::string(prefix) + suffix;
+ *n = tell_size(fname.c_str());
+ uint32_t * array = (uint32_t *)malloc(MAX(*n, 1) * sizeof(uint32_t));
+ if (!array){
+  fprintf(stderr, "ERROR: could not allocate hierarchy.\n");
+  exit(EXIT_FAILURE);
+ }
+ read_binary_buffers(fname.c_str(), array);
+ return array;
+}
+
+bool ch_save(const ch_graph_t * ch, const char * prefix){
+ uint32_t N = ch->N;
+ return write_bin(prefix, "_rank.bin", ch->rank, N) &&
+   write_bin(prefix, "_up_ia.bin", ch->up_IA, N + 1) &&
+   write_bin(prefix, "_up_ja.bin", ch->up_JA, ch->up_IA[N]) &&
+   write_bin(prefix, "_up_va.bin", ch->up_A, ch->up_IA[N]) &&
+   write_bin(prefix, "_down_ia.bin", ch->down_IA, N + 1) &&
+   write_bin(prefix, "_down_ja.bin", ch->down_JA, ch->down_IA[N]) &&
+   write_bin(prefix, "_down_va.bin", ch->down_A, ch->down_IA[N]);
+}
+
+// Whether (I, J) read with these entry counts is a CSR of N rows, with as
+// many weights as edges and every target below N.
+static bool valid_csr(const uint32_t * I, const uint32_t * J, uint32_t N,
+  uint32_t ia_count, uint32_t ja_count, uint32_t va_count)
+{
+ if (ia_count != N + 1 || I[0] != 0 || I[N] != ja_count ||
+     ja_count != va_count){
+  return false;
+ }
+ uint32_t bad = 0;
+#pragma omp parallel for schedule(dynamic, 1024) reduction(+:bad)
+ for (uint32_t v = 0; v < N; v++){
+  if (I[v] > I[v+1]){
+   bad++;
+   continue;
+  }
+  for (uint32_t edx = I[v]; edx < I[v+1]; edx++){
+   bad += (J[edx] >= N);
+  }
+ }
+ return bad == 0;
+}
+
+ch_graph_t * ch_load(const char * prefix, uint32_t N){
+ std::string fname = std::string(prefix) + "_rank.bin";
+ FILE * fptr = fopen(fname.c_str(), "rb");
+ if (fptr == NULL) return NULL;
+ fclose(fptr);
+
+ ch_graph_t * ch = (ch_graph_t *)calloc(1, sizeof(ch_graph_t));
+ if (!ch){
+  fprintf(stderr, "ERROR: could not allocate hierarchy.\n");
+  exit(EXIT_FAILURE);
+ }
+ uint32_t n_up[3], n_down[3];
+ ch->rank = read_bin(prefix, "_rank.bin", &ch->N);
+ ch->up_IA = read_bin(prefix, "_up_ia.bin", &n_up[0]);
+ ch->up_JA = read_bin(prefix, "_up_ja.bin", &n_up[1]);
+ ch->up_A = read_bin(prefix, "_up_va.bin", &n_up[2]);
+ ch->down_IA = read_bin(prefix, "_down_ia.bin", &n_down[0]);
+ ch->down_JA = read_bin(prefix, "_down_ja.bin", &n_down[1]);
+ ch->down_A = read_bin(prefix, "_down_va.bin", &n_down[2]);
+ ch->order = (uint32_t *)malloc(MAX(ch->N, 1) * sizeof(uint32_t));
+ if (!ch->order){
+  fprintf(stderr, "ERROR: could not allocate hierarchy.\n");
+  exit(EXIT_FAILURE);
+ }
+ // A hierarchy of another graph, or a truncated one, is not used.
+ bool valid = (ch->N == N) &&
+   valid_csr(ch->up_IA, ch->up_JA, N, n_up[0], n_up[1], n_up[2]) &&
+   valid_csr(ch->down_IA, ch->down_JA, N, n_down[0], n_down[1], n_down[2]);
+ if (valid){
+  for (uint32_t r = 0; r < N; r++){
+   ch->order[r] = CH_INF;
+  }
+  for (uint32_t v = 0; v < N && valid; v++){
+   uint32_t r = ch->rank[v];
+   valid = (r < N && ch->order[r] == CH_INF);
+   if (valid) ch->order[r] = v;
+  }
+ }
+ if (!valid){
+  fprintf(stderr,
+    "WARNING: hierarchy %s does not fit the graph (%u vertices)\n",
+    prefix, N);
+  ch_free(ch);
+  return NULL;
+ }
+ return ch;
+}
+
+uint32_t ch_distance(const ch_graph_t * ch, p2p_scratch_t<uint32_t> * sc,
+  uint32_t s, uint32_t t, p2p_stats_t * stats)
+{
+ if (stats){
+  stats->settled = 0;
+  stats->relaxations = 0;
+ }
+ if (s == t) return 0;
+
+ const uint32_t * I[2] = {ch->up_IA, ch->down_IA};
+ const uint32_t * J[2] = {ch->up_JA, ch->down_JA};
+ const uint32_t * V[2] = {ch->up_A, ch->down_A};
+ uint32_t * dist[2] = {sc->dist[0], sc->dist[1]};
+ std::vector<uint32_t> & touched = sc->touched;
+
+ dist[0][s] = 0;
+ dist[1][t] = 0;
+ touched.push_back(s);
+ touched.push_back(t);
+ heap_push(sc->heap[0], 0, s);
+ heap_push(sc->heap[1], 0, t);
+
+ uint32_t mu = CH_INF;
+ uint64_t settled = 0, relaxations = 0;
+ while (true){
+  bool live[2];
+  for (uint32_t side = 0; side < 2; side++){
+   live[side] = !sc->heap[side].empty() && sc->heap[side].front().dist < mu;
+  }
+  if (!live[0] && !live[1]) break;
+  uint32_t side = (live[0] && (!live[1] ||
+    sc->heap[0].front().dist <= sc->heap[1].front().dist)) ? 0 : 1;
+  p2p_entry_t<uint32_t> top = heap_pop(sc->heap[side]);
+  uint32_t u = top.v;
+  if (top.dist != dist[side][u]) continue;
+  settled++;
+
+  uint32_t * mine = dist[side];
+  uint32_t * other = dist[1 - side];
+  for (uint32_t edx = I[side][u]; edx < I[side][u+1]; edx++){
+   uint32_t x = J[side][edx];
+   uint32_t nd = sssp_add(top.dist, V[side][edx]);
+   relaxations++;
+   if (nd >= mine[x]) continue;
+   if (mine[x] == CH_INF && other[x] == CH_INF) touched.push_back(x);
+   mine[x] = nd;
+   heap_push(sc->heap[side], nd, x);
+   if (other[x] != CH_INF) mu = MIN(mu, sssp_add(nd, other[x]));
+  }
+ }
+
+ for (size_t idx = 0; idx < touched.size(); idx++){
+  dist[0][touched[idx]] = CH_INF;
+  dist[1][touched[idx]] = CH_INF;
+ }
+ touched.clear();
+ sc->heap[0].clear();
+ sc->heap[1].clear();
+ if (stats){
+  stats->settled = settled;
+  stats->relaxations = relaxations;
+ }
+ return mu;
+}
+
+void ch_sssp(const ch_graph_t * ch, uint32_t s, uint32_t * lens){
+ uint32_t N = ch->N;
+ for (uint32_t v = 0; v < N; v++){
+  lens[v] = CH_INF;
+ }
+ std::vector<p2p_entry_t<uint32_t> > heap;
+ lens[s] = 0;
+ heap_push(heap, 0, s);
+ while (!heap.empty()){
+  p2p_entry_t<uint32_t> top = heap_pop(heap);
+  uint32_t u = top.v;
+  if (top.dist != lens[u]) continue;
+  for (uint32_t edx = ch->up_IA[u]; edx < ch->up_IA[u+1]; edx++){
+   uint32_t x = ch->up_JA[edx];
+   uint32_t nd = sssp_add(top.dist, ch->up_A[edx]);
+   if (nd < lens[x]){
+    lens[x] = nd;
+    heap_push(heap, nd, x);
+   }
+  }
+ }
+ // Every down edge into v starts at a higher rank, which is final by now.
+ for (uint32_t r = N; r-- > 0; ){
+  uint32_t v = ch->order[r];
+  for (uint32_t edx = ch->down_IA[v]; edx < ch->down_IA[v+1]; edx++){
+   uint32_t u = ch->down_JA[edx];
+   lens[v] = MIN(lens[v], sssp_add(lens[u], ch->down_A[edx]));
+  }
+ }
+}
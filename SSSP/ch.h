@@ -0,0 +1,153 @@
+/*
+ * Graph Kernel Collection
+ *
+ * Copyright 2020 Carnegie Mellon University.
+ *
+ * NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ * INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON 
+ * UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR IMPLIED, 
+ * AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF FITNESS FOR 
+ * PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS OBTAINED FROM USE OF 
+ * THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES NOT MAKE ANY WARRANTY OF ANY
+ * KIND WITH RESPECT TO FREEDOM FROM PATENT, TRADEMARK, OR COPYRIGHT 
+ * INFRINGEMENT.
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or
+ * contact permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public
+ * release and unlimited distribution.  Please see Copyright notice for 
+ * non-US Government use and distribution.
+ *
+ * This Software includes and/or makes use of the following Third-Party
+ * Software subject to its own license:
+ *
+ * 1. Matrix Market Loader code (https://math.nist.gov/MatrixMarket/mmio-c.html).
+ *
+ *      The code made publicly available at nist.gov is not marked with a 
+ *      copyright notice and is therefore believed pursuant to section 105 of 
+ *      the Copyright Act, to not be entitled to domestic copyright protection 
+ *      under U.S. law and is therefore in the public domain.  Accordingly, it 
+ *      is believed that no license is required for its use.
+ *
+ * This Software may include certain portions of copyrighted code that is 
+ * initially being released only in binary form for validation and evaluation
+ * purposes. It is expected that source code will be released as open source at
+ * a future date. 
+ *
+ * DM20-0375
+ */
+ 
+#ifndef CH_H
+#define CH_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <omp.h>
+#include "utils.h"
+#include "p2p.h"
+
+// A witness search gives up (and the shortcut is added) after settling this
+// many vertices or relaxing this many edges, whichever comes first; the
+// edge limit bounds the heap pushes when a hub is settled. Estimating a
+// priority uses the smaller limits.
+#ifndef CH_WITNESS_SETTLED
+#define CH_WITNESS_SETTLED 500
+#endif
+#ifndef CH_PRIORITY_SETTLED
+#define CH_PRIORITY_SETTLED 50
+#endif
+#ifndef CH_WITNESS_RELAXED
+#define CH_WITNESS_RELAXED 4096
+#endif
+#ifndef CH_PRIORITY_RELAXED
+#define CH_PRIORITY_RELAXED 512
+#endif
+
+// Contraction stops once the remaining vertices average more than this many
+// out-edges (0 disables the test). They form the core of the hierarchy and
+// keep all their edges between each other.
+#ifndef CH_CORE_DEGREE
+#define CH_CORE_DEGREE 16
+#endif
+
+// Vertices with more (in-neighbor, out-neighbor) pairs than this are not
+// contracted; on skewed graphs the hubs end up in the core.
+#ifndef CH_MAX_PAIRS
+#define CH_MAX_PAIRS 4096
+#endif
+
+/*
+ * Contraction hierarchy over a graph with uint32_t weights.
+ *
+ * rank[v] is the position of v in the contraction order; vertices keep
+ * their ids. The augmented graph (original edges plus shortcuts) is split
+ * by rank: up_* is a CSR of the edges v -> u with rank[u] > rank[v], and down_*
+ * holds each edge u -> v with rank[u] > rank[v] in the row of its target
+ * v, so a backward search from t also only climbs. Edges between two core
+ * vertices (see CH_CORE_DEGREE), contracted together in the last round,
+ * appear in both.
+ */
+typedef struct {
+ uint32_t N;
+ uint32_t * rank;
+ uint32_t * order;       // inverse of rank
+ uint32_t * up_IA;
+ uint32_t * up_JA;
+ uint32_t * up_A;
+ uint32_t * down_IA;
+ uint32_t * down_JA;
+ uint32_t * down_A;
+} ch_graph_t;
+
+/*
+ * Build the hierarchy from the CSR (IA, JA, A).
+ *
+ * Each round computes the edge difference of the remaining vertices
+ * (shortcuts a contraction would add, minus the edges it removes, plus the
+ * neighbors already contracted), picks every vertex whose priority is a
+ * strict minimum among its remaining neighbors, and contracts that
+ * independent set in parallel: the witness searches (bounded Dijkstra
+ * that avoids the vertices of the round, up to CH_WITNESS_SETTLED settled
+ * vertices and CH_WITNESS_RELAXED relaxed edges) run concurrently, and the
+ * shortcuts are then inserted serially. Only the neighbors of contracted
+ * vertices are re-prioritized, with searches limited to
+ * CH_PRIORITY_SETTLED and CH_PRIORITY_RELAXED.
+ */
+ch_graph_t * ch_build(uint32_t * IA, uint32_t * JA, uint32_t * A, uint32_t N);
+
+// Write the hierarchy as <prefix>_rank.bin, <prefix>_up_{ia,ja,va}.bin and
+// <prefix>_down_{ia,ja,va}.bin, in the format of the input binaries.
+// Returns false if a file cannot be written.
+bool ch_save(const ch_graph_t * ch, const char * prefix);
+
+// Read a hierarchy written by ch_save for a graph of N vertices. Returns
+// NULL if it is not there, or (with a warning) if it does not fit: another
+// vertex count, section lengths that disagree, ranks that are not a
+// permutation or edges out of range. A hierarchy of a different graph with
+// the same shape is not detected.
+ch_graph_t * ch_load(const char * prefix, uint32_t N);
+
+void ch_free(ch_graph_t * ch);
+
+uint64_t ch_num_edges(const ch_graph_t * ch);
+
+/*
+ * Distance from s to t, or UINT32_MAX if t is unreachable. Bidirectional
+ * Dijkstra that only follows upward edges on both sides; a side stops once
+ * its heap minimum reaches the best meeting distance. Uses the per-thread
+ * query scratch of p2p.h (sparse reset), which must not be shared between
+ * concurrent queries. stats may be NULL.
+ */
+uint32_t ch_distance(const ch_graph_t * ch, p2p_scratch_t<uint32_t> * scratch,
+  uint32_t s, uint32_t t, p2p_stats_t * stats);
+
+/*
+ * Distances from s to every vertex (PHAST): an upward search from s, then
+ * one sweep over all vertices in decreasing rank that pulls along the down
+ * edges. Fills N entries of lens, UINT32_MAX for unreachable vertices.
+ * Single-threaded; used to check the hierarchy against check_dists.
+ */
+void ch_sssp(const ch_graph_t * ch, uint32_t s, uint32_t * lens);
+#endif
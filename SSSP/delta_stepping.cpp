@@ -0,0 +1,225 @@
+/*
+ * Graph Kernel Collection
+ *
+ * Copyright 2020 Carnegie Mellon University.
+ *
+ * NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ * INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON 
+ * UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR IMPLIED, 
+ * AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF FITNESS FOR 
+ * PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS OBTAINED FROM USE OF 
+ * THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES NOT MAKE ANY WARRANTY OF ANY
+ * KIND WITH RESPECT TO FREEDOM FROM PATENT, TRADEMARK, OR COPYRIGHT 
+ * INFRINGEMENT.
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or
+ * contact permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public
+ * release and unlimited distribution.  Please see Copyright notice for 
+ * non-US Government use and distribution.
+ *
+ * This Software includes and/or makes use of the following Third-Party
+ * Software subject to its own license:
+ *
+ * 1. Matrix Market Loader code (https://math.nist.gov/MatrixMarket/mmio-c.html).
+ *
+ *      The code made publicly available at nist.gov is not marked with a 
+ *      copyright notice and is therefore believed pursuant to section 105 of 
+ *      the Copyright Act, to not be entitled to domestic copyright protection 
+ *      under U.S. law and is therefore in the public domain.  Accordingly, it 
+ *      is believed that no license is required for its use.
+ *
+ * This Software may include certain portions of copyrighted code that is 
+ * initially being released only in binary form for validation and evaluation
+ * purposes. It is expected that source code will be released as open source at
+ * a future date. 
+ *
+ * DM20-0375
+ */
+ 
+#include "delta_stepping.h"
+#include "auto_delta.h"
+#include <math.h>
+
+#define INF UINT32_MAX
+
+// Lower *loc to val. Returns the previous value if this call lowered it,
+// INF+1 (as uint64_t) otherwise.
+static inline uint64_t lower_dist(uint32_t * loc, uint32_t val){
+ uint32_t cmp = *loc;
+ while (val < cmp){
+  uint32_t tmp = __sync_val_compare_and_swap(loc, cmp, val);
+  if (tmp == cmp) return cmp;
+  cmp = tmp;
+ }
+ return (uint64_t)INF + 1;
+}
+
+uint32_t delta_stepping(uint32_t * IA, uint32_t * JA, uint32_t * A,
+  uint32_t N, uint32_t * lens, uint32_t src, uint32_t delta,
+  sssp_stats_t * stats, anytime_t * ctl)
+{
+ if (N == 0 || src >= N) return 0;
+ bool adapt = (delta == 0);
+ uint64_t width = adapt ? sssp_auto_delta(IA, JA, A, N) : delta;
+ uint32_t * frontier = (uint32_t *)malloc(N * sizeof(uint32_t));
+ uint32_t * next = (uint32_t *)malloc(N * sizeof(uint32_t));
+ uint32_t * pending = (uint32_t *)malloc(N * sizeof(uint32_t));
+ uint8_t * in_frontier = (uint8_t *)malloc(N * sizeof(uint8_t));
+ uint8_t * in_pending = (uint8_t *)malloc(N * sizeof(uint8_t));
+ if (!frontier || !next || !pending || !in_frontier || !in_pending){
+  fprintf(stderr, "ERROR: could not allocate SSSP work arrays.\n");
+  exit(EXIT_FAILURE);
+ }
+#pragma omp parallel for
+ for (uint32_t v = 0; v < N; v++){
+  lens[v] = INF;
+  in_frontier[v] = 0;
+  in_pending[v] = 0;
+ }
+ lens[src] = 0;
+ frontier[0] = src;
+ in_frontier[src] = 1;
+ uint32_t f_size = 1, p_size = 0;
+ uint32_t num_buckets = 0;
+ uint32_t init_width = width, min_width = width, max_width = width;
+ uint64_t relaxations = 0, vertex_ops = 0;
+ double log_width_work = 0;
+ uint32_t min_work = SSSP_ADAPT_MIN_WORK * omp_get_max_threads();
+ // The current bucket is [lo, hi).
+ uint64_t lo = 0, hi = width;
+ uint32_t distinct = 1;
+ bool stopped = anytime_expired(ctl);
+
+ while (!stopped){
+  num_buckets++;
+  uint64_t processed = 0;
+  // Relax the bucket until no vertex re-enters it.
+  while (f_size > 0 && !stopped){
+   uint32_t n_size = 0;
+   processed += f_size;
+#pragma omp parallel for schedule(dynamic, 64) reduction(+:relaxations, distinct)
+   for (uint32_t fdx = 0; fdx < f_size; fdx++){
+    if (stopped || ((fdx & 63) == 0 && anytime_expired(ctl))){
+     stopped = true;
+     continue;
+    }
+    uint32_t u = frontier[fdx];
+    in_frontier[u] = 0;
+    __sync_synchronize();
+    uint32_t du = lens[u];
+    relaxations += IA[u+1] - IA[u];
+    for (uint32_t edx = IA[u]; edx < IA[u+1]; edx++){
+     uint32_t v = JA[edx];
+     uint64_t nd = (uint64_t)du + A[edx];
+     if (nd >= lens[v]) continue;
+     uint64_t old = lower_dist(&lens[v], nd);
+     if (old > INF) continue;
+     if (nd < hi){
+      if (in_frontier[v] == 0 && __sync_bool_compare_and_swap(&in_frontier[v], 0, 1)){
+       next[__sync_fetch_and_add(&n_size, 1)] = v;
+       if (old >= hi) distinct++;
+      }
+     } else if (in_pending[v] == 0 &&
+                __sync_bool_compare_and_swap(&in_pending[v], 0, 1)){
+      pending[__sync_fetch_and_add(&p_size, 1)] = v;
+     }
+    }
+   }
+   uint32_t * tmp = frontier;
+   frontier = next;
+   next = tmp;
+   f_size = n_size;
+  }
+  vertex_ops += processed;
+  log_width_work += log2((double)width) * processed;
+  if (stopped) break;
+
+  // Every distance below the smallest pending one is now final.
+  uint32_t next_lo = INF, max_dist = 0;
+#pragma omp parallel for reduction(min:next_lo) reduction(max:max_dist)
+  for (uint32_t pdx = 0; pdx < p_size; pdx++){
+   uint32_t d = lens[pending[pdx]];
+   if (d >= hi){
+    next_lo = MIN(next_lo, d);
+    max_dist = MAX(max_dist, d);
+   }
+  }
+  if (next_lo == INF) break;
+
+  // Auto mode: widen buckets that are too small to occupy the threads,
+  // narrow them when vertices are relaxed too many times.
+  if (adapt){
+   if (processed > SSSP_ADAPT_MAX_REWORK * distinct){
+    width = MAX(width / 2, 1);
+   } else if (distinct < min_work && width < (1u << 31)){
+    width *= 2;
+   }
+   min_width = MIN(min_width, width);
+   max_width = MAX(max_width, width);
+  }
+  uint64_t old_hi = hi;
+  lo = next_lo;
+  hi = lo + width;
+  if (anytime_step(ctl, (double)lo / max_dist, lo)){
+   stopped = true;
+   break;
+  }
+
+  // Move the new bucket from pending to the frontier, dropping entries that
+  // were since settled in an earlier bucket.
+  uint32_t k_size = 0;
+#pragma omp parallel for
+  for (uint32_t pdx = 0; pdx < p_size; pdx++){
+   uint32_t v = pending[pdx];
+   uint32_t d = lens[v];
+   if (d >= hi){
+    next[__sync_fetch_and_add(&k_size, 1)] = v;
+    continue;
+   }
+   in_pending[v] = 0;
+   if (d >= old_hi){
+    in_frontier[v] = 1;
+    frontier[__sync_fetch_and_add(&f_size, 1)] = v;
+   }
+  }
+  distinct = f_size;
+  uint32_t * tmp = pending;
+  pending = next;
+  next = tmp;
+  p_size = k_size;
+ }
+
+ if (ctl){
+  ctl->completed = !stopped;
+  ctl->err_bound = stopped ? (double)lo : (double)INF;
+ }
+ if (stats){
+  stats->buckets = num_buckets;
+  stats->delta_initial = init_width;
+  stats->delta_final = width;
+  stats->delta_min = min_width;
+  stats->delta_max = max_width;
+  stats->delta_typical = (uint32_t)exp2(round(log_width_work / MAX(vertex_ops, 1)));
+  stats->relaxations = relaxations;
+  stats->vertex_ops = vertex_ops;
+ }
+ free(frontier);
+ free(next);
+ free(pending);
+ free(in_frontier);
+ free(in_pending);
+ return num_buckets;
+}
+
+uint32_t sssp_calibrate_delta(uint32_t * IA, uint32_t * JA, uint32_t * A,
+  uint32_t N, uint32_t src)
+{
+ uint32_t * lens = (uint32_t *)malloc(MAX(N, 1) * sizeof(uint32_t));
+ sssp_stats_t stats;
+ stats.delta_typical = 1;
+ delta_stepping(IA, JA, A, N, lens, src, 0, &stats, NULL);
+ free(lens);
+ return MAX(stats.delta_typical, 1);
+}
@@ -0,0 +1,104 @@
+/*
+ * Graph Kernel Collection
+ *
+ * Copyright 2020 Carnegie Mellon University.
+ *
+ * NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ * INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON 
+ * UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR IMPLIED, 
+ * AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF FITNESS FOR 
+ * PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS OBTAINED FROM USE OF 
+ * THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES NOT MAKE ANY WARRANTY OF ANY
+ * KIND WITH RESPECT TO FREEDOM FROM PATENT, TRADEMARK, OR COPYRIGHT 
+ * INFRINGEMENT.
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or
+ * contact permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public
+ * release and unlimited distribution.  Please see Copyright notice for 
+ * non-US Government use and distribution.
+ *
+ * This Software includes and/or makes use of the following Third-Party
+ * Software subject to its own license:
+ *
+ * 1. Matrix Market Loader code (https://math.nist.gov/MatrixMarket/mmio-c.html).
+ *
+ *      The code made publicly available at nist.gov is not marked with a 
+ *      copyright notice and is therefore believed pursuant to section 105 of 
+ *      the Copyright Act, to not be entitled to domestic copyright protection 
+ *      under U.S. law and is therefore in the public domain.  Accordingly, it 
+ *      is believed that no license is required for its use.
+ *
+ * This Software may include certain portions of copyrighted code that is 
+ * initially being released only in binary form for validation and evaluation
+ * purposes. It is expected that source code will be released as open source at
+ * a future date. 
+ *
+ * DM20-0375
+ */
+ 
+#ifndef DELTA_STEPPING_H
+#define DELTA_STEPPING_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <omp.h>
+#include "utils.h"
+#include "anytime.h"
+
+// Auto mode (delta == 0) doubles the bucket width after a bucket that
+// settled fewer than SSSP_ADAPT_MIN_WORK vertices per thread, and halves it
+// after one that processed more than SSSP_ADAPT_MAX_REWORK times as many
+// vertices as it settled.
+#ifndef SSSP_ADAPT_MIN_WORK
+#define SSSP_ADAPT_MIN_WORK 64
+#endif
+
+#ifndef SSSP_ADAPT_MAX_REWORK
+#define SSSP_ADAPT_MAX_REWORK 2
+#endif
+
+typedef struct {
+ uint32_t buckets;
+ uint32_t delta_initial;  // bucket width of the first bucket
+ uint32_t delta_final;
+ uint32_t delta_min;
+ uint32_t delta_max;
+ uint32_t delta_typical;  // geometric mean width weighted by vertex_ops,
+                          // rounded to a power of two
+ uint64_t relaxations;    // edges scanned
+ uint64_t vertex_ops;     // frontier entries processed, with repeats
+} sssp_stats_t;
+
+/*
+ * In-tree delta-stepping SSSP.
+ *
+ * Same inputs and output as the library sssp: CSR (IA, JA) with weights A,
+ * distances written to lens, UINT32_MAX for unreachable vertices. Buckets
+ * are processed in order; a bucket is relaxed until no vertex re-enters it,
+ * and vertices improved into later buckets wait in a shared pending list.
+ * The next bucket starts at the smallest pending distance, so empty ranges
+ * are skipped. Returns the number of buckets processed.
+ *
+ * delta == 0 selects auto mode: the first width comes from sssp_auto_delta
+ * and is adapted between buckets. stats may be NULL.
+ *
+ * ctl may be NULL. The kernel checks it between buckets and inside each
+ * relaxation round. When it stops early, lens holds tentative distances and
+ * err_bound is the settled bound L: every distance below L is exact, and
+ * every other vertex is at least L from the source (its lens entry is an
+ * upper bound).
+ */
+uint32_t delta_stepping(uint32_t * IA, uint32_t * JA, uint32_t * A,
+  uint32_t N, uint32_t * lens, uint32_t src, uint32_t delta,
+  sssp_stats_t * stats, anytime_t * ctl);
+
+/*
+ * Fixed delta for engines that cannot adapt (such as the library sssp): the
+ * typical width chosen by one auto-mode run from src.
+ */
+uint32_t sssp_calibrate_delta(uint32_t * IA, uint32_t * JA, uint32_t * A,
+  uint32_t N, uint32_t src);
+#endif
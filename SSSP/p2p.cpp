@@ -0,0 +1,356 @@
+/*
+ * Graph Kernel Collection
+ *
+ * Copyright 2020 Carnegie Mellon University.
+ *
+ * NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ * INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON 
+ * UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR IMPLIED, 
+ * AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF FITNESS FOR 
+ * PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS OBTAINED FROM USE OF 
+ * THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES NOT MAKE ANY WARRANTY OF ANY
+ * KIND WITH RESPECT TO FREEDOM FROM PATENT, TRADEMARK, OR COPYRIGHT 
+ * INFRINGEMENT.
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or
+ * contact permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public
+ * release and unlimited distribution.  Please see Copyright notice for 
+ * non-US Government use and distribution.
+ *
+ * This Software includes and/or makes use of the following Third-Party
+ * Software subject to its own license:
+ *
+ * 1. Matrix Market Loader code (https://math.nist.gov/MatrixMarket/mmio-c.html).
+ *
+ *      The code made publicly available at nist.gov is not marked with a 
+ *      copyright notice and is therefore believed pursuant to section 105 of 
+ *      the Copyright Act, to not be entitled to domestic copyright protection 
+ *      under U.S. law and is therefore in the public domain.  Accordingly, it 
+ *      is believed that no license is required for its use.
+ *
+ * This Software may include certain portions of copyrighted code that is 
+ * initially being released only in binary form for validation and evaluation
+ * purposes. It is expected that source code will be released as open source at
+ * a future date. 
+ *
+ * DM20-0375
+ */
+ 
+#include "p2p.h"
+#include "graph.h"
+#include "auto_delta.h"
+#include "bucket_fusion.h"
+#include "sssp_batch.h"
+#include <algorithm>
+#include <random>
+
+// Min-heap order on the keys.
+template <typename D>
+static inline bool entry_after(const p2p_entry_t<D> & a,
+  const p2p_entry_t<D> & b)
+{
+ return a.key > b.key;
+}
+
+// Vertex with the largest finite dist (smallest id on ties), or N if none
+// is above zero.
+template <typename D>
+static uint32_t farthest_vertex(const D * dist, uint32_t N){
+ uint32_t best_v = N;
+ D best = 0;
+#pragma omp parallel
+ {
+  uint32_t t_v = N;
+  D t_best = 0;
+#pragma omp for nowait
+  for (uint32_t v = 0; v < N; v++){
+   if (dist[v] != sssp_inf<D>() && dist[v] > t_best){
+    t_best = dist[v];
+    t_v = v;
+   }
+  }
+#pragma omp critical
+  if (t_best > best || (t_best == best && t_v < best_v)){
+   best = t_best;
+   best_v = t_v;
+  }
+ }
+ return best_v;
+}
+
+template <typename D>
+struct lm_store_ctx_t {
+ D * table;
+ uint32_t K;
+ uint32_t N;
+};
+
+// batch_sssp callback: distances of landmark src_idx into its column.
+template <typename D>
+static void store_landmark_column(uint32_t src_idx, uint32_t src,
+  const D * lens, void * ctx)
+{
+ lm_store_ctx_t<D> * out = (lm_store_ctx_t<D> *)ctx;
+#pragma omp parallel for
+ for (uint32_t v = 0; v < out->N; v++){
+  out->table[(uint64_t)v * out->K + src_idx] = lens[v];
+ }
+}
+
+// Pick landmarks farthest-first and fill lm_from. Returns how many were
+// kept (at most K).
+template <typename D, typename W>
+static uint32_t pick_landmarks(p2p_graph_t<D, W> * g, uint32_t K, D delta){
+ uint32_t N = g->N;
+ D * lens = (D *)malloc(N * sizeof(D));
+ D * mind = (D *)malloc(N * sizeof(D));
+ if (!lens || !mind){
+  fprintf(stderr, "ERROR: could not allocate landmark work arrays.\n");
+  exit(EXIT_FAILURE);
+ }
+ std::mt19937 gen(27491095);
+ std::uniform_int_distribution<uint32_t> pick(0, N-1);
+ uint32_t start = pick(gen);
+ fused_sssp(g->IA, g->JA, g->A, N, lens, start, delta);
+ uint32_t next = farthest_vertex(lens, N);
+ if (next == N) next = start;
+
+ uint32_t num = 0;
+ while (num < K){
+  uint32_t lm = next;
+  g->landmarks[num] = lm;
+  fused_sssp(g->IA, g->JA, g->A, N, lens, lm, delta);
+#pragma omp parallel for
+  for (uint32_t v = 0; v < N; v++){
+   g->lm_from[(uint64_t)v * K + num] = lens[v];
+   mind[v] = (num == 0) ? lens[v] : MIN(mind[v], lens[v]);
+  }
+  num++;
+  next = farthest_vertex(mind, N);
+  if (next == N) break;
+ }
+
+ // Pack the rows to the number actually kept.
+ if (num < K){
+  for (uint64_t v = 0; v < N; v++){
+   for (uint32_t i = 0; i < num; i++){
+    g->lm_from[v * num + i] = g->lm_from[v * K + i];
+   }
+  }
+ }
+ free(lens);
+ free(mind);
+ return num;
+}
+
+template <typename D, typename W>
+p2p_graph_t<D, W> * p2p_build(uint32_t * IA, uint32_t * JA, W * A,
+  uint32_t N, uint32_t * IAc, uint32_t * JAc, W * Ac,
+  uint32_t num_landmarks, D delta)
+{
+ p2p_graph_t<D, W> * g = (p2p_graph_t<D, W> *)calloc(1, sizeof(p2p_graph_t<D, W>));
+ if (!g){
+  fprintf(stderr, "ERROR: could not allocate point-to-point graph.\n");
+  exit(EXIT_FAILURE);
+ }
+ g->N = N;
+ g->IA = IA;
+ g->JA = JA;
+ g->A = A;
+ if (IAc == NULL){
+  if (!csr_to_csc_weighted(IA, JA, A, &g->IAc, &g->JAc, &g->Ac, N)){
+   fprintf(stderr, "ERROR: could not allocate weighted transpose.\n");
+   exit(EXIT_FAILURE);
+  }
+  g->own_csc = true;
+ } else {
+  g->IAc = IAc;
+  g->JAc = JAc;
+  g->Ac = Ac;
+ }
+
+ uint32_t K = MIN(num_landmarks, N);
+ if (K == 0) return g;
+ bool symmetric = (g->IAc == IA);
+ g->landmarks = (uint32_t *)malloc(K * sizeof(uint32_t));
+ g->lm_from = (D *)malloc((uint64_t)N * K * sizeof(D));
+ g->lm_to = symmetric ? g->lm_from : (D *)malloc((uint64_t)N * K * sizeof(D));
+ if (!g->landmarks || !g->lm_from || !g->lm_to){
+  fprintf(stderr, "ERROR: could not allocate landmark distances.\n");
+  exit(EXIT_FAILURE);
+ }
+ if (delta == 0) delta = (D)sssp_auto_delta(IA, JA, A, N);
+
+ K = pick_landmarks(g, K, delta);
+ g->num_landmarks = K;
+ if (!symmetric){
+  // All landmarks at once, backwards.
+  lm_store_ctx_t<D> ctx = {g->lm_to, K, N};
+  batch_sssp(g->IAc, g->JAc, g->Ac, N, delta, g->landmarks, K,
+    store_landmark_column<D>, &ctx);
+ }
+ return g;
+}
+
+template <typename D, typename W>
+void p2p_free(p2p_graph_t<D, W> * g){
+ if (g->own_csc){
+  free(g->IAc);
+  free(g->JAc);
+  free(g->Ac);
+ }
+ if (g->lm_to != g->lm_from) free(g->lm_to);
+ free(g->lm_from);
+ free(g->landmarks);
+ free(g);
+}
+
+template <typename D>
+p2p_scratch_t<D> * p2p_scratch_alloc(uint32_t N){
+ p2p_scratch_t<D> * sc = new p2p_scratch_t<D>();
+ sc->N = N;
+ sc->dist[0] = (D *)malloc(N * sizeof(D));
+ sc->dist[1] = (D *)malloc(N * sizeof(D));
+ if (!sc->dist[0] || !sc->dist[1]){
+  fprintf(stderr, "ERROR: could not allocate query scratch.\n");
+  exit(EXIT_FAILURE);
+ }
+ for (uint32_t v = 0; v < N; v++){
+  sc->dist[0][v] = sssp_inf<D>();
+  sc->dist[1][v] = sssp_inf<D>();
+ }
+ return sc;
+}
+
+template <typename D>
+void p2p_scratch_free(p2p_scratch_t<D> * sc){
+ free(sc->dist[0]);
+ free(sc->dist[1]);
+ delete sc;
+}
+
+// ALT lower bound on d(x, y) from the landmark rows of x and y: by the
+// triangle inequality d(L, y) - d(L, x) and d(x, L) - d(y, L), for every
+// landmark L both are finite for. 0 if none applies.
+template <typename D>
+static inline double alt_bound(const D * from_x, const D * to_x,
+  const D * from_y, const D * to_y, uint32_t K)
+{
+ const D inf = sssp_inf<D>();
+ double lb = 0.0;
+ for (uint32_t i = 0; i < K; i++){
+  if (from_x[i] != inf && from_y[i] != inf)
+   lb = MAX(lb, (double)from_y[i] - (double)from_x[i]);
+  if (to_x[i] != inf && to_y[i] != inf)
+   lb = MAX(lb, (double)to_x[i] - (double)to_y[i]);
+ }
+ return lb;
+}
+
+template <typename D, typename W>
+D p2p_distance(const p2p_graph_t<D, W> * g, p2p_scratch_t<D> * sc,
+  uint32_t s, uint32_t t, bool use_alt, p2p_stats_t * stats)
+{
+ const D inf = sssp_inf<D>();
+ if (stats){
+  stats->settled = 0;
+  stats->relaxations = 0;
+ }
+ if (s == t) return 0;
+
+ const uint32_t * I[2] = {g->IA, g->IAc};
+ const uint32_t * J[2] = {g->JA, g->JAc};
+ const W * V[2] = {g->A, g->Ac};
+ D * dist[2] = {sc->dist[0], sc->dist[1]};
+ std::vector<uint32_t> & touched = sc->touched;
+
+ uint32_t K = use_alt ? g->num_landmarks : 0;
+ const D * from_s = g->lm_from + (uint64_t)s * K;
+ const D * to_s = g->lm_to + (uint64_t)s * K;
+ const D * from_t = g->lm_from + (uint64_t)t * K;
+ const D * to_t = g->lm_to + (uint64_t)t * K;
+ // Forward potential; the backward search uses its negation.
+ auto potential = [&](uint32_t v) -> double {
+  if (K == 0) return 0.0;
+  const D * from_v = g->lm_from + (uint64_t)v * K;
+  const D * to_v = g->lm_to + (uint64_t)v * K;
+  return 0.5 * (alt_bound(from_v, to_v, from_t, to_t, K) -
+    alt_bound(from_s, to_s, from_v, to_v, K));
+ };
+
+ dist[0][s] = 0;
+ dist[1][t] = 0;
+ touched.push_back(s);
+ touched.push_back(t);
+ p2p_entry_t<D> first[2] = {
+  {potential(s), 0, s},
+  {-potential(t), 0, t}};
+ for (uint32_t side = 0; side < 2; side++){
+  sc->heap[side].push_back(first[side]);
+ }
+
+ D mu = inf;
+ uint64_t settled = 0, relaxations = 0;
+ while (!sc->heap[0].empty() && !sc->heap[1].empty()){
+  // Stale entries at the top only make this test conservative.
+  if (mu != inf &&
+      sc->heap[0].front().key + sc->heap[1].front().key >= (double)mu) break;
+  uint32_t side = (sc->heap[0].size() <= sc->heap[1].size()) ? 0 : 1;
+  std::vector<p2p_entry_t<D> > & heap = sc->heap[side];
+  std::pop_heap(heap.begin(), heap.end(), entry_after<D>);
+  p2p_entry_t<D> top = heap.back();
+  heap.pop_back();
+  uint32_t u = top.v;
+  if (top.dist != dist[side][u]) continue;
+  settled++;
+
+  D * mine = dist[side];
+  D * other = dist[1 - side];
+  for (uint32_t edx = I[side][u]; edx < I[side][u+1]; edx++){
+   uint32_t x = J[side][edx];
+   D nd = sssp_add(top.dist, V[side][edx]);
+   relaxations++;
+   if (nd >= mine[x]) continue;
+   if (mine[x] == inf && other[x] == inf) touched.push_back(x);
+   mine[x] = nd;
+   double pot = potential(x);
+   p2p_entry_t<D> entry = {(double)nd + (side == 0 ? pot : -pot), nd, x};
+   heap.push_back(entry);
+   std::push_heap(heap.begin(), heap.end(), entry_after<D>);
+   if (other[x] != inf) mu = MIN(mu, sssp_add(nd, other[x]));
+  }
+ }
+
+ // Sparse reset for the next query.
+ for (size_t idx = 0; idx < touched.size(); idx++){
+  dist[0][touched[idx]] = inf;
+  dist[1][touched[idx]] = inf;
+ }
+ touched.clear();
+ sc->heap[0].clear();
+ sc->heap[1].clear();
+ if (stats){
+  stats->settled = settled;
+  stats->relaxations = relaxations;
+ }
+ return mu;
+}
+
+#define P2P_INST(D, W) \
+ template p2p_graph_t<D, W> * p2p_build<D, W>(uint32_t *, uint32_t *, W *, \
+   uint32_t, uint32_t *, uint32_t *, W *, uint32_t, D); \
+ template void p2p_free<D, W>(p2p_graph_t<D, W> *); \
+ template D p2p_distance<D, W>(const p2p_graph_t<D, W> *, p2p_scratch_t<D> *, \
+   uint32_t, uint32_t, bool, p2p_stats_t *);
+SSSP_INSTANTIATE(P2P_INST)
+
+template p2p_scratch_t<uint32_t> * p2p_scratch_alloc<uint32_t>(uint32_t);
+template p2p_scratch_t<uint64_t> * p2p_scratch_alloc<uint64_t>(uint32_t);
+template p2p_scratch_t<float> * p2p_scratch_alloc<float>(uint32_t);
+template p2p_scratch_t<double> * p2p_scratch_alloc<double>(uint32_t);
+template void p2p_scratch_free<uint32_t>(p2p_scratch_t<uint32_t> *);
+template void p2p_scratch_free<uint64_t>(p2p_scratch_t<uint64_t> *);
+template void p2p_scratch_free<float>(p2p_scratch_t<float> *);
+template void p2p_scratch_free<double>(p2p_scratch_t<double> *);
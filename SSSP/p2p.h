@@ -0,0 +1,159 @@
+/*
+ * Graph Kernel Collection
+ *
+ * Copyright 2020 Carnegie Mellon University.
+ *
+ * NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ * INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON 
+ * UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR IMPLIED, 
+ * AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF FITNESS FOR 
+ * PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS OBTAINED FROM USE OF 
+ * THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES NOT MAKE ANY WARRANTY OF ANY
+ * KIND WITH RESPECT TO FREEDOM FROM PATENT, TRADEMARK, OR COPYRIGHT 
+ * INFRINGEMENT.
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or
+ * contact permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public
+ * release and unlimited distribution.  Please see Copyright notice for 
+ * non-US Government use and distribution.
+ *
+ * This Software includes and/or makes use of the following Third-Party
+ * Software subject to its own license:
+ *
+ * 1. Matrix Market Loader code (https://math.nist.gov/MatrixMarket/mmio-c.html).
+ *
+ *      The code made publicly available at nist.gov is not marked with a 
+ *      copyright notice and is therefore believed pursuant to section 105 of 
+ *      the Copyright Act, to not be entitled to domestic copyright protection 
+ *      under U.S. law and is therefore in the public domain.  Accordingly, it 
+ *      is believed that no license is required for its use.
+ *
+ * This Software may include certain portions of copyrighted code that is 
+ * initially being released only in binary form for validation and evaluation
+ * purposes. It is expected that source code will be released as open source at
+ * a future date. 
+ *
+ * DM20-0375
+ */
+ 
+#ifndef P2P_H
+#define P2P_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <vector>
+#include <omp.h>
+#include "utils.h"
+#include "sssp_types.h"
+
+// Default number of ALT landmarks.
+#ifndef P2P_LANDMARKS
+#define P2P_LANDMARKS 16
+#endif
+
+/*
+ * Graph for point-to-point queries: the weighted CSR, its transpose for the
+ * backward search, and optional ALT landmark distances.
+ *
+ * Landmark distances are vertex-major, num_landmarks consecutive entries
+ * per vertex, so the lower bound at a vertex is computed from one
+ * contiguous row: lm_from[v*K + i] = d(landmark i, v) and
+ * lm_to[v*K + i] = d(v, landmark i). For a symmetric graph (the CSR passed
+ * as its own transpose) lm_to aliases lm_from.
+ */
+template <typename D, typename W>
+struct p2p_graph_t {
+ uint32_t N;
+ uint32_t * IA;           // forward CSR (not owned)
+ uint32_t * JA;
+ W * A;
+ uint32_t * IAc;          // transpose, owned if built by p2p_build
+ uint32_t * JAc;
+ W * Ac;
+ bool own_csc;
+ uint32_t num_landmarks;
+ uint32_t * landmarks;
+ D * lm_from;
+ D * lm_to;
+};
+
+/*
+ * Set up point-to-point queries over the CSR (IA, JA, A).
+ *
+ * Pass the transpose as IAc/JAc/Ac (the CSR itself for a symmetric graph),
+ * or NULL to have it built with csr_to_csc_weighted. With num_landmarks > 0
+ * landmarks are picked farthest-first: each one is the vertex farthest from
+ * the landmarks already chosen, starting from the vertex farthest from a
+ * random one. Their distances from (fused_sssp over the CSR) and to
+ * (batch_sssp over the transpose) every vertex are stored for the ALT
+ * bounds, 2 * num_landmarks * N distances in all (half that when
+ * symmetric). Fewer landmarks are kept if every vertex reachable from them
+ * is already one. delta is the bucket width for those runs, 0 for
+ * sssp_auto_delta.
+ */
+template <typename D, typename W>
+p2p_graph_t<D, W> * p2p_build(uint32_t * IA, uint32_t * JA, W * A,
+  uint32_t N, uint32_t * IAc, uint32_t * JAc, W * Ac,
+  uint32_t num_landmarks, D delta);
+
+template <typename D, typename W>
+void p2p_free(p2p_graph_t<D, W> * g);
+
+// Entry of a search heap: the key it is ordered by, the distance it was
+// pushed with (stale once the vertex improves), and the vertex.
+template <typename D>
+struct p2p_entry_t {
+ double key;
+ D dist;
+ uint32_t v;
+};
+
+/*
+ * Per-thread query scratch. Both distance arrays are allocated once and
+ * kept at sssp_inf<D>() between queries: a query records every vertex it
+ * reaches in touched and only resets those, so its cost depends on the
+ * size of the search, not on N.
+ */
+template <typename D>
+struct p2p_scratch_t {
+ uint32_t N;
+ D * dist[2];             // forward from s, backward to t
+ std::vector<uint32_t> touched;
+ std::vector<p2p_entry_t<D> > heap[2];
+};
+
+template <typename D>
+p2p_scratch_t<D> * p2p_scratch_alloc(uint32_t N);
+
+template <typename D>
+void p2p_scratch_free(p2p_scratch_t<D> * scratch);
+
+typedef struct {
+ uint64_t settled;        // vertices scanned, both directions
+ uint64_t relaxations;
+} p2p_stats_t;
+
+/*
+ * Distance from s to t, or sssp_inf<D>() if t is unreachable.
+ *
+ * Bidirectional Dijkstra: a forward search from s over the CSR and a
+ * backward one from t over the transpose, always advancing the one with
+ * the smaller heap. Every edge that reaches a vertex seen by the other
+ * side updates the best s-t distance mu, and the search stops once the two
+ * heap minima add up to at least mu. With use_alt and landmarks in g, both
+ * searches are A* searches with the average of the ALT potentials
+ * (pf(v) = (lb(v, t) - lb(s, v)) / 2 forward, -pf(v) backward), which
+ * keeps them consistent with each other so the same stopping rule holds.
+ * Heap keys are doubles, so distances above 2^53 stop conservatively but
+ * are not exact in the stopping test.
+ *
+ * The scratch must not be shared between concurrent queries. stats may be
+ * NULL.
+ */
+template <typename D, typename W>
+D p2p_distance(const p2p_graph_t<D, W> * g, p2p_scratch_t<D> * scratch,
+  uint32_t s, uint32_t t, bool use_alt, p2p_stats_t * stats);
+#endif
@@ -45,6 +45,8 @@
 #include "utils.h"
 #include "graph.h"
 #include "sssp_checker.h"
+#include "auto_delta.h"
+#include <vector>
 #include <omp.h>
 
 #ifndef ITERS
@@ -58,11 +60,129 @@
 
 typedef uint32_t VTYPE;
 
+// Weight and distance types. -DWTYPE_FLOAT reads 32-bit float weights (as
+// written by matrix_conversion's converter_float) and defaults the distances
+// to float; -DDTYPE=<uint32_t|uint64_t|float|double> picks the distance
+// type. Anything other than uint32_t for both runs only on the templated
+// in-tree engines (FUSED_SSSP, BATCH_SSSP or P2P_QUERIES).
+#ifdef WTYPE_FLOAT
+typedef float WTYPE;
+#ifndef DTYPE
+#define DTYPE float
+#endif
+#else
+typedef uint32_t WTYPE;
+#endif
+#ifdef DTYPE
+#define TYPED_SSSP
+#else
+#define DTYPE uint32_t
+#endif
+#if defined(TYPED_SSSP) && !defined(FUSED_SSSP) && !defined(BATCH_SSSP) \
+  && !defined(P2P_QUERIES)
+#error "WTYPE_FLOAT and DTYPE need FUSED_SSSP, BATCH_SSSP or P2P_QUERIES"
+#endif
+
+// -DCH_QUERIES answers the point-to-point queries below on a contraction
+// hierarchy instead. It is read from the files of an optional <CH prefix>
+// argument if they exist, and otherwise built (and written there).
+#ifdef CH_QUERIES
+#ifdef TYPED_SSSP
+#error "CH_QUERIES uses uint32_t weights and distances"
+#endif
+#define P2P_QUERIES
+#include "ch.h"
+#endif
+
 extern uint32_t sssp( uint32_t * IA, uint32_t * JA, uint32_t *A,
   uint32_t N, uint32_t * lens, uint32_t src, uint32_t delta);
 
+// -DDELTA_STEPPING runs the in-tree engine instead of the library sssp.
+// -DANYTIME_MS=<ms> additionally stops it at a deadline and reports the
+// settled bound of the returned distances.
+#include "delta_stepping.h"
+#if defined(ANYTIME_MS) && !defined(DELTA_STEPPING)
+#error "ANYTIME_MS requires DELTA_STEPPING"
+#endif
+
+// -DFUSED_SSSP swaps the library sssp for the in-tree engine with
+// thread-local buckets and bucket fusion.
+#ifdef FUSED_SSSP
+#if defined(DELTA_STEPPING)
+#error "FUSED_SSSP and DELTA_STEPPING are exclusive"
+#endif
+#include "bucket_fusion.h"
+#define SSSP_KERNEL fused_sssp
+#else
+#define SSSP_KERNEL sssp
+#endif
+
+// -DBATCH_SSSP solves all sources in the sources file SSSP_LANES at a time
+// with batch_sssp.
+#ifdef BATCH_SSSP
+#if defined(DELTA_STEPPING) || defined(FUSED_SSSP)
+#error "BATCH_SSSP runs its own engine"
+#endif
+#include "sssp_batch.h"
+
+typedef struct {
+ uint32_t * IA;
+ uint32_t * JA;
+ WTYPE * A;
+ uint32_t N;
+ uint32_t num_failed;
+ double check_time;
+} sssp_batch_ctx_t;
+#endif
+
+// The templated in-tree engines are checked with check_dists_typed, which
+// also reports distances that overflow DTYPE; the others with the library's
+// check_dists.
+template <typename D, typename W>
+inline bool validate(uint32_t * IA, uint32_t * JA, W * A, uint32_t N,
+  uint32_t src, const D * lens)
+{
+#if defined(FUSED_SSSP) || defined(BATCH_SSSP) || defined(P2P_QUERIES)
+ return check_dists_typed(IA, JA, A, N, src, lens);
+#else
+ return check_dists(IA, JA, A, N, src, (uint32_t *)lens);
+#endif
+}
+
+// -DP2P_QUERIES answers point-to-point distance queries instead: consecutive
+// entries of the sources file (e.g. one "s t" pair per line) form the
+// pairs, or ITERS random pairs without one. Queries run in parallel, each
+// thread with its own p2p scratch; ALT uses P2P_LANDMARKS landmarks
+// (-DP2P_LANDMARKS=0 for plain bidirectional Dijkstra).
+#ifdef P2P_QUERIES
+#if defined(DELTA_STEPPING) || defined(FUSED_SSSP) || defined(BATCH_SSSP)
+#error "P2P_QUERIES runs its own engine"
+#endif
+#include "p2p.h"
+#define SRCS_PER_ROUND 2
+#else
+#define SRCS_PER_ROUND 1
+#endif
+
+#ifdef BATCH_SSSP
+// Per-source callback for batch_sssp: validates under VALIDATE.
+void batch_source_done(uint32_t src_idx, uint32_t src, const DTYPE * lens,
+  void * ctx)
+{
+#ifdef VALIDATE
+ sssp_batch_ctx_t * chk = (sssp_batch_ctx_t *)ctx;
+ double check_st = omp_get_wtime();
+ if (!validate(chk->IA, chk->JA, chk->A, chk->N, src, lens)){
+  printf("Failed source %u (%u)\n", src_idx, src);
+  chk->num_failed++;
+ }
+ chk->check_time += omp_get_wtime() - check_st;
+#endif
+}
+#endif
+
 void usage(char * pname){
- fprintf(stderr, "USAGE: %s <IA fname> <JA fname> <delta> [<sources> <A fname>]\n", pname);
+ fprintf(stderr, "USAGE: %s <IA fname> <JA fname> <delta|auto> [<sources> <A fname> [<CH prefix>]]\n", pname);
  exit(EXIT_FAILURE);
 }
 
@@ -70,9 +190,9 @@ void usage(char * pname){
 int main(int argc, char** argv){
  uint32_t * IA;
  uint32_t * JA;
- uint32_t * A;
+ WTYPE * A;
 
- uint32_t * srcs;
+ std::vector<uint32_t> srcs;
 
  uint32_t N;
  uint32_t M;
@@ -87,9 +207,7 @@ int main(int argc, char** argv){
 
  IA = (uint32_t *)malloc((N+1)*sizeof(uint32_t));
  JA = (uint32_t *)malloc(M*sizeof(uint32_t));
- A = (uint32_t *)malloc(M*sizeof(uint32_t));
-
- srcs = (uint32_t *)malloc(64*sizeof(uint32_t));
+ A = (WTYPE *)malloc(M*sizeof(WTYPE));
 
  if (!IA || !JA || !A ) {
   fprintf(stderr, "COULD NOT ALLOCATE MEMORY\n");
@@ -99,11 +217,12 @@ int main(int argc, char** argv){
  read_binary_buffers(argv[1], IA);
  read_binary_buffers(argv[2], JA);
 
- uint32_t delta = atoi(argv[3]);
- printf("DELTA = %u\n", delta); fflush(NULL);
+ // "auto" (or 0) picks delta from the graph once the weights are read. The
+ // in-tree engine adapts it between buckets; the library gets the typical
+ // width of one adaptive run from the first source.
+ DTYPE delta = (DTYPE)atof(argv[3]);
 
  FILE *source_file;
- uint32_t i = 0;
  if (argc >= 5){
   printf("Reading Source Files\n");
   if ((source_file = fopen(argv[4], "r")) != NULL){
@@ -115,12 +234,17 @@ int main(int argc, char** argv){
     }
     else
     {
-     srcs[i] = tmp_src;
-     i += 1;
+     srcs.push_back(tmp_src);
     }
    }
    fclose(source_file);
-   printf("Sucessfully read %u sources.\n", i);
+   printf("Sucessfully read %lu sources.\n", srcs.size());
+  }
+ }
+ if (srcs.size() == 0){
+  printf("No sources read, using %u random sources.\n", ITERS * SRCS_PER_ROUND);
+  for (uint32_t sdx = 0; sdx < ITERS * SRCS_PER_ROUND; sdx++){
+   srcs.push_back((uint32_t)rand() % N);
   }
  }
 
@@ -130,12 +254,27 @@ int main(int argc, char** argv){
   }
  }
  else{
-  read_binary_buffers(argv[5], A);
+  static_assert(sizeof(WTYPE) == sizeof(uint32_t), "weight files hold 32-bit entries");
+  read_binary_buffers(argv[5], (uint32_t *)A);
+ }
+ if (delta == 0){
+  double auto_st = omp_get_wtime();
+  WTYPE auto_delta = sssp_auto_delta(IA, JA, A, N);
+  printf("DELTA = auto (initial %.10g, picked in %f sec)\n",
+    (double)auto_delta, omp_get_wtime() - auto_st);
+#if defined(BATCH_SSSP) || defined(TYPED_SSSP) || defined(P2P_QUERIES)
+  delta = auto_delta;
+#elif !defined(DELTA_STEPPING)
+  auto_st = omp_get_wtime();
+  delta = sssp_calibrate_delta(IA, JA, A, N, srcs[0]);
+  printf("DELTA = %u (calibrated in %f sec)\n", delta,
+    omp_get_wtime() - auto_st);
+#endif
+ } else {
+  printf("DELTA = %.10g\n", (double)delta);
  }
  printf("Number of vertices: %u\n", N); fflush(NULL);
 
- uint32_t * lens;
-
  double st, nd;
  char * trunc_fname = truncate_fname(argv[1]);
  double tot_time = 0.0;
@@ -143,19 +282,158 @@ int main(int argc, char** argv){
  uint32_t num_threads = omp_get_max_threads();
 
  printf("Start SSSP\n");
+#if defined(P2P_QUERIES)
+ uint32_t num_queries = srcs.size() / 2;
+ st = omp_get_wtime();
+#ifdef CH_QUERIES
+ const char * ch_prefix = (argc >= 7) ? argv[6] : NULL;
+ // A hierarchy that does not fit the graph is rebuilt and written over.
+ ch_graph_t * ch = (ch_prefix != NULL) ? ch_load(ch_prefix, N) : NULL;
+ if (ch != NULL){
+  nd = omp_get_wtime();
+  printf("Read hierarchy %s in %f sec\n", ch_prefix, nd - st);
+ } else {
+  ch = ch_build(IA, JA, A, N);
+  nd = omp_get_wtime();
+  printf("Contraction: %f sec\n", nd - st);
+  if (ch_prefix != NULL && !ch_save(ch, ch_prefix))
+   fprintf(stderr, "WARNING: could not write hierarchy to %s\n", ch_prefix);
+ }
+ printf("Hierarchy edges: %lu (graph has %u)\n", ch_num_edges(ch), M);
+#else
+ p2p_graph_t<DTYPE, WTYPE> * pg = p2p_build(IA, JA, A, N,
+   (uint32_t *)NULL, (uint32_t *)NULL, (WTYPE *)NULL, P2P_LANDMARKS, delta);
+ nd = omp_get_wtime();
+ printf("Preprocessing (transpose, %u landmarks): %f sec\n",
+   pg->num_landmarks, nd - st);
+#endif
+
+ DTYPE * q_dist = (DTYPE *)malloc(MAX(num_queries, 1) * sizeof(DTYPE));
+ double * q_time = (double *)malloc(MAX(num_queries, 1) * sizeof(double));
+ p2p_stats_t * q_stats = (p2p_stats_t *)malloc(MAX(num_queries, 1) * sizeof(p2p_stats_t));
+ if (!q_dist || !q_time || !q_stats){
+  fprintf(stderr, "COULD NOT ALLOCATE MEMORY\n");
+  exit(EXIT_FAILURE);
+ }
+ st = omp_get_wtime();
+#pragma omp parallel
+ {
+  p2p_scratch_t<DTYPE> * scratch = p2p_scratch_alloc<DTYPE>(N);
+#pragma omp for schedule(dynamic, 1)
+  for (uint32_t q = 0; q < num_queries; q++){
+   double q_st = omp_get_wtime();
+#ifdef CH_QUERIES
+   q_dist[q] = ch_distance(ch, scratch, srcs[2*q], srcs[2*q+1], &q_stats[q]);
+#else
+   q_dist[q] = p2p_distance(pg, scratch, srcs[2*q], srcs[2*q+1],
+     pg->num_landmarks > 0, &q_stats[q]);
+#endif
+   q_time[q] = omp_get_wtime() - q_st;
+  }
+  p2p_scratch_free(scratch);
+ }
+ nd = omp_get_wtime();
+ tot_time = nd - st;
+
+ printf("query, name, s, t, distance, settled, time(s)\n");
+ double lat_time = 0.0;
+#ifdef VALIDATE
+ uint32_t num_failed = 0;
+#ifdef CH_QUERIES
+ uint32_t * lens = (uint32_t *)malloc(N * sizeof(uint32_t));
+#endif
+#endif
+ for (uint32_t q = 0; q < num_queries; q++){
+  printf("Query %u, %s, %u, %u, %.10g, %lu, %f sec\n", q, trunc_fname,
+    srcs[2*q], srcs[2*q+1], (double)q_dist[q], q_stats[q].settled, q_time[q]);
+  lat_time += q_time[q];
+#if defined(VALIDATE) && defined(CH_QUERIES)
+  // Check the whole hierarchy from s, then the query against it.
+  ch_sssp(ch, srcs[2*q], lens);
+  if (!check_dists(IA, JA, A, N, srcs[2*q], lens) ||
+      lens[srcs[2*q+1]] != q_dist[q])
+   num_failed++;
+#elif defined(VALIDATE)
+  if (!check_p2p_typed(IA, JA, A, N, srcs[2*q], srcs[2*q+1], q_dist[q]))
+   num_failed++;
+#endif
+ }
+#ifdef VALIDATE
+ if (num_failed == 0)
+  printf("Passed\n");
+ else
+  printf("Failed (%u of %u queries)\n", num_failed, num_queries);
+#endif
+ printf("Average query time: %f seconds, %f queries/sec on %u threads.\n\n",
+   lat_time / MAX(num_queries, 1), num_queries / tot_time, num_threads);
+ free(q_dist);
+ free(q_time);
+ free(q_stats);
+#ifdef CH_QUERIES
+#ifdef VALIDATE
+ free(lens);
+#endif
+ ch_free(ch);
+#else
+ p2p_free(pg);
+#endif
+#elif defined(BATCH_SSSP)
+ uint32_t num_srcs = srcs.size();
+ sssp_batch_ctx_t ctx = {IA, JA, A, N, 0, 0.0};
+ st = omp_get_wtime();
+ uint32_t rounds = batch_sssp(IA, JA, A, N, delta, srcs.data(), num_srcs,
+   batch_source_done, &ctx);
+ nd = omp_get_wtime();
+ tot_time = nd - st - ctx.check_time;
+ printf("name, sources, lanes, rounds, time(s), time per source(s), threads\n");
+ printf("%s, %u, %u, %u, %f, %f, %u\n", trunc_fname, num_srcs, SSSP_LANES,
+   rounds, tot_time, tot_time / num_srcs, num_threads);
+#ifdef VALIDATE
+ if (ctx.num_failed == 0)
+  printf("Passed\n");
+ else
+  printf("Failed (%u of %u sources)\n", ctx.num_failed, num_srcs);
+#endif
+#else
  printf("round, name, sourceID, time(s), threads\n");
 
- for (uint32_t iter=0; iter < ITERS; iter++){
+ uint32_t num_rounds = MIN((uint32_t)ITERS, (uint32_t)srcs.size());
+ for (uint32_t iter=0; iter < num_rounds; iter++){
 
   st = omp_get_wtime();
-  lens = (uint32_t *)calloc(N, sizeof(uint32_t));
-  uint32_t tmp = sssp(IA, JA, A, N, lens, srcs[iter], delta);
+  DTYPE * lens = (DTYPE *)calloc(N, sizeof(DTYPE));
+#ifdef DELTA_STEPPING
+  anytime_t * ctl = NULL;
+#ifdef ANYTIME_MS
+  anytime_t ctl_blk;
+  anytime_init(&ctl_blk, ANYTIME_MS / 1000.0, NULL, NULL);
+  ctl = &ctl_blk;
+#endif
+  sssp_stats_t stats;
+  delta_stepping(IA, JA, A, N, lens, srcs[iter], delta, &stats, ctl);
+#else
+  uint32_t tmp = SSSP_KERNEL(IA, JA, A, N, lens, srcs[iter], delta);
+#endif
   nd = omp_get_wtime();
 
   printf("Round %u, %s, %u, %f sec, %u\n", iter, trunc_fname, srcs[iter], nd-st, num_threads);
+#ifdef DELTA_STEPPING
+  printf("Buckets %u, delta %u -> %u (min %u, max %u, typical %u), %lu relaxations\n",
+    stats.buckets, stats.delta_initial, stats.delta_final, stats.delta_min,
+    stats.delta_max, stats.delta_typical, stats.relaxations);
+#endif
+#ifdef FUSED_SSSP
+  printf("Global rounds %u\n", tmp);
+#endif
+#ifdef ANYTIME_MS
+  if (ctl->completed)
+   printf("Anytime: completed\n");
+  else
+   printf("Anytime: stopped, distances below %.0f are final\n", ctl->err_bound);
+#endif
 
 #ifdef VALIDATE
-  if ( check_dists(IA, JA, A, N, srcs[iter], lens) )
+  if ( validate(IA, JA, A, N, srcs[iter], lens) )
    printf("Passed\n");
   else
    printf("Failed\n");
@@ -164,12 +442,12 @@ int main(int argc, char** argv){
   tot_time += nd - st;
 
  }
- printf("Average time: %f seconds.\n\n", tot_time/ITERS);
+ printf("Average time: %f seconds.\n\n", tot_time/num_rounds);
+#endif
 
  free(trunc_fname);
  free(IA);
  free(JA);
  free(A);
- free(srcs);
  return 0;
 }
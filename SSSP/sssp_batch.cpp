@@ -0,0 +1,243 @@
+/*
+ * Graph Kernel Collection
+ *
+ * Copyright 2020 Carnegie Mellon University.
+ *
+ * NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ * INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON 
+ * UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR IMPLIED, 
+ * AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF FITNESS FOR 
+ * PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS OBTAINED FROM USE OF 
+ * THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES NOT MAKE ANY WARRANTY OF ANY
+ * KIND WITH RESPECT TO FREEDOM FROM PATENT, TRADEMARK, OR COPYRIGHT 
+ * INFRINGEMENT.
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or
+ * contact permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public
+ * release and unlimited distribution.  Please see Copyright notice for 
+ * non-US Government use and distribution.
+ *
+ * This Software includes and/or makes use of the following Third-Party
+ * Software subject to its own license:
+ *
+ * 1. Matrix Market Loader code (https://math.nist.gov/MatrixMarket/mmio-c.html).
+ *
+ *      The code made publicly available at nist.gov is not marked with a 
+ *      copyright notice and is therefore believed pursuant to section 105 of 
+ *      the Copyright Act, to not be entitled to domestic copyright protection 
+ *      under U.S. law and is therefore in the public domain.  Accordingly, it 
+ *      is believed that no license is required for its use.
+ *
+ * This Software may include certain portions of copyrighted code that is 
+ * initially being released only in binary form for validation and evaluation
+ * purposes. It is expected that source code will be released as open source at
+ * a future date. 
+ *
+ * DM20-0375
+ */
+ 
+#include "sssp_batch.h"
+#include <string.h>
+#include <vector>
+
+#define NO_BUCKET UINT64_MAX
+
+#if SSSP_LANES > 32
+#error "SSSP_LANES must fit in a 32-bit lane mask"
+#endif
+
+typedef std::vector<std::vector<uint32_t> > bucket_array_t;
+
+// Candidate distances of every lane through an edge of weight w, and the
+// mask of lanes they improve. Integer sums saturate by detecting
+// wrap-around (all ones is sssp_inf).
+template <typename D, typename W>
+static inline typename std::enable_if<std::is_integral<D>::value, uint32_t>::type
+relax_lanes(const D * du, W w, const D * dv, D * cand)
+{
+ uint32_t mask = 0;
+#pragma omp simd aligned(du, dv, cand:64) reduction(|:mask)
+ for (uint32_t k = 0; k < SSSP_LANES; k++){
+  D c = du[k] + (D)w;
+  c |= -(D)(c < du[k]);
+  cand[k] = c;
+  mask |= (uint32_t)(c < dv[k]) << k;
+ }
+ return mask;
+}
+
+// Floating point sums round to +infinity on overflow by themselves.
+template <typename D, typename W>
+static inline typename std::enable_if<std::is_floating_point<D>::value, uint32_t>::type
+relax_lanes(const D * du, W w, const D * dv, D * cand)
+{
+ uint32_t mask = 0;
+#pragma omp simd aligned(du, dv, cand:64) reduction(|:mask)
+ for (uint32_t k = 0; k < SSSP_LANES; k++){
+  D c = du[k] + (D)w;
+  cand[k] = c;
+  mask |= (uint32_t)(c < dv[k]) << k;
+ }
+ return mask;
+}
+
+template <typename D>
+static inline bool has_lane_in(const D * row, uint64_t b, D delta){
+ uint32_t hit = 0;
+#pragma omp simd reduction(|:hit)
+ for (uint32_t k = 0; k < SSSP_LANES; k++){
+  hit |= sssp_bucket_t<D>::in(row[k], b, delta);
+ }
+ return hit != 0;
+}
+
+// Lowest non-empty bucket at or above b over all threads, or NO_BUCKET.
+static uint64_t lowest_bucket(std::vector<bucket_array_t> & bins, uint64_t b){
+ uint64_t lowest = NO_BUCKET;
+ for (size_t t = 0; t < bins.size(); t++){
+  for (uint64_t i = b; i < MIN((size_t)lowest, bins[t].size()); i++){
+   if (!bins[t][i].empty()){
+    lowest = i;
+    break;
+   }
+  }
+ }
+ return lowest;
+}
+
+template <typename D, typename W>
+uint32_t batch_sssp(uint32_t * IA, uint32_t * JA, W * A, uint32_t N,
+  D delta, const uint32_t * srcs, uint32_t num_srcs,
+  sssp_done_cb_t<D> cb, void * cb_ctx)
+{
+ if (N == 0 || num_srcs == 0) return 0;
+ uint64_t bytes = (uint64_t)N * SSSP_LANES * sizeof(D);
+ D * dist = (D *)aligned_alloc(64, bytes);
+ uint32_t * frontier = (uint32_t *)malloc(N * sizeof(uint32_t));
+ uint32_t * next = (uint32_t *)malloc(N * sizeof(uint32_t));
+ uint8_t * queued = (uint8_t *)calloc(N, sizeof(uint8_t));
+ D * out = (D *)malloc(N * sizeof(D));
+ if (!dist || !frontier || !next || !queued || !out){
+  fprintf(stderr, "ERROR: could not allocate batched SSSP arrays.\n");
+  exit(EXIT_FAILURE);
+ }
+ std::vector<bucket_array_t> bins(omp_get_max_threads());
+
+ uint32_t rounds = 0;
+ uint32_t next_src = 0;
+ while (next_src < num_srcs){
+  // Fill the lanes with the next valid sources.
+  uint32_t lane_idx[SSSP_LANES];
+  uint32_t num_lanes = 0;
+  for (; next_src < num_srcs && num_lanes < SSSP_LANES; next_src++){
+   if (srcs[next_src] < N) lane_idx[num_lanes++] = next_src;
+  }
+  if (num_lanes == 0) break;
+#pragma omp parallel for
+  for (uint64_t idx = 0; idx < (uint64_t)N * SSSP_LANES; idx++){
+   dist[idx] = sssp_inf<D>();
+  }
+  bins[0].resize(1);
+  for (uint32_t k = 0; k < num_lanes; k++){
+   uint32_t s = srcs[lane_idx[k]];
+   dist[(uint64_t)s * SSSP_LANES + k] = 0;
+   bins[0][0].push_back(s);
+  }
+
+  uint64_t b = 0;
+  while ((b = lowest_bucket(bins, b)) != NO_BUCKET){
+   // Collect bucket b once per vertex, dropping entries whose lanes have
+   // all moved to earlier buckets since they were filed.
+   uint32_t f_size = 0;
+#pragma omp parallel
+   {
+    bucket_array_t & local = bins[omp_get_thread_num()];
+    if (b < local.size()){
+     for (size_t idx = 0; idx < local[b].size(); idx++){
+      uint32_t u = local[b][idx];
+      if (queued[u] == 0 &&
+          has_lane_in(dist + (uint64_t)u * SSSP_LANES, b, delta) &&
+          __sync_bool_compare_and_swap(&queued[u], 0, 1)){
+       frontier[__sync_fetch_and_add(&f_size, 1)] = u;
+      }
+     }
+     std::vector<uint32_t>().swap(local[b]);
+    }
+   }
+
+   // Relax the bucket until no lane re-enters it.
+   while (f_size > 0){
+    rounds++;
+    uint32_t n_size = 0;
+#pragma omp parallel
+    {
+     bucket_array_t & local = bins[omp_get_thread_num()];
+     D du[SSSP_LANES] __attribute__((aligned(64)));
+     D cand[SSSP_LANES] __attribute__((aligned(64)));
+#pragma omp for schedule(dynamic, 64)
+     for (uint32_t fdx = 0; fdx < f_size; fdx++){
+      uint32_t u = frontier[fdx];
+      queued[u] = 0;
+      __sync_synchronize();
+      memcpy(du, dist + (uint64_t)u * SSSP_LANES, sizeof(du));
+      for (uint32_t edx = IA[u]; edx < IA[u+1]; edx++){
+       uint32_t v = JA[edx];
+       D * dv = dist + (uint64_t)v * SSSP_LANES;
+       uint32_t mask = relax_lanes(du, A[edx], dv, cand);
+       // Lanes that improve within bucket b are relaxed again in the next
+       // round; the others wait in the bucket of their new distance.
+       bool again = false;
+       uint64_t last = NO_BUCKET;
+       while (mask){
+        uint32_t k = __builtin_ctz(mask);
+        mask &= mask - 1;
+        if (!sssp_lower(&dv[k], cand[k])) continue;
+        if (sssp_bucket_t<D>::upto(cand[k], b, delta)){
+         again = true;
+         continue;
+        }
+        uint64_t nb = sssp_bucket_t<D>::of(cand[k], delta);
+        if (nb == last) continue;
+        if (nb >= local.size()) local.resize(nb + 1);
+        local[nb].push_back(v);
+        last = nb;
+       }
+       if (again && queued[v] == 0 &&
+           __sync_bool_compare_and_swap(&queued[v], 0, 1)){
+        next[__sync_fetch_and_add(&n_size, 1)] = v;
+       }
+      }
+     }
+    }
+    uint32_t * tmp = frontier;
+    frontier = next;
+    next = tmp;
+    f_size = n_size;
+   }
+  }
+
+  if (cb){
+   for (uint32_t k = 0; k < num_lanes; k++){
+#pragma omp parallel for
+    for (uint32_t v = 0; v < N; v++){
+     out[v] = dist[(uint64_t)v * SSSP_LANES + k];
+    }
+    cb(lane_idx[k], srcs[lane_idx[k]], out, cb_ctx);
+   }
+  }
+ }
+
+ free(dist);
+ free(frontier);
+ free(next);
+ free(queued);
+ free(out);
+ return rounds;
+}
+
+#define BATCH_SSSP_INST(D, W) \
+ template uint32_t batch_sssp(uint32_t *, uint32_t *, W *, uint32_t, D, \
+   const uint32_t *, uint32_t, sssp_done_cb_t<D>, void *);
+SSSP_INSTANTIATE(BATCH_SSSP_INST)
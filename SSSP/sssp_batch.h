@@ -0,0 +1,90 @@
+/*
+ * Graph Kernel Collection
+ *
+ * Copyright 2020 Carnegie Mellon University.
+ *
+ * NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ * INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON 
+ * UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR IMPLIED, 
+ * AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF FITNESS FOR 
+ * PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS OBTAINED FROM USE OF 
+ * THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES NOT MAKE ANY WARRANTY OF ANY
+ * KIND WITH RESPECT TO FREEDOM FROM PATENT, TRADEMARK, OR COPYRIGHT 
+ * INFRINGEMENT.
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or
+ * contact permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public
+ * release and unlimited distribution.  Please see Copyright notice for 
+ * non-US Government use and distribution.
+ *
+ * This Software includes and/or makes use of the following Third-Party
+ * Software subject to its own license:
+ *
+ * 1. Matrix Market Loader code (https://math.nist.gov/MatrixMarket/mmio-c.html).
+ *
+ *      The code made publicly available at nist.gov is not marked with a 
+ *      copyright notice and is therefore believed pursuant to section 105 of 
+ *      the Copyright Act, to not be entitled to domestic copyright protection 
+ *      under U.S. law and is therefore in the public domain.  Accordingly, it 
+ *      is believed that no license is required for its use.
+ *
+ * This Software may include certain portions of copyrighted code that is 
+ * initially being released only in binary form for validation and evaluation
+ * purposes. It is expected that source code will be released as open source at
+ * a future date. 
+ *
+ * DM20-0375
+ */
+ 
+#ifndef SSSP_BATCH_H
+#define SSSP_BATCH_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <omp.h>
+#include "utils.h"
+#include "sssp_types.h"
+
+// Number of sources solved together. Distances are stored vertex-major with
+// SSSP_LANES consecutive entries per vertex, so each edge feeds one SIMD
+// min-update of every lane (16 x uint32 or float = two AVX2 or one AVX-512
+// register; 64-bit distances take twice as many).
+#ifndef SSSP_LANES
+#define SSSP_LANES 16
+#endif
+
+// Called once per source, from the calling thread. lens holds N distances
+// (sssp_inf<D>() for unreachable vertices) and is only valid for the
+// duration of the call.
+template <typename D>
+using sssp_done_cb_t = void (*)(
+    uint32_t src_idx,
+    uint32_t src,
+    const D * lens,
+    void * ctx);
+
+/*
+ * Batched SSSP from many sources.
+ *
+ * Sources are taken SSSP_LANES at a time (ids >= N are skipped), and each
+ * batch runs delta-stepping on all lanes at once: bucket i holds the
+ * vertices with some lane distance in [i*delta, (i+1)*delta). Relaxing an
+ * edge loads its target and weight once for the whole batch and compares
+ * all lanes with one SIMD min; only the lanes that improve are written
+ * (with a compare-and-swap each). Lanes that improve beyond the current
+ * bucket are filed in thread-local buckets for later. Additions saturate at
+ * sssp_inf<D>(); the lane update has one SIMD form for integer distances
+ * (wrap-around detection) and one for floating point (plain adds). D and W
+ * are any pair from sssp_types.h.
+ *
+ * delta must be positive (see sssp_auto_delta). cb may be NULL. Returns the
+ * total number of relaxation rounds.
+ */
+template <typename D, typename W>
+uint32_t batch_sssp(uint32_t * IA, uint32_t * JA, W * A, uint32_t N,
+  D delta, const uint32_t * srcs, uint32_t num_srcs,
+  sssp_done_cb_t<D> cb, void * cb_ctx);
+#endif
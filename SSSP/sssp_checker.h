@@ -51,7 +51,9 @@
 #include <utility>
 #include <limits>
 #include <cassert>
+#include <cmath>
 #include "utils.h"
+#include "sssp_types.h"
 
 typedef uint64_t dist_t; 
 
@@ -64,5 +66,111 @@ bool check_dists(
 		uint32_t * dists_to_check
 		);
 
+// Reference distances from src_id for check_dists_typed and
+// check_p2p_typed: a sequential Dijkstra in R.
+template <typename R, typename W>
+std::vector<R> ref_dists_typed(uint32_t * IA, uint32_t * JA, W * VA,
+  uint32_t N, uint32_t src_id)
+{
+ typedef std::pair<R, uint32_t> entry_t;
+ std::vector<R> ref(N, sssp_inf<R>());
+ std::priority_queue<entry_t, std::vector<entry_t>, std::greater<entry_t> > pq;
+ ref[src_id] = 0;
+ pq.push(entry_t(0, src_id));
+ while (!pq.empty()){
+  entry_t top = pq.top();
+  pq.pop();
+  uint32_t u = top.second;
+  if (top.first > ref[u]) continue;
+  for (uint32_t edx = IA[u]; edx < IA[u+1]; edx++){
+   R nd = sssp_add(ref[u], VA[edx]);
+   if (nd < ref[JA[edx]]){
+    ref[JA[edx]] = nd;
+    pq.push(entry_t(nd, JA[edx]));
+   }
+  }
+ }
+ return ref;
+}
+
+/*
+ * check_dists for the distance and weight types of the in-tree engines
+ * (see sssp_types.h). Runs a sequential Dijkstra from src_id and compares.
+ * Integer distances are recomputed in 64 bits, so a distance too large for
+ * D (which the engines saturate to sssp_inf<D>()) is reported as an
+ * overflow rather than as a plain mismatch. Floating point distances are
+ * recomputed in D: both sides add the weights along a path in the same
+ * order, so the minimum over paths must match exactly.
+ */
+template <typename D, typename W>
+bool check_dists_typed(uint32_t * IA, uint32_t * JA, W * VA, uint32_t N,
+  uint32_t src_id, const D * dists_to_check)
+{
+ typedef typename std::conditional<std::is_integral<D>::value,
+   uint64_t, D>::type R;
+ std::vector<R> ref = ref_dists_typed<R>(IA, JA, VA, N, src_id);
+
+ uint32_t mismatches = 0, overflows = 0;
+ for (uint32_t v = 0; v < N; v++){
+  R expect = ref[v];
+  bool overflow = (expect != sssp_inf<R>() && expect >= (R)sssp_inf<D>());
+  if (overflow){
+   overflows++;
+   continue;
+  }
+  D want = (expect == sssp_inf<R>()) ? sssp_inf<D>() : (D)expect;
+  if (dists_to_check[v] != want){
+   if (mismatches < 10){
+    std::cout << "Mismatch at vertex " << v << ": expected " << (double)want
+     << ", got " << (double)dists_to_check[v] << std::endl;
+   }
+   mismatches++;
+  }
+ }
+ if (overflows){
+  std::cout << overflows << " distances from " << src_id
+   << " overflow the distance type; use a wider one." << std::endl;
+ }
+ if (mismatches){
+  std::cout << mismatches << " distances from " << src_id << " differ."
+   << std::endl;
+ }
+ return mismatches == 0 && overflows == 0;
+}
+
+/*
+ * Check one point-to-point distance (p2p_distance) against a full
+ * Dijkstra from src_id. Like check_dists_typed, an integer distance that
+ * does not fit D must come back as sssp_inf<D>() and is reported as an
+ * overflow. Floating point distances may differ in the last bits, since the
+ * two searches can add up different equally short paths, so they are
+ * compared with a relative tolerance.
+ */
+template <typename D, typename W>
+bool check_p2p_typed(uint32_t * IA, uint32_t * JA, W * VA, uint32_t N,
+  uint32_t src_id, uint32_t dst_id, D dist_to_check)
+{
+ typedef typename std::conditional<std::is_integral<D>::value,
+   uint64_t, D>::type R;
+ std::vector<R> ref = ref_dists_typed<R>(IA, JA, VA, N, src_id);
+ R expect = ref[dst_id];
+ if (expect != sssp_inf<R>() && expect >= (R)sssp_inf<D>()){
+  std::cout << "Distance " << src_id << " -> " << dst_id
+   << " overflows the distance type; use a wider one." << std::endl;
+  return false;
+ }
+ D want = (expect == sssp_inf<R>()) ? sssp_inf<D>() : (D)expect;
+ bool ok = (dist_to_check == want);
+ if (!ok && std::is_floating_point<D>::value && want != sssp_inf<D>()){
+  ok = std::abs((double)dist_to_check - (double)want) <=
+    1e-6 * std::abs((double)want);
+ }
+ if (!ok){
+  std::cout << "Mismatch " << src_id << " -> " << dst_id << ": expected "
+   << (double)want << ", got " << (double)dist_to_check << std::endl;
+ }
+ return ok;
+}
+
 
 #endif
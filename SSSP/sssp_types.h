@@ -0,0 +1,136 @@
+/*
+ * Graph Kernel Collection
+ *
+ * Copyright 2020 Carnegie Mellon University.
+ *
+ * NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ * INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON 
+ * UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR IMPLIED, 
+ * AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF FITNESS FOR 
+ * PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS OBTAINED FROM USE OF 
+ * THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES NOT MAKE ANY WARRANTY OF ANY
+ * KIND WITH RESPECT TO FREEDOM FROM PATENT, TRADEMARK, OR COPYRIGHT 
+ * INFRINGEMENT.
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or
+ * contact permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public
+ * release and unlimited distribution.  Please see Copyright notice for 
+ * non-US Government use and distribution.
+ *
+ * This Software includes and/or makes use of the following Third-Party
+ * Software subject to its own license:
+ *
+ * 1. Matrix Market Loader code (https://math.nist.gov/MatrixMarket/mmio-c.html).
+ *
+ *      The code made publicly available at nist.gov is not marked with a 
+ *      copyright notice and is therefore believed pursuant to section 105 of 
+ *      the Copyright Act, to not be entitled to domestic copyright protection 
+ *      under U.S. law and is therefore in the public domain.  Accordingly, it 
+ *      is believed that no license is required for its use.
+ *
+ * This Software may include certain portions of copyrighted code that is 
+ * initially being released only in binary form for validation and evaluation
+ * purposes. It is expected that source code will be released as open source at
+ * a future date. 
+ *
+ * DM20-0375
+ */
+ 
+#ifndef SSSP_TYPES_H
+#define SSSP_TYPES_H
+
+#include <stdint.h>
+#include <string.h>
+#include <limits>
+#include <type_traits>
+
+/*
+ * Distance and weight types of the in-tree SSSP engines.
+ *
+ * Distances (D) are uint32_t, uint64_t, float or double; weights (W) are
+ * non-negative values of a type no wider than D. Unreachable vertices hold
+ * sssp_inf<D>(): the largest value for integers, +infinity for floating
+ * point. Sums never wrap: integer additions saturate at sssp_inf, and
+ * floating point ones round to +infinity on overflow by themselves, so a
+ * distance that does not fit reads as unreachable instead of as a small
+ * value (check_dists_typed reports it).
+ */
+
+template <typename D>
+inline D sssp_inf(){
+ return std::numeric_limits<D>::has_infinity ?
+   std::numeric_limits<D>::infinity() : std::numeric_limits<D>::max();
+}
+
+// d + w without wrap-around.
+template <typename D, typename W>
+inline D sssp_add(D d, W w){
+ D sum = d + (D)w;
+ return sum < d ? sssp_inf<D>() : sum;
+}
+
+// Unsigned integer of the same size as D, for compare-and-swap on its bits.
+template <size_t S> struct sssp_bits_t;
+template <> struct sssp_bits_t<4> { typedef uint32_t type; };
+template <> struct sssp_bits_t<8> { typedef uint64_t type; };
+
+// Lower *loc to val. Returns true if this call lowered it.
+template <typename D>
+inline bool sssp_lower(D * loc, D val){
+ typedef typename sssp_bits_t<sizeof(D)>::type B;
+ D cmp = *loc;
+ while (val < cmp){
+  B cmp_b, val_b;
+  memcpy(&cmp_b, &cmp, sizeof(D));
+  memcpy(&val_b, &val, sizeof(D));
+  B old_b = __sync_val_compare_and_swap((B *)loc, cmp_b, val_b);
+  if (old_b == cmp_b) return true;
+  memcpy(&cmp, &old_b, sizeof(D));
+ }
+ return false;
+}
+
+// Bucket arithmetic for delta-stepping: bucket i is [i*delta, (i+1)*delta).
+// Integer distances compare against the exact bounds; floating point ones
+// divide, so a distance is always classified the same way as when it was
+// filed.
+template <typename D, bool F = std::is_floating_point<D>::value>
+struct sssp_bucket_t {
+ static inline uint64_t of(D d, D delta){
+  return (uint64_t)d / (uint64_t)delta;
+ }
+ // True if d lies in bucket b or an earlier one.
+ static inline bool upto(D d, uint64_t b, D delta){
+  return (uint64_t)d < (b + 1) * (uint64_t)delta;
+ }
+ static inline bool in(D d, uint64_t b, D delta){
+  return (uint64_t)d >= b * (uint64_t)delta && upto(d, b, delta);
+ }
+};
+
+template <typename D>
+struct sssp_bucket_t<D, true> {
+ static inline uint64_t of(D d, D delta){
+  return (uint64_t)(d / delta);
+ }
+ static inline bool upto(D d, uint64_t b, D delta){
+  return of(d, delta) <= b;
+ }
+ static inline bool in(D d, uint64_t b, D delta){
+  return d != sssp_inf<D>() && of(d, delta) == b;
+ }
+};
+
+// Explicit instantiations provided by the engines: (D, W) =
+// (uint32_t, uint32_t), (uint64_t, uint32_t), (uint64_t, uint64_t),
+// (float, float), (double, float), (double, double).
+#define SSSP_INSTANTIATE(MACRO) \
+ MACRO(uint32_t, uint32_t) \
+ MACRO(uint64_t, uint32_t) \
+ MACRO(uint64_t, uint64_t) \
+ MACRO(float, float) \
+ MACRO(double, float) \
+ MACRO(double, double)
+#endif
@@ -0,0 +1,250 @@
+/*
+ * Graph Kernel Collection
+ *
+ * Copyright 2020 Carnegie Mellon University.
+ *
+ * NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ * INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON 
+ * UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR IMPLIED, 
+ * AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF FITNESS FOR 
+ * PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS OBTAINED FROM USE OF 
+ * THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES NOT MAKE ANY WARRANTY OF ANY
+ * KIND WITH RESPECT TO FREEDOM FROM PATENT, TRADEMARK, OR COPYRIGHT 
+ * INFRINGEMENT.
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or
+ * contact permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public
+ * release and unlimited distribution.  Please see Copyright notice for 
+ * non-US Government use and distribution.
+ *
+ * This Software includes and/or makes use of the following Third-Party
+ * Software subject to its own license:
+ *
+ * 1. Matrix Market Loader code (https://math.nist.gov/MatrixMarket/mmio-c.html).
+ *
+ *      The code made publicly available at nist.gov is not marked with a 
+ *      copyright notice and is therefore believed pursuant to section 105 of 
+ *      the Copyright Act, to not be entitled to domestic copyright protection 
+ *      under U.S. law and is therefore in the public domain.  Accordingly, it 
+ *      is believed that no license is required for its use.
+ *
+ * This Software may include certain portions of copyrighted code that is 
+ * initially being released only in binary form for validation and evaluation
+ * purposes. It is expected that source code will be released as open source at
+ * a future date. 
+ *
+ * DM20-0375
+ */
+ 
+#include "graph.h"
+#include "utils.h"
+#include "intersect.h"
+#include "similarity.h"
+#include "similarity_checker.h"
+#include <omp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <random>
+#include <vector>
+#include <algorithm>
+
+#ifndef ITERS
+#define ITERS 4
+#endif
+
+// Random pairs scored per round when no pairs file is given.
+#ifndef SIM_QUERIES
+#define SIM_QUERIES (4*1024*1024)
+#endif
+
+// Best pairs kept per source for the pair queries (0 keeps all) and for
+// the 2-hop queries from SIM_SOURCES random sources.
+#ifndef SIM_PAIRS_TOPK
+#define SIM_PAIRS_TOPK 0
+#endif
+
+#ifndef SIM_TOPK
+#define SIM_TOPK 10
+#endif
+
+#ifndef SIM_SOURCES
+#define SIM_SOURCES 1024
+#endif
+
+#ifdef SIM_JACCARD_SCORE
+#define SIM_METRIC SIM_JACCARD
+#else
+#define SIM_METRIC SIM_COMMON
+#endif
+
+// 2-hop queries skip existing edges unless -DSIM_KEEP_NEIGHBORS.
+#ifdef SIM_KEEP_NEIGHBORS
+#define SIM_EXCLUDE_NEIGHBORS false
+#else
+#define SIM_EXCLUDE_NEIGHBORS true
+#endif
+
+// What the sink does with the results of a round.
+typedef struct {
+  uint64_t count;
+  double score_sum;
+  FILE * out;
+  std::vector<sim_result_t> * keep;
+} sink_state_t;
+
+static void sink_results(const sim_result_t * results, uint32_t n,
+  void * ctx)
+{
+  sink_state_t * st = (sink_state_t *)ctx;
+  st->count += n;
+  for (uint32_t i = 0; i < n; i++){
+    st->score_sum += results[i].score;
+  }
+  if (st->out){
+    for (uint32_t i = 0; i < n; i++){
+      fprintf(st->out, "%u %u %u %g\n", results[i].u, results[i].v,
+        results[i].common, results[i].score);
+    }
+  }
+  if (st->keep) st->keep->insert(st->keep->end(), results, results + n);
+}
+
+void usage(char * pname){
+	fprintf(stderr, "USAGE: %s <IA fname> <JA fname> [<pairs fname>|random [<out fname>]]\n", pname);
+	exit(EXIT_FAILURE);
+}
+
+int main(int argc, char ** argv){
+  uint32_t *IA;
+  uint32_t *JA;
+  uint32_t *pairs;
+  uint64_t num_pairs;
+  double st, nd;
+
+  if (argc < 3)
+    {
+      usage(argv[0]);
+      return 1;
+    }
+
+  uint32_t N = tell_size(argv[1])-1;
+  uint32_t M = tell_size(argv[2]);
+
+  IA = (uint32_t *)malloc((N+1)*sizeof(uint32_t));
+  JA = (uint32_t *)malloc(M*sizeof(uint32_t));
+  if (!IA || !JA ) {
+    fprintf(stderr, "COULD NOT ALLOCATE MEMORY\n");
+    exit(EXIT_FAILURE);
+  }
+  read_binary_buffers(argv[1], IA);
+  read_binary_buffers(argv[2], JA);
+  printf(" %s %u nodes %u edges\n", argv[1], N, IA[N]);
+
+  std::mt19937 gen(27491095);
+  std::uniform_int_distribution<uint32_t> pick(0, MAX(N, 1) - 1);
+  // A pairs file holds u0 v0 u1 v1 ... in the IA/JA format.
+  if (argc >= 4 && strcmp(argv[3], "random") != 0){
+    uint32_t len = tell_size(argv[3]);
+    if (len % 2){
+      fprintf(stderr, "ERROR: %s holds an odd number of ids.\n", argv[3]);
+      exit(EXIT_FAILURE);
+    }
+    num_pairs = len / 2;
+    pairs = (uint32_t *)malloc(MAX(len, 1) * sizeof(uint32_t));
+    if (!pairs){
+      fprintf(stderr, "COULD NOT ALLOCATE MEMORY\n");
+      exit(EXIT_FAILURE);
+    }
+    read_binary_buffers(argv[3], pairs);
+  } else {
+    num_pairs = SIM_QUERIES;
+    pairs = (uint32_t *)malloc(2 * num_pairs * sizeof(uint32_t));
+    if (!pairs){
+      fprintf(stderr, "COULD NOT ALLOCATE MEMORY\n");
+      exit(EXIT_FAILURE);
+    }
+    for (uint64_t p = 0; p < 2 * num_pairs; p++){
+      pairs[p] = pick(gen);
+    }
+  }
+  FILE * out = NULL;
+  if (argc >= 5){
+    out = fopen(argv[4], "w");
+    if (!out){
+      fprintf(stderr, "ERROR: could not open %s.\n", argv[4]);
+      exit(EXIT_FAILURE);
+    }
+  }
+
+  // Distinct sources for the 2-hop queries.
+  std::vector<uint32_t> sources;
+  for (uint32_t v = 0; v < N; v++) sources.push_back(v);
+  std::shuffle(sources.begin(), sources.end(), gen);
+  sources.resize(MIN((uint32_t)SIM_SOURCES, N));
+
+  char * trunc_fname = truncate_fname(argv[1]);
+  double tot_time = 0.0, tot_hop_time = 0.0;
+  uint32_t num_threads = omp_get_max_threads();
+  std::vector<sim_result_t> pair_results, hop_results;
+
+  printf("Start Similarity (%s, %s kernels)\n",
+    SIM_METRIC == SIM_JACCARD ? "Jaccard" : "common neighbors",
+    intersect_isa_name(intersect_isa()));
+  printf("round, name, kind, queries, results, score sum, time(s), queries/sec, threads\n");
+  for (uint32_t iter = 0; iter < ITERS; iter++){
+    // The results of the first round go to the output file, those of the
+    // last to the checker.
+    bool last = (iter == ITERS - 1);
+    sink_state_t sp = {0, 0.0, iter == 0 ? out : NULL, NULL};
+    sink_state_t sh = {0, 0.0, iter == 0 ? out : NULL, NULL};
+#ifdef VERIFY
+    if (last){
+      sp.keep = &pair_results;
+      sh.keep = &hop_results;
+    }
+#endif
+    (void)last;
+    st = omp_get_wtime();
+    sim_pairs(IA, JA, N, pairs, num_pairs, SIM_METRIC, SIM_PAIRS_TOPK,
+      sink_results, &sp);
+    nd = omp_get_wtime();
+    printf("Round %u, %s, pairs, %lu, %lu, %f, %f sec, %f, %u\n", iter,
+      trunc_fname, (unsigned long)num_pairs, (unsigned long)sp.count,
+      sp.score_sum, nd-st, num_pairs / (nd-st), num_threads);
+    tot_time += nd - st;
+
+    st = omp_get_wtime();
+    sim_two_hop(IA, JA, N, sources.data(), sources.size(), SIM_METRIC,
+      SIM_TOPK, SIM_EXCLUDE_NEIGHBORS, sink_results, &sh);
+    nd = omp_get_wtime();
+    printf("Round %u, %s, two-hop, %lu, %lu, %f, %f sec, %f, %u\n", iter,
+      trunc_fname, (unsigned long)sources.size(), (unsigned long)sh.count,
+      sh.score_sum, nd-st, sources.size() / (nd-st), num_threads);
+    tot_hop_time += nd - st;
+  }
+  printf("Average pairs time: %lf seconds.\n", tot_time/ITERS);
+  printf("Average two-hop time: %lf seconds.\n", tot_hop_time/ITERS);
+
+#ifdef VERIFY
+  bool passed = check_sim_pairs(IA, JA, N, pairs, num_pairs, SIM_METRIC,
+    SIM_PAIRS_TOPK, pair_results);
+  passed = check_sim_two_hop(IA, JA, N, sources.data(), sources.size(),
+    SIM_METRIC, SIM_TOPK, SIM_EXCLUDE_NEIGHBORS, hop_results) && passed;
+  if (passed)
+    printf("Passed\n");
+  else
+    printf("Failed\n");
+#endif
+
+  if (out) fclose(out);
+  free(pairs);
+  free(trunc_fname);
+  free(IA);
+  free(JA);
+
+  return 0;
+}
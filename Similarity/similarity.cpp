@@ -0,0 +1,247 @@
+/*
+ * Graph Kernel Collection
+ *
+ * Copyright 2020 Carnegie Mellon University.
+ *
+ * NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ * INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON 
+ * UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR IMPLIED, 
+ * AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF FITNESS FOR 
+ * PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS OBTAINED FROM USE OF 
+ * THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES NOT MAKE ANY WARRANTY OF ANY
+ * KIND WITH RESPECT TO FREEDOM FROM PATENT, TRADEMARK, OR COPYRIGHT 
+ * INFRINGEMENT.
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or
+ * contact permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public
+ * release and unlimited distribution.  Please see Copyright notice for 
+ * non-US Government use and distribution.
+ *
+ * This Software includes and/or makes use of the following Third-Party
+ * Software subject to its own license:
+ *
+ * 1. Matrix Market Loader code (https://math.nist.gov/MatrixMarket/mmio-c.html).
+ *
+ *      The code made publicly available at nist.gov is not marked with a 
+ *      copyright notice and is therefore believed pursuant to section 105 of 
+ *      the Copyright Act, to not be entitled to domestic copyright protection 
+ *      under U.S. law and is therefore in the public domain.  Accordingly, it 
+ *      is believed that no license is required for its use.
+ *
+ * This Software may include certain portions of copyrighted code that is 
+ * initially being released only in binary form for validation and evaluation
+ * purposes. It is expected that source code will be released as open source at
+ * a future date. 
+ *
+ * DM20-0375
+ */
+ 
+#include "similarity.h"
+#include "intersect.h"
+#include <vector>
+#include <algorithm>
+
+// Better first: higher score, then lower target.
+static inline bool sim_better(const sim_result_t & x, const sim_result_t & y){
+ return x.score > y.score || (x.score == y.score && x.v < y.v);
+}
+
+static inline sim_result_t sim_score(uint32_t * IA, uint32_t * JA,
+  uint32_t u, uint32_t v, sim_metric_t metric)
+{
+ uint32_t du = IA[u+1] - IA[u], dv = IA[v+1] - IA[v];
+ sim_result_t r;
+ r.u = u;
+ r.v = v;
+ r.common = intersect_count(JA + IA[u], du, JA + IA[v], dv);
+ if (metric == SIM_JACCARD){
+  uint32_t uni = du + dv - r.common;
+  r.score = uni ? (float)r.common / uni : 0.0f;
+ } else {
+  r.score = (float)r.common;
+ }
+ return r;
+}
+
+// Per-thread staging of results on their way to the sink, and the best k
+// of the current source.
+typedef struct {
+ sim_sink_t sink;
+ void * ctx;
+ uint32_t k;
+ std::vector<sim_result_t> out;
+ std::vector<sim_result_t> heap;
+ uint64_t streamed;
+} sim_stream_t;
+
+static void sim_flush(sim_stream_t * s){
+ if (s->out.empty()) return;
+#pragma omp critical(sim_sink)
+ s->sink(s->out.data(), s->out.size(), s->ctx);
+ s->streamed += s->out.size();
+ s->out.clear();
+}
+
+static inline void sim_emit(sim_stream_t * s, const sim_result_t & r){
+ s->out.push_back(r);
+ if (s->out.size() == SIM_BATCH) sim_flush(s);
+}
+
+// A result of the current source: streamed right away, or kept in a heap
+// whose top is the worst of the best k so far.
+static inline void sim_offer(sim_stream_t * s, const sim_result_t & r){
+ if (!s->k){
+  sim_emit(s, r);
+ } else if (s->heap.size() < s->k){
+  s->heap.push_back(r);
+  std::push_heap(s->heap.begin(), s->heap.end(), sim_better);
+ } else if (sim_better(r, s->heap.front())){
+  std::pop_heap(s->heap.begin(), s->heap.end(), sim_better);
+  s->heap.back() = r;
+  std::push_heap(s->heap.begin(), s->heap.end(), sim_better);
+ }
+}
+
+// Stream the best k of the source just finished, best first.
+static void sim_end_source(sim_stream_t * s){
+ if (!s->k) return;
+ std::sort_heap(s->heap.begin(), s->heap.end(), sim_better);
+ for (size_t i = 0; i < s->heap.size(); i++) sim_emit(s, s->heap[i]);
+ s->heap.clear();
+}
+
+// Stable counting sort of pair ids by one endpoint.
+static void sort_pairs_by(const uint32_t * pairs, uint32_t N, int side,
+  const uint32_t * in, uint32_t * out, uint64_t num_pairs,
+  std::vector<uint64_t> & start)
+{
+ std::fill(start.begin(), start.end(), 0);
+ for (uint64_t p = 0; p < num_pairs; p++){
+  start[pairs[2*in[p] + side] + 1]++;
+ }
+ for (uint32_t x = 0; x < N; x++) start[x+1] += start[x];
+ std::vector<uint64_t> fill(start.begin(), start.end() - 1);
+ for (uint64_t p = 0; p < num_pairs; p++){
+  out[fill[pairs[2*in[p] + side]]++] = in[p];
+ }
+}
+
+uint64_t sim_pairs(uint32_t * IA, uint32_t * JA, uint32_t N,
+  const uint32_t * pairs, uint64_t num_pairs, sim_metric_t metric,
+  uint32_t k, sim_sink_t sink, void * ctx)
+{
+ for (uint64_t p = 0; p < 2 * num_pairs; p++){
+  if (pairs[p] >= N){
+   fprintf(stderr, "ERROR: pair %lu names vertex %u of %u.\n",
+     (unsigned long)(p / 2), pairs[p], N);
+   exit(EXIT_FAILURE);
+  }
+ }
+ if (num_pairs > UINT32_MAX){
+  fprintf(stderr, "ERROR: %lu pairs, at most %u per call.\n",
+    (unsigned long)num_pairs, UINT32_MAX);
+  exit(EXIT_FAILURE);
+ }
+ // By target, then stably by source: sources own contiguous runs with
+ // their targets in increasing order.
+ uint32_t * order = (uint32_t *)malloc(MAX(num_pairs, 1) * sizeof(uint32_t));
+ uint32_t * tmp = (uint32_t *)malloc(MAX(num_pairs, 1) * sizeof(uint32_t));
+ if (!order || !tmp){
+  fprintf(stderr, "ERROR: could not allocate pair order.\n");
+  exit(EXIT_FAILURE);
+ }
+ std::vector<uint64_t> start((uint64_t)N + 1);
+#pragma omp parallel for schedule(static)
+ for (uint64_t p = 0; p < num_pairs; p++) tmp[p] = p;
+ sort_pairs_by(pairs, N, 1, tmp, order, num_pairs, start);
+ sort_pairs_by(pairs, N, 0, order, tmp, num_pairs, start);
+ std::swap(order, tmp);
+ free(tmp);
+
+ uint64_t streamed = 0;
+#pragma omp parallel reduction(+:streamed)
+ {
+  sim_stream_t s;
+  s.sink = sink;
+  s.ctx = ctx;
+  s.k = k;
+  s.streamed = 0;
+  s.out.reserve(SIM_BATCH);
+#pragma omp for schedule(dynamic, 64)
+  for (uint32_t u = 0; u < N; u++){
+   if (start[u] == start[u+1]) continue;
+   for (uint64_t q = start[u]; q < start[u+1]; q++){
+    uint32_t v = pairs[2*(uint64_t)order[q] + 1];
+    sim_offer(&s, sim_score(IA, JA, u, v, metric));
+   }
+   sim_end_source(&s);
+  }
+  sim_flush(&s);
+  streamed += s.streamed;
+ }
+ free(order);
+ return streamed;
+}
+
+uint64_t sim_two_hop(uint32_t * IA, uint32_t * JA, uint32_t N,
+  const uint32_t * sources, uint32_t num_sources, sim_metric_t metric,
+  uint32_t k, bool exclude_neighbors, sim_sink_t sink, void * ctx)
+{
+ if (!sources) num_sources = N;
+ for (uint32_t sdx = 0; sources && sdx < num_sources; sdx++){
+  if (sources[sdx] >= N){
+   fprintf(stderr, "ERROR: source %u of %u vertices.\n", sources[sdx], N);
+   exit(EXIT_FAILURE);
+  }
+ }
+ uint64_t streamed = 0;
+#pragma omp parallel reduction(+:streamed)
+ {
+  sim_stream_t s;
+  s.sink = sink;
+  s.ctx = ctx;
+  s.k = k;
+  s.streamed = 0;
+  s.out.reserve(SIM_BATCH);
+  std::vector<uint64_t> seen(N / 64 + 1, 0);
+  std::vector<uint32_t> cand;
+#pragma omp for schedule(dynamic, 1)
+  for (uint32_t sdx = 0; sdx < num_sources; sdx++){
+   uint32_t u = sources ? sources[sdx] : sdx;
+   // Marked vertices never become candidates.
+   seen[u >> 6] |= 1ull << (u & 63);
+   if (exclude_neighbors){
+    for (uint32_t e = IA[u]; e < IA[u+1]; e++){
+     seen[JA[e] >> 6] |= 1ull << (JA[e] & 63);
+    }
+   }
+   for (uint32_t e = IA[u]; e < IA[u+1]; e++){
+    uint32_t x = JA[e];
+    for (uint32_t f = IA[x]; f < IA[x+1]; f++){
+     uint32_t v = JA[f];
+     uint64_t bit = 1ull << (v & 63);
+     if (!(seen[v >> 6] & bit)){
+      seen[v >> 6] |= bit;
+      cand.push_back(v);
+     }
+    }
+   }
+   // In id order the candidate neighborhoods are read front to back.
+   std::sort(cand.begin(), cand.end());
+   for (size_t c = 0; c < cand.size(); c++){
+    sim_offer(&s, sim_score(IA, JA, u, cand[c], metric));
+   }
+   sim_end_source(&s);
+   // Clear only the words that were touched.
+   seen[u >> 6] = 0;
+   for (uint32_t e = IA[u]; e < IA[u+1]; e++) seen[JA[e] >> 6] = 0;
+   for (size_t c = 0; c < cand.size(); c++) seen[cand[c] >> 6] = 0;
+   cand.clear();
+  }
+  sim_flush(&s);
+  streamed += s.streamed;
+ }
+ return streamed;
+}
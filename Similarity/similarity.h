@@ -0,0 +1,102 @@
+/*
+ * Graph Kernel Collection
+ *
+ * Copyright 2020 Carnegie Mellon University.
+ *
+ * NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ * INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON 
+ * UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR IMPLIED, 
+ * AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF FITNESS FOR 
+ * PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS OBTAINED FROM USE OF 
+ * THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES NOT MAKE ANY WARRANTY OF ANY
+ * KIND WITH RESPECT TO FREEDOM FROM PATENT, TRADEMARK, OR COPYRIGHT 
+ * INFRINGEMENT.
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or
+ * contact permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public
+ * release and unlimited distribution.  Please see Copyright notice for 
+ * non-US Government use and distribution.
+ *
+ * This Software includes and/or makes use of the following Third-Party
+ * Software subject to its own license:
+ *
+ * 1. Matrix Market Loader code (https://math.nist.gov/MatrixMarket/mmio-c.html).
+ *
+ *      The code made publicly available at nist.gov is not marked with a 
+ *      copyright notice and is therefore believed pursuant to section 105 of 
+ *      the Copyright Act, to not be entitled to domestic copyright protection 
+ *      under U.S. law and is therefore in the public domain.  Accordingly, it 
+ *      is believed that no license is required for its use.
+ *
+ * This Software may include certain portions of copyrighted code that is 
+ * initially being released only in binary form for validation and evaluation
+ * purposes. It is expected that source code will be released as open source at
+ * a future date. 
+ *
+ * DM20-0375
+ */
+ 
+#ifndef __SIMILARITY_H__
+#define __SIMILARITY_H__
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "utils.h"
+#include "graph.h"
+#include <omp.h>
+
+// Results handed to the sink at a time, per thread.
+#ifndef SIM_BATCH
+#define SIM_BATCH 4096
+#endif
+
+typedef enum {
+ SIM_COMMON,              // |N(u) & N(v)|
+ SIM_JACCARD              // |N(u) & N(v)| / |N(u) | N(v)|
+} sim_metric_t;
+
+typedef struct {
+ uint32_t u;
+ uint32_t v;
+ uint32_t common;         // common neighbors
+ float score;
+} sim_result_t;
+
+/*
+ * Receives results as they are produced. Batches come from the worker
+ * threads but one at a time, so the sink need not be thread safe; the
+ * results are only valid during the call.
+ */
+typedef void (*sim_sink_t)(const sim_result_t * results, uint32_t n,
+  void * ctx);
+
+/*
+ * Score the num_pairs pairs (pairs[2i], pairs[2i+1]) of the symmetric
+ * matrix (IA, JA), whose neighborhoods must be sorted. The pairs are
+ * ordered by source, then target, with two counting sort passes, and the
+ * sources are spread over the threads, so each N(u) stays in cache for
+ * all of its pairs; every pair is one intersect_count. With k > 0 only
+ * the k best pairs of each source are streamed (highest score first, ties
+ * to the lower target), otherwise all of them, grouped by source. Returns
+ * the number of results streamed.
+ */
+uint64_t sim_pairs(uint32_t * IA, uint32_t * JA, uint32_t N,
+  const uint32_t * pairs, uint64_t num_pairs, sim_metric_t metric,
+  uint32_t k, sim_sink_t sink, void * ctx);
+
+/*
+ * Score every vertex v two hops from each of the num_sources sources (all
+ * vertices if sources is NULL) against it: the 2-hop set is collected with
+ * a per-thread bitmap, then each candidate is intersected with the source.
+ * The source itself never appears, and neither do its neighbors with
+ * exclude_neighbors (link prediction). k selects as in sim_pairs; nothing
+ * is kept beyond one source's candidates per thread.
+ */
+uint64_t sim_two_hop(uint32_t * IA, uint32_t * JA, uint32_t N,
+  const uint32_t * sources, uint32_t num_sources, sim_metric_t metric,
+  uint32_t k, bool exclude_neighbors, sim_sink_t sink, void * ctx);
+
+#endif
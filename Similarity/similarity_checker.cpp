@@ -0,0 +1,154 @@
+/*
+ * Graph Kernel Collection
+ *
+ * Copyright 2020 Carnegie Mellon University.
+ *
+ * NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ * INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON 
+ * UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR IMPLIED, 
+ * AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF FITNESS FOR 
+ * PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS OBTAINED FROM USE OF 
+ * THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES NOT MAKE ANY WARRANTY OF ANY
+ * KIND WITH RESPECT TO FREEDOM FROM PATENT, TRADEMARK, OR COPYRIGHT 
+ * INFRINGEMENT.
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or
+ * contact permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public
+ * release and unlimited distribution.  Please see Copyright notice for 
+ * non-US Government use and distribution.
+ *
+ * This Software includes and/or makes use of the following Third-Party
+ * Software subject to its own license:
+ *
+ * 1. Matrix Market Loader code (https://math.nist.gov/MatrixMarket/mmio-c.html).
+ *
+ *      The code made publicly available at nist.gov is not marked with a 
+ *      copyright notice and is therefore believed pursuant to section 105 of 
+ *      the Copyright Act, to not be entitled to domestic copyright protection 
+ *      under U.S. law and is therefore in the public domain.  Accordingly, it 
+ *      is believed that no license is required for its use.
+ *
+ * This Software may include certain portions of copyrighted code that is 
+ * initially being released only in binary form for validation and evaluation
+ * purposes. It is expected that source code will be released as open source at
+ * a future date. 
+ *
+ * DM20-0375
+ */
+ 
+#include "similarity_checker.h"
+#include <algorithm>
+#include <iterator>
+
+static sim_result_t reference_score(uint32_t * IA, uint32_t * JA, uint32_t u,
+  uint32_t v, sim_metric_t metric)
+{
+ std::vector<uint32_t> common;
+ std::set_intersection(JA + IA[u], JA + IA[u+1], JA + IA[v], JA + IA[v+1],
+   std::back_inserter(common));
+ uint32_t uni = (IA[u+1] - IA[u]) + (IA[v+1] - IA[v]) - common.size();
+ sim_result_t r;
+ r.u = u;
+ r.v = v;
+ r.common = common.size();
+ if (metric == SIM_JACCARD) r.score = uni ? (float)r.common / uni : 0.0f;
+ else r.score = (float)r.common;
+ return r;
+}
+
+static bool better(const sim_result_t & x, const sim_result_t & y){
+ return x.score > y.score || (x.score == y.score && x.v < y.v);
+}
+
+static bool by_target(const sim_result_t & x, const sim_result_t & y){
+ return x.v < y.v;
+}
+
+static bool by_source(const sim_result_t & x, const sim_result_t & y){
+ return x.u < y.u;
+}
+
+// expected holds every candidate result of each source; keep the best k
+// (or all) and compare with what was streamed.
+static bool compare(std::vector<std::vector<sim_result_t> > & expected,
+  uint32_t k, const std::vector<sim_result_t> & results)
+{
+ std::vector<sim_result_t> got(results);
+ std::stable_sort(got.begin(), got.end(), by_source);
+ uint32_t num_errors = 0;
+ size_t pos = 0;
+ for (uint32_t u = 0; u < expected.size(); u++){
+  std::vector<sim_result_t> & want = expected[u];
+  if (k){
+   std::sort(want.begin(), want.end(), better);
+   if (want.size() > k) want.resize(k);
+  } else {
+   std::sort(want.begin(), want.end(), by_target);
+  }
+  size_t end = pos;
+  while (end < got.size() && got[end].u == u) end++;
+  std::vector<sim_result_t> mine(got.begin() + pos, got.begin() + end);
+  pos = end;
+  if (!k) std::stable_sort(mine.begin(), mine.end(), by_target);
+  bool ok = (mine.size() == want.size());
+  for (size_t i = 0; ok && i < mine.size(); i++){
+   ok = (mine[i].v == want[i].v && mine[i].common == want[i].common &&
+     mine[i].score == want[i].score);
+  }
+  if (!ok){
+   if (num_errors < 10){
+    printf("%u: %lu results, expected %lu\n", u, (unsigned long)mine.size(),
+      (unsigned long)want.size());
+   }
+   num_errors++;
+  }
+ }
+ if (pos != got.size()){
+  printf("%lu results for unknown sources\n",
+    (unsigned long)(got.size() - pos));
+  num_errors++;
+ }
+ if (num_errors) printf("%u sources with wrong results\n", num_errors);
+ return num_errors == 0;
+}
+
+bool check_sim_pairs(uint32_t * IA, uint32_t * JA, uint32_t N,
+  const uint32_t * pairs, uint64_t num_pairs, sim_metric_t metric,
+  uint32_t k, const std::vector<sim_result_t> & results)
+{
+ std::vector<std::vector<sim_result_t> > expected(N);
+ for (uint64_t p = 0; p < num_pairs; p++){
+  uint32_t u = pairs[2*p], v = pairs[2*p+1];
+  expected[u].push_back(reference_score(IA, JA, u, v, metric));
+ }
+ return compare(expected, k, results);
+}
+
+bool check_sim_two_hop(uint32_t * IA, uint32_t * JA, uint32_t N,
+  const uint32_t * sources, uint32_t num_sources, sim_metric_t metric,
+  uint32_t k, bool exclude_neighbors,
+  const std::vector<sim_result_t> & results)
+{
+ if (!sources) num_sources = N;
+ std::vector<std::vector<sim_result_t> > expected(N);
+ for (uint32_t sdx = 0; sdx < num_sources; sdx++){
+  uint32_t u = sources ? sources[sdx] : sdx;
+  std::vector<uint32_t> hop2;
+  for (uint32_t e = IA[u]; e < IA[u+1]; e++){
+   uint32_t x = JA[e];
+   hop2.insert(hop2.end(), JA + IA[x], JA + IA[x+1]);
+  }
+  std::sort(hop2.begin(), hop2.end());
+  hop2.erase(std::unique(hop2.begin(), hop2.end()), hop2.end());
+  for (size_t i = 0; i < hop2.size(); i++){
+   uint32_t v = hop2[i];
+   if (v == u) continue;
+   if (exclude_neighbors &&
+       std::binary_search(JA + IA[u], JA + IA[u+1], v)) continue;
+   expected[u].push_back(reference_score(IA, JA, u, v, metric));
+  }
+ }
+ return compare(expected, k, results);
+}
@@ -0,0 +1,67 @@
+/*
+ * Graph Kernel Collection
+ *
+ * Copyright 2020 Carnegie Mellon University.
+ *
+ * NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ * INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON 
+ * UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR IMPLIED, 
+ * AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF FITNESS FOR 
+ * PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS OBTAINED FROM USE OF 
+ * THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES NOT MAKE ANY WARRANTY OF ANY
+ * KIND WITH RESPECT TO FREEDOM FROM PATENT, TRADEMARK, OR COPYRIGHT 
+ * INFRINGEMENT.
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or
+ * contact permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public
+ * release and unlimited distribution.  Please see Copyright notice for 
+ * non-US Government use and distribution.
+ *
+ * This Software includes and/or makes use of the following Third-Party
+ * Software subject to its own license:
+ *
+ * 1. Matrix Market Loader code (https://math.nist.gov/MatrixMarket/mmio-c.html).
+ *
+ *      The code made publicly available at nist.gov is not marked with a 
+ *      copyright notice and is therefore believed pursuant to section 105 of 
+ *      the Copyright Act, to not be entitled to domestic copyright protection 
+ *      under U.S. law and is therefore in the public domain.  Accordingly, it 
+ *      is believed that no license is required for its use.
+ *
+ * This Software may include certain portions of copyrighted code that is 
+ * initially being released only in binary form for validation and evaluation
+ * purposes. It is expected that source code will be released as open source at
+ * a future date. 
+ *
+ * DM20-0375
+ */
+ 
+#ifndef __SIMILARITY_CHECKER_H__
+#define __SIMILARITY_CHECKER_H__
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <vector>
+#include "utils.h"
+#include "similarity.h"
+
+/*
+ * Recompute the expected results of sim_pairs / sim_two_hop serially,
+ * with std::set_intersection and, for the 2-hop sets, a plain walk, and
+ * compare them with the streamed results: per source the same pairs in
+ * the same order with k > 0, the same pairs in any order otherwise, and
+ * the same common counts and scores throughout.
+ */
+bool check_sim_pairs(uint32_t * IA, uint32_t * JA, uint32_t N,
+  const uint32_t * pairs, uint64_t num_pairs, sim_metric_t metric,
+  uint32_t k, const std::vector<sim_result_t> & results);
+
+bool check_sim_two_hop(uint32_t * IA, uint32_t * JA, uint32_t N,
+  const uint32_t * sources, uint32_t num_sources, sim_metric_t metric,
+  uint32_t k, bool exclude_neighbors,
+  const std::vector<sim_result_t> & results);
+
+#endif
@@ -0,0 +1,286 @@
+/*
+ * Graph Kernel Collection
+ *
+ * Copyright 2020 Carnegie Mellon University.
+ *
+ * NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ * INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON 
+ * UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR IMPLIED, 
+ * AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF FITNESS FOR 
+ * PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS OBTAINED FROM USE OF 
+ * THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES NOT MAKE ANY WARRANTY OF ANY
+ * KIND WITH RESPECT TO FREEDOM FROM PATENT, TRADEMARK, OR COPYRIGHT 
+ * INFRINGEMENT.
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or
+ * contact permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public
+ * release and unlimited distribution.  Please see Copyright notice for 
+ * non-US Government use and distribution.
+ *
+ * This Software includes and/or makes use of the following Third-Party
+ * Software subject to its own license:
+ *
+ * 1. Matrix Market Loader code (https://math.nist.gov/MatrixMarket/mmio-c.html).
+ *
+ *      The code made publicly available at nist.gov is not marked with a 
+ *      copyright notice and is therefore believed pursuant to section 105 of 
+ *      the Copyright Act, to not be entitled to domestic copyright protection 
+ *      under U.S. law and is therefore in the public domain.  Accordingly, it 
+ *      is believed that no license is required for its use.
+ *
+ * This Software may include certain portions of copyrighted code that is 
+ * initially being released only in binary form for validation and evaluation
+ * purposes. It is expected that source code will be released as open source at
+ * a future date. 
+ *
+ * DM20-0375
+ */
+ 
+#include "scc.h"
+
+#define UNASSIGNED UINT32_MAX
+
+// Marks used by the forward-backward search:
+#define FB_NONE 0
+#define FB_FW   1
+#define FB_BOTH 2
+
+inline void min_CAS(uint32_t * loc, uint32_t swp){
+ uint32_t cmp = *loc;
+ while (swp < cmp){
+  uint32_t tmp = __sync_val_compare_and_swap(loc, cmp, swp);
+  if (tmp == cmp) break;
+  cmp = tmp;
+ }
+}
+
+// Collect the still unassigned vertices of rem (in place). Returns the new
+// size. Order is not preserved.
+static uint32_t compact_remaining(uint32_t * rem, uint32_t num_rem,
+  uint32_t * tmp, uint32_t * labels)
+{
+ uint32_t num_left = 0;
+#pragma omp parallel for schedule(dynamic, 1024)
+ for (uint32_t rdx = 0; rdx < num_rem; rdx++){
+  uint32_t v = rem[rdx];
+  if (labels[v] == UNASSIGNED){
+   tmp[__sync_fetch_and_add(&num_left, 1)] = v;
+  }
+ }
+#pragma omp parallel for
+ for (uint32_t rdx = 0; rdx < num_left; rdx++){
+  rem[rdx] = tmp[rdx];
+ }
+ return num_left;
+}
+
+static inline bool has_unassigned_nbr(uint32_t v, uint32_t * I, uint32_t * J,
+  uint32_t * labels)
+{
+ for (uint32_t edx = I[v]; edx < I[v+1]; edx++){
+  uint32_t u = J[edx];
+  if (u != v && labels[u] == UNASSIGNED) return true;
+ }
+ return false;
+}
+
+// Assign every vertex without unassigned in- or out-neighbors to its own
+// SCC. Returns the number of vertices trimmed.
+static uint32_t trim(uint32_t * rem, uint32_t num_rem,
+  uint32_t * IA, uint32_t * JA, uint32_t * IAc, uint32_t * JAc,
+  uint32_t * labels)
+{
+ uint32_t total = 0;
+ for (uint32_t round = 0; round < SCC_TRIM_ROUNDS; round++){
+  uint32_t trimmed = 0;
+#pragma omp parallel for schedule(dynamic, 1024) reduction(+:trimmed)
+  for (uint32_t rdx = 0; rdx < num_rem; rdx++){
+   uint32_t v = rem[rdx];
+   if (labels[v] != UNASSIGNED) continue;
+   if (!has_unassigned_nbr(v, IAc, JAc, labels) ||
+       !has_unassigned_nbr(v, IA, JA, labels)){
+    labels[v] = v;
+    trimmed++;
+   }
+  }
+  total += trimmed;
+  if (trimmed == 0) break;
+ }
+ return total;
+}
+
+// Level-synchronous BFS from src over (I, J) that only visits unassigned
+// vertices whose mark equals want, setting their mark to set.
+static void restricted_bfs(uint32_t src, uint32_t * I, uint32_t * J,
+  uint32_t * labels, uint8_t * mark, uint8_t want, uint8_t set,
+  uint32_t * frontier, uint32_t * next)
+{
+ uint32_t f_size = 1, n_size;
+ frontier[0] = src;
+ mark[src] = set;
+ while (f_size > 0){
+  n_size = 0;
+#pragma omp parallel for schedule(dynamic, 64)
+  for (uint32_t fdx = 0; fdx < f_size; fdx++){
+   uint32_t u = frontier[fdx];
+   for (uint32_t edx = I[u]; edx < I[u+1]; edx++){
+    uint32_t w = J[edx];
+    if (labels[w] == UNASSIGNED && mark[w] == want &&
+        __sync_bool_compare_and_swap(&mark[w], want, set)){
+     next[__sync_fetch_and_add(&n_size, 1)] = w;
+    }
+   }
+  }
+  uint32_t * tmp = frontier;
+  frontier = next;
+  next = tmp;
+  f_size = n_size;
+ }
+}
+
+uint32_t SCC(uint32_t * IA, uint32_t * JA,
+  uint32_t * IAc, uint32_t * JAc,
+  uint32_t N, uint32_t * labels)
+{
+ if (N == 0) return 0;
+ uint32_t * rem = (uint32_t *)malloc(N * sizeof(uint32_t));
+ uint32_t * color = (uint32_t *)malloc(N * sizeof(uint32_t));
+ uint32_t * frontier = (uint32_t *)malloc(N * sizeof(uint32_t));
+ uint32_t * next = (uint32_t *)malloc(N * sizeof(uint32_t));
+ uint8_t * mark = (uint8_t *)malloc(N * sizeof(uint8_t));
+ if (!rem || !color || !frontier || !next || !mark){
+  fprintf(stderr, "ERROR: could not allocate SCC work arrays.\n");
+  exit(EXIT_FAILURE);
+ }
+
+#pragma omp parallel for
+ for (uint32_t v = 0; v < N; v++){
+  labels[v] = UNASSIGNED;
+  rem[v] = v;
+  mark[v] = FB_NONE;
+ }
+ uint32_t num_rem = N;
+
+ /**** Trim and extract the giant SCC ****/
+ trim(rem, num_rem, IA, JA, IAc, JAc, labels);
+ num_rem = compact_remaining(rem, num_rem, frontier, labels);
+ if (num_rem > 0){
+  // Pivot with the largest in*out degree product.
+  uint32_t pivot = rem[0];
+  uint64_t best = 0;
+#pragma omp parallel
+  {
+   uint32_t t_pivot = rem[0];
+   uint64_t t_best = 0;
+#pragma omp for nowait
+   for (uint32_t rdx = 0; rdx < num_rem; rdx++){
+    uint32_t v = rem[rdx];
+    uint64_t score = (uint64_t)(IA[v+1] - IA[v]) * (IAc[v+1] - IAc[v]);
+    if (score > t_best){
+     t_best = score;
+     t_pivot = v;
+    }
+   }
+#pragma omp critical
+   if (t_best > best || (t_best == best && t_pivot < pivot)){
+    best = t_best;
+    pivot = t_pivot;
+   }
+  }
+  // Forward closure, then backward closure within it.
+  restricted_bfs(pivot, IA, JA, labels, mark, FB_NONE, FB_FW, frontier, next);
+  restricted_bfs(pivot, IAc, JAc, labels, mark, FB_FW, FB_BOTH, frontier, next);
+#pragma omp parallel for
+  for (uint32_t rdx = 0; rdx < num_rem; rdx++){
+   uint32_t v = rem[rdx];
+   if (mark[v] == FB_BOTH) labels[v] = pivot;
+  }
+  num_rem = compact_remaining(rem, num_rem, frontier, labels);
+ }
+
+ /**** Coloring for the remainder ****/
+ while (num_rem > 0){
+  trim(rem, num_rem, IA, JA, IAc, JAc, labels);
+  num_rem = compact_remaining(rem, num_rem, frontier, labels);
+  if (num_rem == 0) break;
+
+  // Propagate the largest vertex id that reaches each vertex.
+#pragma omp parallel for
+  for (uint32_t rdx = 0; rdx < num_rem; rdx++){
+   color[rem[rdx]] = rem[rdx];
+  }
+  bool changed = true;
+  while (changed){
+   changed = false;
+#pragma omp parallel for schedule(dynamic, 1024)
+   for (uint32_t rdx = 0; rdx < num_rem; rdx++){
+    uint32_t v = rem[rdx];
+    uint32_t c = color[v];
+    for (uint32_t edx = IAc[v]; edx < IAc[v+1]; edx++){
+     uint32_t u = JAc[edx];
+     if (labels[u] == UNASSIGNED && color[u] > c) c = color[u];
+    }
+    if (c != color[v]){
+     color[v] = c;
+     changed = true;
+    }
+   }
+  }
+
+  // Each color root's SCC is the part of its color that reaches it.
+  uint32_t f_size = 0, n_size;
+#pragma omp parallel for
+  for (uint32_t rdx = 0; rdx < num_rem; rdx++){
+   uint32_t v = rem[rdx];
+   if (color[v] == v){
+    labels[v] = v;
+    frontier[__sync_fetch_and_add(&f_size, 1)] = v;
+   }
+  }
+  while (f_size > 0){
+   n_size = 0;
+#pragma omp parallel for schedule(dynamic, 64)
+   for (uint32_t fdx = 0; fdx < f_size; fdx++){
+    uint32_t u = frontier[fdx];
+    uint32_t c = color[u];
+    for (uint32_t edx = IAc[u]; edx < IAc[u+1]; edx++){
+     uint32_t w = JAc[edx];
+     if (labels[w] == UNASSIGNED && color[w] == c &&
+         __sync_bool_compare_and_swap(&labels[w], UNASSIGNED, c)){
+      next[__sync_fetch_and_add(&n_size, 1)] = w;
+     }
+    }
+   }
+   uint32_t * tmp = frontier;
+   frontier = next;
+   next = tmp;
+   f_size = n_size;
+  }
+  num_rem = compact_remaining(rem, num_rem, next, labels);
+ }
+
+ /**** Relabel each SCC by its smallest vertex id ****/
+#pragma omp parallel for
+ for (uint32_t v = 0; v < N; v++){
+  color[v] = UNASSIGNED;
+ }
+#pragma omp parallel for
+ for (uint32_t v = 0; v < N; v++){
+  min_CAS(&color[labels[v]], v);
+ }
+ uint32_t num_sccs = 0;
+#pragma omp parallel for reduction(+:num_sccs)
+ for (uint32_t v = 0; v < N; v++){
+  labels[v] = color[labels[v]];
+  if (labels[v] == v) num_sccs++;
+ }
+
+ free(rem);
+ free(color);
+ free(frontier);
+ free(next);
+ free(mark);
+ return num_sccs;
+}
@@ -0,0 +1,74 @@
+/*
+ * Graph Kernel Collection
+ *
+ * Copyright 2020 Carnegie Mellon University.
+ *
+ * NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ * INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON 
+ * UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR IMPLIED, 
+ * AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF FITNESS FOR 
+ * PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS OBTAINED FROM USE OF 
+ * THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES NOT MAKE ANY WARRANTY OF ANY
+ * KIND WITH RESPECT TO FREEDOM FROM PATENT, TRADEMARK, OR COPYRIGHT 
+ * INFRINGEMENT.
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or
+ * contact permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public
+ * release and unlimited distribution.  Please see Copyright notice for 
+ * non-US Government use and distribution.
+ *
+ * This Software includes and/or makes use of the following Third-Party
+ * Software subject to its own license:
+ *
+ * 1. Matrix Market Loader code (https://math.nist.gov/MatrixMarket/mmio-c.html).
+ *
+ *      The code made publicly available at nist.gov is not marked with a 
+ *      copyright notice and is therefore believed pursuant to section 105 of 
+ *      the Copyright Act, to not be entitled to domestic copyright protection 
+ *      under U.S. law and is therefore in the public domain.  Accordingly, it 
+ *      is believed that no license is required for its use.
+ *
+ * This Software may include certain portions of copyrighted code that is 
+ * initially being released only in binary form for validation and evaluation
+ * purposes. It is expected that source code will be released as open source at
+ * a future date. 
+ *
+ * DM20-0375
+ */
+ 
+#ifndef __SCC_H__
+#define __SCC_H__
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "utils.h"
+#include "graph.h"
+#include <omp.h>
+
+// Rounds of trimming (removing vertices with no remaining in- or out-edges)
+// done before the forward-backward search and again before each coloring
+// round.
+#ifndef SCC_TRIM_ROUNDS
+#define SCC_TRIM_ROUNDS 3
+#endif
+
+/*
+ * Parallel strongly connected components.
+ *
+ * Trims trivial SCCs, extracts the giant SCC with one forward-backward
+ * search from a high-degree pivot, and then repeatedly applies max-label
+ * coloring (forward propagation over the CSR followed by a backward search
+ * over the CSC from each color root) to the remaining vertices.
+ *
+ * Takes the directed CSR (IA, JA) and its transpose (IAc, JAc, e.g. from
+ * csr_to_csc_parallel). On return labels[v] is the smallest vertex id in
+ * v's SCC. Returns the number of SCCs.
+ */
+uint32_t SCC(uint32_t * IA, uint32_t * JA,
+  uint32_t * IAc, uint32_t * JAc,
+  uint32_t N, uint32_t * labels);
+
+#endif
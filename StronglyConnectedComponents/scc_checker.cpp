@@ -0,0 +1,116 @@
+/*
+ * Graph Kernel Collection
+ *
+ * Copyright 2020 Carnegie Mellon University.
+ *
+ * NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ * INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON 
+ * UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR IMPLIED, 
+ * AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF FITNESS FOR 
+ * PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS OBTAINED FROM USE OF 
+ * THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES NOT MAKE ANY WARRANTY OF ANY
+ * KIND WITH RESPECT TO FREEDOM FROM PATENT, TRADEMARK, OR COPYRIGHT 
+ * INFRINGEMENT.
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or
+ * contact permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public
+ * release and unlimited distribution.  Please see Copyright notice for 
+ * non-US Government use and distribution.
+ *
+ * This Software includes and/or makes use of the following Third-Party
+ * Software subject to its own license:
+ *
+ * 1. Matrix Market Loader code (https://math.nist.gov/MatrixMarket/mmio-c.html).
+ *
+ *      The code made publicly available at nist.gov is not marked with a 
+ *      copyright notice and is therefore believed pursuant to section 105 of 
+ *      the Copyright Act, to not be entitled to domestic copyright protection 
+ *      under U.S. law and is therefore in the public domain.  Accordingly, it 
+ *      is believed that no license is required for its use.
+ *
+ * This Software may include certain portions of copyrighted code that is 
+ * initially being released only in binary form for validation and evaluation
+ * purposes. It is expected that source code will be released as open source at
+ * a future date. 
+ *
+ * DM20-0375
+ */
+ 
+#include "scc_checker.h"
+
+bool check_SCC(uint32_t * IA, uint32_t * JA,
+  uint32_t N, uint32_t * labels_to_check)
+{
+ const uint32_t UNVISITED = UINT32_MAX;
+ std::vector<uint32_t> index(N, UNVISITED);
+ std::vector<uint32_t> low(N);
+ std::vector<uint32_t> labels(N, UNVISITED);
+ std::vector<bool> on_stack(N, false);
+ std::vector<uint32_t> scc_stack;
+ // DFS call stack of (vertex, next edge to look at):
+ std::vector<std::pair<uint32_t, uint32_t> > call_stack;
+ uint32_t next_index = 0;
+
+ for (uint32_t root = 0; root < N; root++){
+  if (index[root] != UNVISITED) continue;
+  call_stack.push_back(std::make_pair(root, IA[root]));
+  index[root] = low[root] = next_index++;
+  scc_stack.push_back(root);
+  on_stack[root] = true;
+  while (!call_stack.empty()){
+   uint32_t v = call_stack.back().first;
+   uint32_t edx = call_stack.back().second;
+   if (edx < IA[v+1]){
+    call_stack.back().second++;
+    uint32_t w = JA[edx];
+    if (index[w] == UNVISITED){
+     index[w] = low[w] = next_index++;
+     scc_stack.push_back(w);
+     on_stack[w] = true;
+     call_stack.push_back(std::make_pair(w, IA[w]));
+    }
+    else if (on_stack[w]){
+     low[v] = MIN(low[v], index[w]);
+    }
+    continue;
+   }
+   // All edges of v done:
+   call_stack.pop_back();
+   if (!call_stack.empty()){
+    uint32_t p = call_stack.back().first;
+    low[p] = MIN(low[p], low[v]);
+   }
+   if (low[v] == index[v]){
+    // Pop the SCC, labelling it by its smallest member.
+    size_t top = scc_stack.size();
+    uint32_t min_id = v;
+    size_t sdx = top;
+    do {
+     sdx--;
+     min_id = MIN(min_id, scc_stack[sdx]);
+    } while (scc_stack[sdx] != v);
+    for (size_t kdx = sdx; kdx < top; kdx++){
+     labels[scc_stack[kdx]] = min_id;
+     on_stack[scc_stack[kdx]] = false;
+    }
+    scc_stack.resize(sdx);
+   }
+  }
+ }
+
+ bool passed = true;
+ uint32_t num_errors = 0;
+ for (uint32_t v = 0; v < N; v++){
+  if (labels[v] != labels_to_check[v]){
+   if (num_errors < 10){
+    printf("%u: %u != %u\n", v, labels_to_check[v], labels[v]);
+   }
+   num_errors++;
+   passed = false;
+  }
+ }
+ if (!passed) printf("%u mismatched labels\n", num_errors);
+ return passed;
+}
@@ -0,0 +1,157 @@
+/*
+ * Graph Kernel Collection
+ *
+ * Copyright 2020 Carnegie Mellon University.
+ *
+ * NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ * INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON 
+ * UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR IMPLIED, 
+ * AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF FITNESS FOR 
+ * PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS OBTAINED FROM USE OF 
+ * THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES NOT MAKE ANY WARRANTY OF ANY
+ * KIND WITH RESPECT TO FREEDOM FROM PATENT, TRADEMARK, OR COPYRIGHT 
+ * INFRINGEMENT.
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or
+ * contact permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public
+ * release and unlimited distribution.  Please see Copyright notice for 
+ * non-US Government use and distribution.
+ *
+ * This Software includes and/or makes use of the following Third-Party
+ * Software subject to its own license:
+ *
+ * 1. Matrix Market Loader code (https://math.nist.gov/MatrixMarket/mmio-c.html).
+ *
+ *      The code made publicly available at nist.gov is not marked with a 
+ *      copyright notice and is therefore believed pursuant to section 105 of 
+ *      the Copyright Act, to not be entitled to domestic copyright protection 
+ *      under U.S. law and is therefore in the public domain.  Accordingly, it 
+ *      is believed that no license is required for its use.
+ *
+ * This Software may include certain portions of copyrighted code that is 
+ * initially being released only in binary form for validation and evaluation
+ * purposes. It is expected that source code will be released as open source at
+ * a future date. 
+ *
+ * DM20-0375
+ */
+ 
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <omp.h>
+#include <random>
+#include <vector>
+#include <algorithm>
+#include "utils.h"
+#include "intersect.h"
+
+// Ids intersected per timing, and the longest length ratio tried.
+#ifndef BENCH_ELEMENTS
+#define BENCH_ELEMENTS (16*1024*1024)
+#endif
+
+#ifndef BENCH_MAX_RATIO
+#define BENCH_MAX_RATIO 1024
+#endif
+
+void usage(char * pname){
+ fprintf(stderr, "USAGE: %s [<short list length>]\n", pname);
+ exit(EXIT_FAILURE);
+}
+
+// Sorted list of n distinct ids below N.
+static std::vector<uint32_t> random_list(std::mt19937 & gen, uint32_t n,
+  uint32_t N)
+{
+ std::uniform_int_distribution<uint32_t> pick(0, N - 1);
+ std::vector<uint32_t> list;
+ while (list.size() < n){
+  for (uint32_t i = list.size(); i < n; i++) list.push_back(pick(gen));
+  std::sort(list.begin(), list.end());
+  list.erase(std::unique(list.begin(), list.end()), list.end());
+ }
+ return list;
+}
+
+int main(int argc, char ** argv){
+ if (argc > 2) usage(argv[0]);
+ uint32_t n = (argc == 2) ? atoi(argv[1]) : 64;
+ if (n == 0) usage(argv[0]);
+
+ intersect_isa_t isas[3] = {INTERSECT_SCALAR, INTERSECT_AVX2,
+   INTERSECT_AVX512};
+ intersect_isa_t best = intersect_isa();
+ printf("Dispatched kernels: %s\n", intersect_isa_name(best));
+ printf("Short list %u ids, about a quarter of them in the long list\n", n);
+ printf("ratio, kernel, count ns/call, materialize ns/call, Mids/s\n");
+
+ std::mt19937 gen(27491095);
+ uint32_t crossover = 0;
+ bool passed = true;
+ for (uint32_t ratio = 1; ratio <= BENCH_MAX_RATIO; ratio *= 2){
+  uint64_t nb = (uint64_t)n * ratio;
+  // Universe of 4 nb ids: each id of a is in b with probability 1/4.
+  std::vector<uint32_t> a = random_list(gen, n, 4 * nb);
+  std::vector<uint32_t> b = random_list(gen, nb, 4 * nb);
+  std::vector<uint32_t> out(n + INTERSECT_PAD), ref(n);
+  uint32_t expect = std::set_intersection(a.begin(), a.end(), b.begin(),
+    b.end(), ref.begin()) - ref.begin();
+  uint32_t reps = MAX(1, BENCH_ELEMENTS / (n + nb));
+  uint64_t sink = 0;
+  double best_merge = 0.0;
+
+  for (int k = 0; k < 4; k++){
+   bool gallop = (k == 3);
+   if (!gallop){
+    if (!intersect_set_isa(isas[k])) continue;
+   }
+   const char * name = gallop ? "gallop" : intersect_isa_name(isas[k]);
+   double st = omp_get_wtime();
+   for (uint32_t r = 0; r < reps; r++){
+    sink += gallop ? intersect_gallop_count(a.data(), n, b.data(), nb) :
+      intersect_merge_count(a.data(), n, b.data(), nb);
+   }
+   double t_count = (omp_get_wtime() - st) / reps;
+   st = omp_get_wtime();
+   uint32_t got = 0;
+   for (uint32_t r = 0; r < reps; r++){
+    got = gallop ? intersect_gallop(a.data(), n, b.data(), nb, out.data()) :
+      intersect_merge(a.data(), n, b.data(), nb, out.data());
+    sink += got;
+   }
+   double t_emit = (omp_get_wtime() - st) / reps;
+   uint32_t got_count = gallop ?
+     intersect_gallop_count(a.data(), n, b.data(), nb) :
+     intersect_merge_count(a.data(), n, b.data(), nb);
+   if (got != expect || got_count != expect ||
+       !std::equal(ref.begin(), ref.begin() + expect, out.begin())){
+    printf("%s: %u / %u common ids, expected %u\n", name, got_count, got,
+      expect);
+    passed = false;
+   }
+   printf("%u, %s, %.1f, %.1f, %.1f\n", ratio, name, 1e9 * t_count,
+     1e9 * t_emit, (n + nb) / t_count / 1e6);
+   if (!gallop && (best_merge == 0.0 || t_count < best_merge)){
+    best_merge = t_count;
+   }
+   if (gallop && !crossover && t_count < best_merge) crossover = ratio;
+  }
+  if (sink == 1) printf(" ");
+ }
+ intersect_set_isa(best);
+ if (crossover){
+  printf("Galloping wins from ratio %u (INTERSECT_GALLOP_RATIO is %u)\n",
+    crossover, INTERSECT_GALLOP_RATIO);
+ } else {
+  printf("Galloping never wins up to ratio %u\n", BENCH_MAX_RATIO);
+ }
+ if (passed)
+  printf("PASSED CHECK\n");
+ else
+  printf("FAILED CHECK\n");
+ return 0;
+}
@@ -47,6 +47,20 @@
 #include <omp.h>
 #include <math.h>
 #include "tri_count_checker.h"
+// -DPER_VERTEX_TC also counts triangles per vertex and -DCLIQUE_K=k
+// counts k-cliques instead, both with the hybrid intersections.
+#if (defined(PER_VERTEX_TC) || defined(CLIQUE_K)) && !defined(HYBRID_TC)
+#define HYBRID_TC
+#endif
+#ifdef HYBRID_TC
+#include "tc_hybrid.h"
+#endif
+#ifdef CLIQUE_K
+#include "tc_clique.h"
+#endif
+#ifdef APPROX_TC
+#include "tc_approx.h"
+#endif
 
 #ifndef ITERS
 #define ITERS 3
@@ -88,25 +102,120 @@ int main(int argc, char** argv){
 
 
  // *************** Begin Processing ****************************
+#ifdef HYBRID_TC
+ // Thresholds are timed once at startup, outside of the trials.
+ st = omp_get_wtime();
+ tc_hybrid_params_t params = tc_hybrid_calibrate(IA, N);
+ nd = omp_get_wtime();
+ printf("Calibration: gallop ratio %u, bitmap degree %u (%f seconds)\n",
+   params.gallop_ratio, params.bitmap_degree, nd-st);
+ tc_hybrid_stats_t stats;
+#endif
+#ifdef VERIFY
+#ifdef CLIQUE_K
+ uint64_t clique_ref = clique_count_serial(IA, JA, N, CLIQUE_K);
+#else
+ // Counts are checked against an independent recount, taken once.
+ uint64_t tc_ref = tri_count_reference(IA, JA, N, trunc_fname);
+#endif
+#endif
+#ifdef APPROX_TC
+ // The wedge table depends only on the degrees and is built once.
+ st = omp_get_wtime();
+ tc_wedges_t * wedges = tc_wedges_build(IA, N);
+ nd = omp_get_wtime();
+ uint64_t samples = MAX((uint64_t)(TC_SAMPLE_RATE * wedges->total),
+   MIN((uint64_t)TC_MIN_SAMPLES,
+   (uint64_t)(TC_MIN_SAMPLES_SHARE * wedges->total)));
+ printf("Wedges: %lu, sampling %lu (%f seconds)\n", wedges->total, samples,
+   nd-st);
+ tc_approx_t est;
+#endif
+#ifdef PER_VERTEX_TC
+ uint64_t * tri = (uint64_t *)malloc(MAX(N, 1) * sizeof(uint64_t));
+ double * lcc = (double *)malloc(MAX(N, 1) * sizeof(double));
+ if (!tri || !lcc){
+  fprintf(stderr, "COULD NOT ALLOCATE MEMORY\n");
+  exit(EXIT_FAILURE);
+ }
+#endif
  uint64_t delta;
  double avg_time = 0;
  for (uint32_t p_iter = 0; p_iter < ITERS; p_iter++){
   st = omp_get_wtime();
+#if defined(CLIQUE_K)
+  delta = clique_count(IA, JA, N, CLIQUE_K, &params, &stats);
+#elif defined(PER_VERTEX_TC)
+  delta = tri_count_per_vertex(IA, JA, N, &params, tri, lcc, &stats);
+#elif defined(HYBRID_TC)
+  delta = tri_count_hybrid(IA, JA, N, &params, &stats);
+#elif defined(APPROX_TC)
+  delta = tri_count_approx(IA, JA, N, wedges, samples, TC_CONFIDENCE_Z,
+    27491095 + p_iter, &est);
+#else
   delta = tri_count(IA, JA, N);
+#endif
   nd = omp_get_wtime();
+#ifdef CLIQUE_K
+  printf("TRIAL: %lu %u-cliques in %f seconds\n", delta, CLIQUE_K, nd-st);
+#else
   printf("TRIAL: %lu triangles in %f seconds\n", delta, nd-st);
+#endif
   avg_time += nd-st;
+#ifdef HYBRID_TC
+  printf("Intersections: %lu merge, %lu gallop, %lu bitmap\n",
+    stats.merge, stats.gallop, stats.bitmap);
+#endif
+#ifdef APPROX_TC
+  printf("Interval: [%.0f, %.0f], %lu of %lu wedges closed\n",
+    est.lower, est.upper, est.closed, est.samples);
+#endif
 #ifdef VERIFY
-  if (check_tri_count(delta, trunc_fname)){
+#if defined(CLIQUE_K)
+  if (delta == clique_ref){
+#elif defined(APPROX_TC)
+  if (check_tri_count_approx(est.estimate, est.lower, est.upper, tc_ref)){
+#else
+  if (delta == tc_ref){
+#endif
    printf("PASSED CHECK\n");
   }
   else {
    printf("FAILED CHECK\n");
   }
+#ifdef PER_VERTEX_TC
+  if (p_iter == ITERS - 1){
+   if (check_tri_per_vertex(IA, JA, N, tri)){
+    printf("PASSED PER-VERTEX CHECK\n");
+   }
+   else {
+    printf("FAILED PER-VERTEX CHECK\n");
+   }
+  }
+#endif
 #endif
  }
  avg_time /= ITERS;
  printf("Average time: %f seconds\n", avg_time);
+#ifdef APPROX_TC
+ tc_wedges_free(wedges);
+#endif
+#ifdef PER_VERTEX_TC
+ double lcc_sum = 0.0;
+ uint64_t tri_max = 0;
+ uint32_t v_max = 0;
+ for (uint32_t v = 0; v < N; v++){
+  lcc_sum += lcc[v];
+  if (tri[v] > tri_max){
+   tri_max = tri[v];
+   v_max = v;
+  }
+ }
+ printf("Average clustering coefficient: %f\n", N ? lcc_sum / N : 0.0);
+ printf("Most triangles: %lu at vertex %u\n", tri_max, v_max);
+ free(tri);
+ free(lcc);
+#endif
  free(IA);
  free(JA);
  free(trunc_fname);
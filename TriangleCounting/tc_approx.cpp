@@ -0,0 +1,175 @@
+/*
+ * Graph Kernel Collection
+ *
+ * Copyright 2020 Carnegie Mellon University.
+ *
+ * NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ * INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON 
+ * UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR IMPLIED, 
+ * AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF FITNESS FOR 
+ * PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS OBTAINED FROM USE OF 
+ * THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES NOT MAKE ANY WARRANTY OF ANY
+ * KIND WITH RESPECT TO FREEDOM FROM PATENT, TRADEMARK, OR COPYRIGHT 
+ * INFRINGEMENT.
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or
+ * contact permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public
+ * release and unlimited distribution.  Please see Copyright notice for 
+ * non-US Government use and distribution.
+ *
+ * This Software includes and/or makes use of the following Third-Party
+ * Software subject to its own license:
+ *
+ * 1. Matrix Market Loader code (https://math.nist.gov/MatrixMarket/mmio-c.html).
+ *
+ *      The code made publicly available at nist.gov is not marked with a 
+ *      copyright notice and is therefore believed pursuant to section 105 of 
+ *      the Copyright Act, to not be entitled to domestic copyright protection 
+ *      under U.S. law and is therefore in the public domain.  Accordingly, it 
+ *      is believed that no license is required for its use.
+ *
+ * This Software may include certain portions of copyrighted code that is 
+ * initially being released only in binary form for validation and evaluation
+ * purposes. It is expected that source code will be released as open source at
+ * a future date. 
+ *
+ * DM20-0375
+ */
+ 
+#include "tc_approx.h"
+#include <math.h>
+#include <algorithm>
+#include <random>
+
+tc_wedges_t * tc_wedges_build(uint32_t * IA, uint32_t N){
+ tc_wedges_t * wedges = (tc_wedges_t *)malloc(sizeof(tc_wedges_t));
+ double * keep = (double *)malloc(MAX(N, 1) * sizeof(double));
+ uint32_t * alias = (uint32_t *)malloc(MAX(N, 1) * sizeof(uint32_t));
+ uint32_t * small = (uint32_t *)malloc(MAX(N, 1) * sizeof(uint32_t));
+ uint32_t * large = (uint32_t *)malloc(MAX(N, 1) * sizeof(uint32_t));
+ if (!wedges || !keep || !alias || !small || !large){
+  fprintf(stderr, "ERROR: could not allocate wedge table.\n");
+  exit(EXIT_FAILURE);
+ }
+ uint64_t total = 0;
+#pragma omp parallel for schedule(static) reduction(+:total)
+ for (uint32_t v = 0; v < N; v++){
+  uint64_t d = IA[v+1] - IA[v];
+  total += d * (d - (d > 0)) / 2;
+ }
+ // Vose's method: slots below the mean are topped up from ones above it.
+ uint32_t num_small = 0, num_large = 0;
+ for (uint32_t v = 0; v < N; v++){
+  uint64_t d = IA[v+1] - IA[v];
+  keep[v] = total ? (double)(d * (d - (d > 0)) / 2) * N / total : 1.0;
+  alias[v] = v;
+  if (keep[v] < 1.0) small[num_small++] = v;
+  else large[num_large++] = v;
+ }
+ while (num_small && num_large){
+  uint32_t s = small[--num_small];
+  uint32_t l = large[num_large-1];
+  alias[s] = l;
+  keep[l] -= 1.0 - keep[s];
+  if (keep[l] < 1.0){
+   num_large--;
+   small[num_small++] = l;
+  }
+ }
+ // Whatever is left is 1 up to rounding.
+ while (num_small) keep[small[--num_small]] = 1.0;
+ while (num_large) keep[large[--num_large]] = 1.0;
+ free(small);
+ free(large);
+ wedges->N = N;
+ wedges->total = total;
+ wedges->keep = keep;
+ wedges->alias = alias;
+ return wedges;
+}
+
+void tc_wedges_free(tc_wedges_t * wedges){
+ if (!wedges) return;
+ free(wedges->keep);
+ free(wedges->alias);
+ free(wedges);
+}
+
+// Whether y is in the sorted list a of length n.
+static inline bool sorted_find(const uint32_t * a, uint32_t n, uint32_t y){
+ const uint32_t * it = std::lower_bound(a, a + n, y);
+ return it != a + n && *it == y;
+}
+
+uint64_t tri_count_approx(uint32_t * IA, uint32_t * JA, uint32_t N,
+  const tc_wedges_t * wedges, uint64_t samples, double z, uint64_t seed,
+  tc_approx_t * est)
+{
+ uint64_t W = wedges->total;
+ uint64_t closed = 0;
+ // A budget of W samples or more checks every wedge once instead, which
+ // costs no more and gives the exact count.
+ if (samples >= W){
+#pragma omp parallel for schedule(dynamic, 64) reduction(+:closed)
+  for (uint32_t v = 0; v < N; v++){
+   for (uint32_t i = IA[v]; i < IA[v+1]; i++){
+    uint32_t a = JA[i], da = IA[a+1] - IA[a];
+    for (uint32_t j = i + 1; j < IA[v+1]; j++){
+     uint32_t b = JA[j], db = IA[b+1] - IA[b];
+     closed += (da <= db) ? sorted_find(JA + IA[a], da, b) :
+       sorted_find(JA + IA[b], db, a);
+    }
+   }
+  }
+  if (est){
+   est->estimate = est->lower = est->upper = closed / 3.0;
+   est->samples = W;
+   est->closed = closed;
+   est->wedges = W;
+  }
+  return closed / 3;
+ }
+#pragma omp parallel reduction(+:closed)
+ {
+  std::mt19937_64 gen(seed + 0x9e3779b97f4a7c15ULL * omp_get_thread_num());
+  std::uniform_int_distribution<uint32_t> pick(0, MAX(N, 1) - 1);
+  std::uniform_real_distribution<double> coin(0.0, 1.0);
+#pragma omp for schedule(static)
+  for (uint64_t s = 0; s < samples; s++){
+   uint32_t k = pick(gen);
+   uint32_t v = (coin(gen) < wedges->keep[k]) ? k : wedges->alias[k];
+   uint32_t d = IA[v+1] - IA[v];
+   uint32_t i = gen() % d;
+   uint32_t j = gen() % (d - 1);
+   j += (j >= i);
+   uint32_t a = JA[IA[v] + i], b = JA[IA[v] + j];
+   uint32_t da = IA[a+1] - IA[a], db = IA[b+1] - IA[b];
+   closed += (da <= db) ? sorted_find(JA + IA[a], da, b) :
+     sorted_find(JA + IA[b], db, a);
+  }
+ }
+
+ double estimate = 0.0, lower = 0.0, upper = 0.0;
+ if (samples){
+  double n = (double)samples;
+  double p = closed / n;
+  double z2 = z * z;
+  double center = (p + z2 / (2 * n)) / (1 + z2 / n);
+  double half = z / (1 + z2 / n) * sqrt(p * (1 - p) / n + z2 / (4 * n * n));
+  double scale = W / 3.0;
+  estimate = p * scale;
+  lower = MAX(center - half, 0.0) * scale;
+  upper = MIN(center + half, 1.0) * scale;
+ }
+ if (est){
+  est->estimate = estimate;
+  est->lower = lower;
+  est->upper = upper;
+  est->samples = samples;
+  est->closed = closed;
+  est->wedges = W;
+ }
+ return (uint64_t)llround(estimate);
+}
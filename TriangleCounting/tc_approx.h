@@ -0,0 +1,113 @@
+/*
+ * Graph Kernel Collection
+ *
+ * Copyright 2020 Carnegie Mellon University.
+ *
+ * NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ * INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON 
+ * UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR IMPLIED, 
+ * AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF FITNESS FOR 
+ * PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS OBTAINED FROM USE OF 
+ * THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES NOT MAKE ANY WARRANTY OF ANY
+ * KIND WITH RESPECT TO FREEDOM FROM PATENT, TRADEMARK, OR COPYRIGHT 
+ * INFRINGEMENT.
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or
+ * contact permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public
+ * release and unlimited distribution.  Please see Copyright notice for 
+ * non-US Government use and distribution.
+ *
+ * This Software includes and/or makes use of the following Third-Party
+ * Software subject to its own license:
+ *
+ * 1. Matrix Market Loader code (https://math.nist.gov/MatrixMarket/mmio-c.html).
+ *
+ *      The code made publicly available at nist.gov is not marked with a 
+ *      copyright notice and is therefore believed pursuant to section 105 of 
+ *      the Copyright Act, to not be entitled to domestic copyright protection 
+ *      under U.S. law and is therefore in the public domain.  Accordingly, it 
+ *      is believed that no license is required for its use.
+ *
+ * This Software may include certain portions of copyrighted code that is 
+ * initially being released only in binary form for validation and evaluation
+ * purposes. It is expected that source code will be released as open source at
+ * a future date. 
+ *
+ * DM20-0375
+ */
+ 
+#ifndef __TC_APPROX_H__
+#define __TC_APPROX_H__
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "utils.h"
+#include "graph.h"
+#include <omp.h>
+
+// Fraction of the wedges to sample, and the fewest samples to take unless
+// that is more than TC_MIN_SAMPLES_SHARE of the wedges.
+#ifndef TC_SAMPLE_RATE
+#define TC_SAMPLE_RATE 0.00001
+#endif
+
+#ifndef TC_MIN_SAMPLES
+#define TC_MIN_SAMPLES (1024*1024)
+#endif
+
+#ifndef TC_MIN_SAMPLES_SHARE
+#define TC_MIN_SAMPLES_SHARE 0.125
+#endif
+
+// Normal quantile of the confidence interval (2.576 for 99%).
+#ifndef TC_CONFIDENCE_Z
+#define TC_CONFIDENCE_Z 2.576
+#endif
+
+typedef struct {
+ double estimate;         // triangles
+ double lower;            // confidence interval on the count
+ double upper;
+ uint64_t samples;        // wedges sampled
+ uint64_t closed;         // of which closed by an edge
+ uint64_t wedges;         // wedges in the graph
+} tc_approx_t;
+
+// Wedge centers in proportion to deg(v) (deg(v) - 1) / 2, the wedges
+// (paths of length two) at each vertex, as a Walker alias table: slot k
+// keeps vertex k with probability keep[k] and gives alias[k] otherwise.
+typedef struct {
+ uint32_t N;
+ uint64_t total;          // wedges in the graph
+ double * keep;
+ uint32_t * alias;
+} tc_wedges_t;
+
+/*
+ * Build the wedge table of the full symmetric matrix in O(N). It only
+ * depends on IA and is shared by any number of tri_count_approx calls.
+ */
+tc_wedges_t * tc_wedges_build(uint32_t * IA, uint32_t N);
+
+void tc_wedges_free(tc_wedges_t * wedges);
+
+/*
+ * Estimate the triangle count of the full symmetric matrix (IA, JA), like
+ * tri_count, from samples wedges drawn uniformly at random: the center from
+ * the alias table and two distinct neighbors of it, checked for an edge by a
+ * binary search in the shorter neighborhood. Every triangle closes three
+ * wedges, so with p the closed fraction the estimate is p W / 3, and the
+ * interval is the Wilson score interval of p at normal quantile z, scaled
+ * the same way. The work is O(samples log(max degree)), independent of the
+ * edge count. Neighborhoods must be sorted. Each thread draws from its own
+ * generator seeded from seed, so results repeat for a given seed and thread
+ * count. With samples >= W every wedge is checked once instead, in
+ * O(W log(max degree)), and the count and interval are exact. est may be
+ * NULL.
+ */
+uint64_t tri_count_approx(uint32_t * IA, uint32_t * JA, uint32_t N,
+  const tc_wedges_t * wedges, uint64_t samples, double z, uint64_t seed,
+  tc_approx_t * est);
+#endif
@@ -0,0 +1,196 @@
+/*
+ * Graph Kernel Collection
+ *
+ * Copyright 2020 Carnegie Mellon University.
+ *
+ * NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ * INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON 
+ * UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR IMPLIED, 
+ * AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF FITNESS FOR 
+ * PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS OBTAINED FROM USE OF 
+ * THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES NOT MAKE ANY WARRANTY OF ANY
+ * KIND WITH RESPECT TO FREEDOM FROM PATENT, TRADEMARK, OR COPYRIGHT 
+ * INFRINGEMENT.
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or
+ * contact permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public
+ * release and unlimited distribution.  Please see Copyright notice for 
+ * non-US Government use and distribution.
+ *
+ * This Software includes and/or makes use of the following Third-Party
+ * Software subject to its own license:
+ *
+ * 1. Matrix Market Loader code (https://math.nist.gov/MatrixMarket/mmio-c.html).
+ *
+ *      The code made publicly available at nist.gov is not marked with a 
+ *      copyright notice and is therefore believed pursuant to section 105 of 
+ *      the Copyright Act, to not be entitled to domestic copyright protection 
+ *      under U.S. law and is therefore in the public domain.  Accordingly, it 
+ *      is believed that no license is required for its use.
+ *
+ * This Software may include certain portions of copyrighted code that is 
+ * initially being released only in binary form for validation and evaluation
+ * purposes. It is expected that source code will be released as open source at
+ * a future date. 
+ *
+ * DM20-0375
+ */
+ 
+#include "tc_clique.h"
+#include "tc_intersect.h"
+#include <vector>
+#include <algorithm>
+
+// Relabel the vertices by (degree, id) and keep the edges to higher
+// labels, sorted. Allocated here; returns the largest out-degree.
+static uint32_t degree_dag(uint32_t * IA, uint32_t * JA, uint32_t N,
+  uint32_t ** IAd, uint32_t ** JAd)
+{
+ std::vector<uint32_t> order(N), rank(N);
+#pragma omp parallel for schedule(static)
+ for (uint32_t v = 0; v < N; v++) order[v] = v;
+ std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b){
+  uint32_t da = IA[a+1] - IA[a], db = IA[b+1] - IA[b];
+  return da < db || (da == db && a < b);
+ });
+#pragma omp parallel for schedule(static)
+ for (uint32_t r = 0; r < N; r++) rank[order[r]] = r;
+
+ *IAd = (uint32_t *)malloc(((uint64_t)N + 1) * sizeof(uint32_t));
+ if (!*IAd){
+  fprintf(stderr, "ERROR: could not allocate degree ordered graph.\n");
+  exit(EXIT_FAILURE);
+ }
+ uint32_t * out = *IAd;
+ uint32_t max_out = 0;
+#pragma omp parallel for schedule(dynamic, 1024) reduction(max:max_out)
+ for (uint32_t r = 0; r < N; r++){
+  uint32_t u = order[r], n = 0;
+  for (uint32_t edx = IA[u]; edx < IA[u+1]; edx++){
+   n += (rank[JA[edx]] > r);
+  }
+  out[r+1] = n;
+  max_out = MAX(max_out, n);
+ }
+ out[0] = 0;
+ for (uint32_t r = 0; r < N; r++){
+  out[r+1] += out[r];
+ }
+ *JAd = (uint32_t *)malloc(MAX(out[N], 1) * sizeof(uint32_t));
+ if (!*JAd){
+  fprintf(stderr, "ERROR: could not allocate degree ordered graph.\n");
+  exit(EXIT_FAILURE);
+ }
+ uint32_t * JAo = *JAd;
+#pragma omp parallel for schedule(dynamic, 1024)
+ for (uint32_t r = 0; r < N; r++){
+  uint32_t u = order[r], pos = out[r];
+  for (uint32_t edx = IA[u]; edx < IA[u+1]; edx++){
+   if (rank[JA[edx]] > r) JAo[pos++] = rank[JA[edx]];
+  }
+  std::sort(JAo + out[r], JAo + pos);
+ }
+ return max_out;
+}
+
+// Cliques completed by choosing need more vertices from the n candidates
+// cand, all adjacent to every vertex chosen so far. Only the candidates
+// after v can follow it, so v's out-neighbors are intersected with those.
+// If bits is set cand is the whole out-neighborhood of a vertex, marked
+// there, and v's out-neighbors (all after v) are probed against it. buf
+// holds the candidates of the next levels, stride apart.
+static uint64_t extend(const uint32_t * IAd, const uint32_t * JAd,
+  const uint32_t * cand, uint32_t n, uint32_t need, uint32_t gallop_ratio,
+  const uint64_t * bits, uint32_t * buf, uint64_t stride,
+  uint64_t * merged, uint64_t * galloped)
+{
+ if (need == 1) return n;
+ uint64_t count = 0;
+ for (uint32_t i = 0; i + need <= n; i++){
+  uint32_t v = cand[i];
+  const uint32_t * lv = JAd + IAd[v];
+  uint32_t nv = IAd[v+1] - IAd[v];
+  if (nv < need - 1) continue;
+  const uint32_t * rest = cand + i + 1;
+  uint32_t nr = n - i - 1;
+  if (!bits) (*merged)++;
+  if (need == 2){
+   count += bits ? bitmap_probe<false>(bits, lv, nv, NULL) :
+     intersect_pair<false>(rest, nr, lv, nv, gallop_ratio, galloped, NULL);
+  } else {
+   uint32_t nn = bits ? bitmap_probe<true>(bits, lv, nv, buf) :
+     intersect_pair<true>(rest, nr, lv, nv, gallop_ratio, galloped, buf);
+   if (nn >= need - 1){
+    count += extend(IAd, JAd, buf, nn, need - 1, gallop_ratio, NULL,
+      buf + stride, stride, merged, galloped);
+   }
+  }
+ }
+ return count;
+}
+
+uint64_t clique_count(uint32_t * IA, uint32_t * JA, uint32_t N, uint32_t k,
+  const tc_hybrid_params_t * params, tc_hybrid_stats_t * stats)
+{
+ if (k < 1 || k > TC_MAX_CLIQUE){
+  fprintf(stderr, "ERROR: clique size %u is not in [1, %u].\n", k,
+    TC_MAX_CLIQUE);
+  exit(EXIT_FAILURE);
+ }
+ if (stats){
+  stats->merge = stats->gallop = stats->bitmap = 0;
+ }
+ if (k == 1) return N;
+
+ uint32_t * IAd, * JAd;
+ uint32_t max_out = degree_dag(IA, JA, N, &IAd, &JAd);
+ if (k == 2){
+  uint64_t edges = IAd[N];
+  free(IAd);
+  free(JAd);
+  return edges;
+ }
+
+ uint32_t gallop_ratio = MAX(params->gallop_ratio, 1);
+ uint32_t bitmap_degree = params->bitmap_degree;
+ uint64_t stride = (uint64_t)max_out + INTERSECT_PAD;
+ uint64_t count = 0, n_merge = 0, n_gallop = 0, n_bitmap = 0;
+#pragma omp parallel reduction(+:count, n_merge, n_gallop, n_bitmap)
+ {
+  std::vector<uint32_t> buf(k > 3 ? (k - 3) * stride : 1);
+  uint64_t * bits = NULL;
+  // A vertex with a large out-neighborhood can hold most of the work.
+#pragma omp for schedule(dynamic, 1)
+  for (uint32_t u = 0; u < N; u++){
+   const uint32_t * lu = JAd + IAd[u];
+   uint32_t nu = IAd[u+1] - IAd[u];
+   if (nu < k - 1) continue;
+   bool hub = (nu >= bitmap_degree);
+   if (hub){
+    if (!bits){
+     bits = (uint64_t *)calloc(N / 64 + 1, sizeof(uint64_t));
+     if (!bits){
+      fprintf(stderr, "ERROR: could not allocate bitmap.\n");
+      exit(EXIT_FAILURE);
+     }
+    }
+    bitmap_set(bits, lu, nu);
+    n_bitmap += nu;
+   }
+   count += extend(IAd, JAd, lu, nu, k - 1, gallop_ratio, hub ? bits : NULL,
+     buf.data(), stride, &n_merge, &n_gallop);
+   if (hub) bitmap_clear(bits, lu, nu);
+  }
+  free(bits);
+ }
+ free(IAd);
+ free(JAd);
+ if (stats){
+  stats->merge = n_merge - n_gallop;
+  stats->gallop = n_gallop;
+  stats->bitmap = n_bitmap;
+ }
+ return count;
+}
@@ -0,0 +1,72 @@
+/*
+ * Graph Kernel Collection
+ *
+ * Copyright 2020 Carnegie Mellon University.
+ *
+ * NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ * INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON 
+ * UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR IMPLIED, 
+ * AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF FITNESS FOR 
+ * PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS OBTAINED FROM USE OF 
+ * THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES NOT MAKE ANY WARRANTY OF ANY
+ * KIND WITH RESPECT TO FREEDOM FROM PATENT, TRADEMARK, OR COPYRIGHT 
+ * INFRINGEMENT.
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or
+ * contact permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public
+ * release and unlimited distribution.  Please see Copyright notice for 
+ * non-US Government use and distribution.
+ *
+ * This Software includes and/or makes use of the following Third-Party
+ * Software subject to its own license:
+ *
+ * 1. Matrix Market Loader code (https://math.nist.gov/MatrixMarket/mmio-c.html).
+ *
+ *      The code made publicly available at nist.gov is not marked with a 
+ *      copyright notice and is therefore believed pursuant to section 105 of 
+ *      the Copyright Act, to not be entitled to domestic copyright protection 
+ *      under U.S. law and is therefore in the public domain.  Accordingly, it 
+ *      is believed that no license is required for its use.
+ *
+ * This Software may include certain portions of copyrighted code that is 
+ * initially being released only in binary form for validation and evaluation
+ * purposes. It is expected that source code will be released as open source at
+ * a future date. 
+ *
+ * DM20-0375
+ */
+ 
+#ifndef __TC_CLIQUE_H__
+#define __TC_CLIQUE_H__
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "utils.h"
+#include "graph.h"
+#include "tc_hybrid.h"
+#include <omp.h>
+
+// Largest clique size clique_count accepts.
+#ifndef TC_MAX_CLIQUE
+#define TC_MAX_CLIQUE 16
+#endif
+
+/*
+ * Number of k-cliques of the full symmetric matrix (IA, JA); k = 3 is
+ * tri_count. The vertices are relabeled by (degree, id) and the edges
+ * oriented to the higher label, so every clique is found once from its
+ * lowest vertex and out-degrees stay small even at hubs. Each vertex
+ * starts with its out-neighbors as the candidates, and every level keeps
+ * the candidates also adjacent to the vertex just added, intersected like
+ * tri_count_hybrid does: the first level probes a per-thread bitmap of
+ * the start vertex's out-neighbors from params->bitmap_degree of them, the
+ * rest merge or gallop by params->gallop_ratio. The last level only
+ * counts. The candidate sets live in per-thread buffers of k - 3 levels,
+ * allocated once, and vertices are handed out one at a time. Neighborhoods
+ * must be sorted. stats may be NULL.
+ */
+uint64_t clique_count(uint32_t * IA, uint32_t * JA, uint32_t N, uint32_t k,
+  const tc_hybrid_params_t * params, tc_hybrid_stats_t * stats);
+#endif
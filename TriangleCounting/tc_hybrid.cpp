@@ -0,0 +1,350 @@
+/*
+ * Graph Kernel Collection
+ *
+ * Copyright 2020 Carnegie Mellon University.
+ *
+ * NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ * INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON 
+ * UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR IMPLIED, 
+ * AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF FITNESS FOR 
+ * PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS OBTAINED FROM USE OF 
+ * THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES NOT MAKE ANY WARRANTY OF ANY
+ * KIND WITH RESPECT TO FREEDOM FROM PATENT, TRADEMARK, OR COPYRIGHT 
+ * INFRINGEMENT.
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or
+ * contact permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public
+ * release and unlimited distribution.  Please see Copyright notice for 
+ * non-US Government use and distribution.
+ *
+ * This Software includes and/or makes use of the following Third-Party
+ * Software subject to its own license:
+ *
+ * 1. Matrix Market Loader code (https://math.nist.gov/MatrixMarket/mmio-c.html).
+ *
+ *      The code made publicly available at nist.gov is not marked with a 
+ *      copyright notice and is therefore believed pursuant to section 105 of 
+ *      the Copyright Act, to not be entitled to domestic copyright protection 
+ *      under U.S. law and is therefore in the public domain.  Accordingly, it 
+ *      is believed that no license is required for its use.
+ *
+ * This Software may include certain portions of copyrighted code that is 
+ * initially being released only in binary form for validation and evaluation
+ * purposes. It is expected that source code will be released as open source at
+ * a future date. 
+ *
+ * DM20-0375
+ */
+ 
+#include "tc_hybrid.h"
+#include "tc_intersect.h"
+#include <random>
+#include <vector>
+#include <algorithm>
+
+// Calibration lists: short lists of the average degree, long ones up to
+// this many times longer, and hub lists up to this length.
+#define CAL_MAX_RATIO 1024
+#define CAL_MAX_HUB (64*1024)
+#define CAL_PROBES (256*1024)
+
+// Sorted list of n distinct ids below N.
+static std::vector<uint32_t> random_list(std::mt19937 & gen, uint32_t n,
+  uint32_t N)
+{
+ std::uniform_int_distribution<uint32_t> pick(0, N - 1);
+ std::vector<uint32_t> list(n);
+ for (uint32_t i = 0; i < n; i++) list[i] = pick(gen);
+ std::sort(list.begin(), list.end());
+ list.erase(std::unique(list.begin(), list.end()), list.end());
+ return list;
+}
+
+tc_hybrid_params_t tc_hybrid_calibrate(uint32_t * IA, uint32_t N){
+ tc_hybrid_params_t params = {TC_GALLOP_RATIO, TC_BITMAP_DEGREE};
+ if (params.gallop_ratio && params.bitmap_degree) return params;
+ std::mt19937 gen(27491095);
+ // Lower-triangle lists are half the average degree.
+ uint32_t universe = MAX(N, 2);
+ uint32_t short_len = MAX(1, (uint32_t)(IA[N] / MAX(2 * (uint64_t)N, 1)));
+ short_len = MIN(short_len, universe / (2 * CAL_MAX_RATIO) + 1);
+ volatile uint64_t sink = 0;
+
+ if (!params.gallop_ratio){
+  params.gallop_ratio = CAL_MAX_RATIO;
+  std::vector<uint32_t> a = random_list(gen, short_len, universe);
+  for (uint32_t ratio = 2; ratio <= CAL_MAX_RATIO; ratio *= 2){
+   std::vector<uint32_t> b = random_list(gen,
+     MIN((uint64_t)short_len * ratio, universe), universe);
+   uint32_t reps = MAX(1, CAL_PROBES / (uint32_t)b.size());
+   double st = omp_get_wtime();
+   for (uint32_t r = 0; r < reps; r++){
+    sink += intersect_merge_count(a.data(), a.size(), b.data(), b.size());
+   }
+   double t_merge = omp_get_wtime() - st;
+   st = omp_get_wtime();
+   for (uint32_t r = 0; r < reps; r++){
+    sink += intersect_gallop_count(a.data(), a.size(), b.data(),
+      b.size());
+   }
+   double t_gallop = omp_get_wtime() - st;
+   if (t_gallop < t_merge){
+    params.gallop_ratio = ratio;
+    break;
+   }
+  }
+ }
+
+ if (!params.bitmap_degree){
+  params.bitmap_degree = UINT32_MAX;
+  uint64_t * bits = (uint64_t *)calloc(universe / 64 + 1, sizeof(uint64_t));
+  if (!bits){
+   fprintf(stderr, "ERROR: could not allocate calibration bitmap.\n");
+   exit(EXIT_FAILURE);
+  }
+  // A hub u is intersected with one short list per lower neighbor.
+  std::vector<std::vector<uint32_t> > others(64);
+  for (uint32_t k = 0; k < others.size(); k++){
+   others[k] = random_list(gen, short_len, universe);
+  }
+  for (uint32_t hub = 2 * short_len; hub <= CAL_MAX_HUB && hub <= universe;
+       hub *= 2){
+   std::vector<uint32_t> a = random_list(gen, hub, universe);
+   uint64_t unused = 0;
+   uint32_t reps = MAX(1, CAL_PROBES / hub);
+   double st = omp_get_wtime();
+   for (uint32_t r = 0; r < reps; r++){
+    for (uint32_t i = 0; i < a.size(); i++){
+     const std::vector<uint32_t> & b = others[i % others.size()];
+     sink += intersect_pair<false>(a.data(), a.size(), b.data(), b.size(),
+       params.gallop_ratio, &unused, NULL);
+    }
+   }
+   double t_pair = omp_get_wtime() - st;
+   st = omp_get_wtime();
+   for (uint32_t r = 0; r < reps; r++){
+    bitmap_set(bits, a.data(), a.size());
+    for (uint32_t i = 0; i < a.size(); i++){
+     const std::vector<uint32_t> & b = others[i % others.size()];
+     sink += bitmap_probe<false>(bits, b.data(), b.size(), NULL);
+    }
+    bitmap_clear(bits, a.data(), a.size());
+   }
+   double t_bitmap = omp_get_wtime() - st;
+   if (t_bitmap < t_pair){
+    params.bitmap_degree = hub;
+    break;
+   }
+  }
+  free(bits);
+ }
+ (void)sink;
+ if (TC_GALLOP_RATIO) params.gallop_ratio = TC_GALLOP_RATIO;
+ if (TC_BITMAP_DEGREE) params.bitmap_degree = TC_BITMAP_DEGREE;
+ return params;
+}
+
+// Lower triangle of the full matrix, allocated here.
+static void lower_triangle(uint32_t * IA, uint32_t * JA, uint32_t N,
+  uint32_t ** IAl, uint32_t ** JAl)
+{
+ uint64_t M_lower = 0;
+#pragma omp parallel for schedule(dynamic, 1024) reduction(+:M_lower)
+ for (uint32_t u = 0; u < N; u++){
+  for (uint32_t edx = IA[u]; edx < IA[u+1] && JA[edx] < u; edx++){
+   M_lower++;
+  }
+ }
+ *IAl = (uint32_t *)malloc((N+1) * sizeof(uint32_t));
+ *JAl = (uint32_t *)malloc(MAX(M_lower, 1) * sizeof(uint32_t));
+ if (!*IAl || !*JAl){
+  fprintf(stderr, "ERROR: could not allocate lower triangle.\n");
+  exit(EXIT_FAILURE);
+ }
+ csr_to_lower(IA, JA, *IAl, *JAl, N);
+}
+
+// Where per-vertex counts go: the hot vertices (hot_idx[v] != UINT32_MAX)
+// into a per-thread array, merged once at the end, everything else into
+// tri with an atomic add.
+typedef struct {
+ uint64_t * tri;
+ const uint32_t * hot_idx;
+ uint32_t num_hot;
+} credit_t;
+
+static inline void credit(const credit_t * cr, uint64_t * local, uint32_t x,
+  uint64_t c)
+{
+ uint32_t h = cr->hot_idx[x];
+ if (h != UINT32_MAX) local[h] += c;
+ else __sync_fetch_and_add(&cr->tri[x], c);
+}
+
+/*
+ * Shared loop of tri_count_hybrid and tri_count_per_vertex. With
+ * PER_VERTEX every triangle w < v < u found while intersecting L(u) and
+ * L(v) is credited to all three corners: u and v once per pair, w as it
+ * is matched.
+ */
+template <bool PER_VERTEX>
+static uint64_t hybrid_kernel(const uint32_t * IAl, const uint32_t * JAl,
+  uint32_t N, const tc_hybrid_params_t * params, tc_hybrid_stats_t * stats,
+  const credit_t * cr)
+{
+ uint32_t gallop_ratio = MAX(params->gallop_ratio, 1);
+ uint32_t bitmap_degree = params->bitmap_degree;
+ uint32_t num_hot = PER_VERTEX ? cr->num_hot : 0;
+ uint32_t num_threads = omp_get_max_threads();
+ uint32_t max_lower = 0;
+ if (PER_VERTEX){
+#pragma omp parallel for reduction(max:max_lower)
+  for (uint32_t u = 0; u < N; u++){
+   max_lower = MAX(max_lower, IAl[u+1] - IAl[u]);
+  }
+ }
+ uint64_t * hot_counts = NULL;
+ if (PER_VERTEX){
+  hot_counts = (uint64_t *)calloc(MAX((uint64_t)num_hot * num_threads, 1),
+    sizeof(uint64_t));
+  if (!hot_counts){
+   fprintf(stderr, "ERROR: could not allocate per-thread counts.\n");
+   exit(EXIT_FAILURE);
+  }
+ }
+ uint64_t count = 0, n_merge = 0, n_gallop = 0, n_bitmap = 0;
+#pragma omp parallel num_threads(num_threads) \
+  reduction(+:count, n_merge, n_gallop, n_bitmap)
+ {
+  // Only threads that meet a hub pay for the bitmap.
+  uint64_t * bits = NULL;
+  uint64_t * local = PER_VERTEX ?
+    hot_counts + (uint64_t)omp_get_thread_num() * num_hot : NULL;
+  // Common neighbors of the current pair, at most the longest lower list.
+  std::vector<uint32_t> matches(PER_VERTEX ? max_lower + INTERSECT_PAD : 0);
+#pragma omp for schedule(dynamic, 64)
+  for (uint32_t u = 0; u < N; u++){
+   const uint32_t * lu = JAl + IAl[u];
+   uint32_t nu = IAl[u+1] - IAl[u];
+   uint64_t tri_u = 0;
+   bool hub = (nu >= bitmap_degree);
+   if (hub){
+    if (!bits){
+     bits = (uint64_t *)calloc(N / 64 + 1, sizeof(uint64_t));
+     if (!bits){
+      fprintf(stderr, "ERROR: could not allocate bitmap.\n");
+      exit(EXIT_FAILURE);
+     }
+    }
+    bitmap_set(bits, lu, nu);
+    n_bitmap += nu;
+   } else {
+    n_merge += nu;
+   }
+   for (uint32_t i = 0; i < nu; i++){
+    uint32_t v = lu[i];
+    const uint32_t * lv = JAl + IAl[v];
+    uint32_t nv = IAl[v+1] - IAl[v];
+    uint64_t c;
+    if (PER_VERTEX){
+     uint32_t * out = matches.data();
+     c = hub ? bitmap_probe<true>(bits, lv, nv, out) :
+       intersect_pair<true>(lu, nu, lv, nv, gallop_ratio, &n_gallop, out);
+     for (uint64_t k = 0; k < c; k++){
+      credit(cr, local, out[k], 1);
+     }
+     if (c) credit(cr, local, v, c);
+    } else {
+     c = hub ? bitmap_probe<false>(bits, lv, nv, NULL) :
+       intersect_pair<false>(lu, nu, lv, nv, gallop_ratio, &n_gallop, NULL);
+    }
+    tri_u += c;
+   }
+   if (hub) bitmap_clear(bits, lu, nu);
+   if (PER_VERTEX && tri_u) credit(cr, local, u, tri_u);
+   count += tri_u;
+  }
+  free(bits);
+ }
+ if (PER_VERTEX){
+  // Hot vertex h is stored in slot h of every thread's array.
+  std::vector<uint32_t> hot_v(num_hot);
+  for (uint32_t v = 0; v < N; v++){
+   if (cr->hot_idx[v] != UINT32_MAX) hot_v[cr->hot_idx[v]] = v;
+  }
+#pragma omp parallel for schedule(static)
+  for (uint32_t h = 0; h < num_hot; h++){
+   uint64_t sum = 0;
+   for (uint32_t t = 0; t < num_threads; t++){
+    sum += hot_counts[(uint64_t)t * num_hot + h];
+   }
+   cr->tri[hot_v[h]] += sum;
+  }
+  free(hot_counts);
+ }
+ if (stats){
+  stats->merge = n_merge - n_gallop;
+  stats->gallop = n_gallop;
+  stats->bitmap = n_bitmap;
+ }
+ return count;
+}
+
+uint64_t tri_count_hybrid(uint32_t * IA, uint32_t * JA, uint32_t N,
+  const tc_hybrid_params_t * params, tc_hybrid_stats_t * stats)
+{
+ uint32_t * IAl, * JAl;
+ lower_triangle(IA, JA, N, &IAl, &JAl);
+ uint64_t count = hybrid_kernel<false>(IAl, JAl, N, params, stats, NULL);
+ free(IAl);
+ free(JAl);
+ return count;
+}
+
+uint64_t tri_count_per_vertex(uint32_t * IA, uint32_t * JA, uint32_t N,
+  const tc_hybrid_params_t * params, uint64_t * tri, double * lcc,
+  tc_hybrid_stats_t * stats)
+{
+ uint32_t * IAl, * JAl;
+ lower_triangle(IA, JA, N, &IAl, &JAl);
+
+ // The highest-degree vertices take the most credits from other threads.
+ uint32_t num_hot = MIN((uint32_t)TC_HOT_VERTICES, N);
+ uint32_t * hot_idx = (uint32_t *)malloc(MAX(N, 1) * sizeof(uint32_t));
+ if (!hot_idx){
+  fprintf(stderr, "ERROR: could not allocate hot vertex map.\n");
+  exit(EXIT_FAILURE);
+ }
+ std::vector<uint32_t> by_degree(N);
+#pragma omp parallel for
+ for (uint32_t v = 0; v < N; v++){
+  by_degree[v] = v;
+  hot_idx[v] = UINT32_MAX;
+  tri[v] = 0;
+ }
+ std::nth_element(by_degree.begin(), by_degree.begin() + num_hot,
+   by_degree.end(), [&](uint32_t a, uint32_t b){
+    uint32_t da = IA[a+1] - IA[a], db = IA[b+1] - IA[b];
+    return da > db || (da == db && a < b);
+   });
+ for (uint32_t h = 0; h < num_hot; h++){
+  hot_idx[by_degree[h]] = h;
+ }
+
+ credit_t cr = {tri, hot_idx, num_hot};
+ uint64_t count = hybrid_kernel<true>(IAl, JAl, N, params, stats, &cr);
+ free(hot_idx);
+ free(IAl);
+ free(JAl);
+
+ if (lcc){
+#pragma omp parallel for schedule(static)
+  for (uint32_t v = 0; v < N; v++){
+   uint64_t deg = IA[v+1] - IA[v];
+   lcc[v] = (deg < 2) ? 0.0 : (2.0 * tri[v]) / (double)(deg * (deg - 1));
+  }
+ }
+ return count;
+}
@@ -0,0 +1,112 @@
+/*
+ * Graph Kernel Collection
+ *
+ * Copyright 2020 Carnegie Mellon University.
+ *
+ * NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ * INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON 
+ * UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR IMPLIED, 
+ * AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF FITNESS FOR 
+ * PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS OBTAINED FROM USE OF 
+ * THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES NOT MAKE ANY WARRANTY OF ANY
+ * KIND WITH RESPECT TO FREEDOM FROM PATENT, TRADEMARK, OR COPYRIGHT 
+ * INFRINGEMENT.
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or
+ * contact permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public
+ * release and unlimited distribution.  Please see Copyright notice for 
+ * non-US Government use and distribution.
+ *
+ * This Software includes and/or makes use of the following Third-Party
+ * Software subject to its own license:
+ *
+ * 1. Matrix Market Loader code (https://math.nist.gov/MatrixMarket/mmio-c.html).
+ *
+ *      The code made publicly available at nist.gov is not marked with a 
+ *      copyright notice and is therefore believed pursuant to section 105 of 
+ *      the Copyright Act, to not be entitled to domestic copyright protection 
+ *      under U.S. law and is therefore in the public domain.  Accordingly, it 
+ *      is believed that no license is required for its use.
+ *
+ * This Software may include certain portions of copyrighted code that is 
+ * initially being released only in binary form for validation and evaluation
+ * purposes. It is expected that source code will be released as open source at
+ * a future date. 
+ *
+ * DM20-0375
+ */
+ 
+#ifndef __TC_HYBRID_H__
+#define __TC_HYBRID_H__
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "utils.h"
+#include "graph.h"
+#include <omp.h>
+
+// Fixed thresholds; 0 has tc_hybrid_calibrate time them instead.
+#ifndef TC_GALLOP_RATIO
+#define TC_GALLOP_RATIO 0
+#endif
+
+#ifndef TC_BITMAP_DEGREE
+#define TC_BITMAP_DEGREE 0
+#endif
+
+// Vertices whose per-vertex counts are kept per thread instead of updated
+// atomically (the highest-degree ones).
+#ifndef TC_HOT_VERTICES
+#define TC_HOT_VERTICES 4096
+#endif
+
+typedef struct {
+ uint32_t gallop_ratio;   // gallop when the longer list is this many times
+                          // the shorter one
+ uint32_t bitmap_degree;  // mark the list of u in a bitmap from this length
+} tc_hybrid_params_t;
+
+typedef struct {
+ uint64_t merge;          // intersections of each kind
+ uint64_t gallop;
+ uint64_t bitmap;
+} tc_hybrid_stats_t;
+
+/*
+ * Pick the thresholds for tri_count_hybrid by timing the three methods on
+ * random sorted lists drawn from N ids at the graph's average degree:
+ * gallop_ratio is the smallest length ratio at which galloping beats the
+ * merge, and bitmap_degree the smallest hub list length at which marking
+ * it in an N-bit bitmap and probing the neighbor lists beats the best of
+ * the two. TC_GALLOP_RATIO / TC_BITMAP_DEGREE, if set, are used as given.
+ */
+tc_hybrid_params_t tc_hybrid_calibrate(uint32_t * IA, uint32_t N);
+
+/*
+ * Triangle count of the full symmetric matrix (IA, JA), like tri_count.
+ *
+ * The lower triangle L is taken with csr_to_lower, and every edge v < u
+ * adds |L(u) & L(v)|. The intersection method is chosen per pair: a u with
+ * at least bitmap_degree lower neighbors is marked in a per-thread bitmap
+ * once, and each L(v) is probed against it; otherwise lists whose lengths
+ * differ by gallop_ratio or more are intersected by galloping the shorter
+ * one through the longer, and the rest by a merge. Neighborhoods must be
+ * sorted. stats may be NULL.
+ */
+uint64_t tri_count_hybrid(uint32_t * IA, uint32_t * JA, uint32_t N,
+  const tc_hybrid_params_t * params, tc_hybrid_stats_t * stats);
+
+/*
+ * tri_count_hybrid that also fills tri[v] with the triangles at each
+ * vertex and, if lcc is not NULL, lcc[v] with the local clustering
+ * coefficient 2 tri[v] / (deg(v) (deg(v) - 1)) (0 below degree 2); both
+ * hold N entries. The counts are taken in the same intersection loop: the
+ * TC_HOT_VERTICES highest-degree vertices accumulate in per-thread arrays
+ * summed at the end, the rest with atomic adds. Returns the total.
+ */
+uint64_t tri_count_per_vertex(uint32_t * IA, uint32_t * JA, uint32_t N,
+  const tc_hybrid_params_t * params, uint64_t * tri, double * lcc,
+  tc_hybrid_stats_t * stats);
+#endif
@@ -0,0 +1,100 @@
+/*
+ * Graph Kernel Collection
+ *
+ * Copyright 2020 Carnegie Mellon University.
+ *
+ * NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ * INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON 
+ * UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR IMPLIED, 
+ * AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF FITNESS FOR 
+ * PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS OBTAINED FROM USE OF 
+ * THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES NOT MAKE ANY WARRANTY OF ANY
+ * KIND WITH RESPECT TO FREEDOM FROM PATENT, TRADEMARK, OR COPYRIGHT 
+ * INFRINGEMENT.
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or
+ * contact permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public
+ * release and unlimited distribution.  Please see Copyright notice for 
+ * non-US Government use and distribution.
+ *
+ * This Software includes and/or makes use of the following Third-Party
+ * Software subject to its own license:
+ *
+ * 1. Matrix Market Loader code (https://math.nist.gov/MatrixMarket/mmio-c.html).
+ *
+ *      The code made publicly available at nist.gov is not marked with a 
+ *      copyright notice and is therefore believed pursuant to section 105 of 
+ *      the Copyright Act, to not be entitled to domestic copyright protection 
+ *      under U.S. law and is therefore in the public domain.  Accordingly, it 
+ *      is believed that no license is required for its use.
+ *
+ * This Software may include certain portions of copyrighted code that is 
+ * initially being released only in binary form for validation and evaluation
+ * purposes. It is expected that source code will be released as open source at
+ * a future date. 
+ *
+ * DM20-0375
+ */
+ 
+#ifndef __TC_INTERSECT_H__
+#define __TC_INTERSECT_H__
+#include <stdint.h>
+#include <algorithm>
+#include "utils.h"
+#include "intersect.h"
+
+// Intersections shared by the triangle and clique kernels: the merge and
+// galloping kernels of common/intersect.h, and a bitmap of one list that
+// the other is probed against. With EMIT they also write the common ids to
+// out, which needs room for the shorter list plus INTERSECT_PAD.
+
+static inline void bitmap_set(uint64_t * bits, const uint32_t * a,
+  uint32_t n)
+{
+ for (uint32_t i = 0; i < n; i++){
+  bits[a[i] >> 6] |= 1ull << (a[i] & 63);
+ }
+}
+
+static inline void bitmap_clear(uint64_t * bits, const uint32_t * a,
+  uint32_t n)
+{
+ for (uint32_t i = 0; i < n; i++){
+  bits[a[i] >> 6] = 0;
+ }
+}
+
+// Every id of b is stored and the position only advances on a hit, so the
+// loop has no branches on the data.
+template <bool EMIT>
+static inline uint64_t bitmap_probe(const uint64_t * bits,
+  const uint32_t * b, uint32_t n, uint32_t * out)
+{
+ uint64_t count = 0;
+ for (uint32_t i = 0; i < n; i++){
+  if (EMIT) out[count] = b[i];
+  count += (bits[b[i] >> 6] >> (b[i] & 63)) & 1;
+ }
+ return count;
+}
+
+template <bool EMIT>
+static inline uint64_t intersect_pair(const uint32_t * a, uint32_t na,
+  const uint32_t * b, uint32_t nb, uint32_t gallop_ratio, uint64_t * galloped,
+  uint32_t * out)
+{
+ if (na > nb){
+  std::swap(a, b);
+  std::swap(na, nb);
+ }
+ if ((uint64_t)na * gallop_ratio <= nb){
+  (*galloped)++;
+  return EMIT ? intersect_gallop(a, na, b, nb, out) :
+    intersect_gallop_count(a, na, b, nb);
+ }
+ return EMIT ? intersect_merge(a, na, b, nb, out) :
+   intersect_merge_count(a, na, b, nb);
+}
+#endif
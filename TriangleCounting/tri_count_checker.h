@@ -41,6 +41,13 @@
 #include "stdint.h"
 #include "string.h"
 #include "stdio.h"
+#include "utils.h"
+#include <omp.h>
+#include <vector>
+#include <algorithm>
+
+// -DTC_VERIFY_TABLE takes the reference total of the five GAP graphs from
+// the table below instead of recounting it.
 
 char * filenames[5] = {"road_symm_ia", "web_symm_ia", "twitter_symm_ia", "kron_symm_ia", "urand_symm_ia"};
 uint64_t tri_counts[5] = {438804, 84907041475, 34824916864, 106873365648, 5378};
@@ -55,3 +62,194 @@ bool check_tri_count(uint64_t delta, char* func_name){
 
   return passed;
 }
+
+// The known count of func_name, if there is one.
+bool known_tri_count(char* func_name, uint64_t* count){
+
+  for (int i = 0; i != 5; ++i){
+    if (strcmp(func_name, filenames[i]) == 0){
+      *count = tri_counts[i];
+      return true;
+    }
+  }
+  return false;
+}
+
+// Whether an approximate count's confidence interval [lower, upper] holds
+// the exact count, with the relative error of estimate printed.
+bool check_tri_count_approx(double estimate, double lower, double upper,
+  uint64_t exact){
+
+  printf("Exact %lu, estimate off by %f%%\n", exact,
+    exact ? 100.0 * (estimate - (double)exact) / exact : 0.0);
+  return lower <= (double)exact && (double)exact <= upper;
+}
+
+// Exact triangle count by a parallel hash-based node iterator, written
+// apart from the kernels it checks: every edge is oriented towards the
+// higher (degree, id), the out-neighbors of each v go into an
+// open-addressing hash table, and each out-neighbor w of an out-neighbor u
+// found there closes the triangle v, u, w. If tri is not NULL it receives
+// the triangles at each vertex, summed per source and per table entry
+// before one atomic add each.
+uint64_t tri_count_hash(uint32_t * IA, uint32_t * JA, uint32_t N,
+  uint64_t * tri){
+
+  std::vector<uint32_t> OA(N + 1, 0);
+#pragma omp parallel for schedule(dynamic, 1024)
+  for (uint32_t v = 0; v < N; v++){
+    uint32_t dv = IA[v+1] - IA[v], out = 0;
+    for (uint32_t e = IA[v]; e < IA[v+1]; e++){
+      uint32_t w = JA[e], dw = IA[w+1] - IA[w];
+      out += (dw > dv || (dw == dv && w > v));
+    }
+    OA[v+1] = out;
+  }
+  uint32_t max_out = 0;
+  for (uint32_t v = 0; v < N; v++){
+    max_out = std::max(max_out, OA[v+1]);
+    OA[v+1] += OA[v];
+  }
+  std::vector<uint32_t> OJ(MAX(OA[N], 1));
+#pragma omp parallel for schedule(dynamic, 1024)
+  for (uint32_t v = 0; v < N; v++){
+    uint32_t dv = IA[v+1] - IA[v], o = OA[v];
+    for (uint32_t e = IA[v]; e < IA[v+1]; e++){
+      uint32_t w = JA[e], dw = IA[w+1] - IA[w];
+      if (dw > dv || (dw == dv && w > v)) OJ[o++] = w;
+    }
+  }
+  if (tri){
+#pragma omp parallel for schedule(static)
+    for (uint32_t v = 0; v < N; v++) tri[v] = 0;
+  }
+
+  // Tables at most half full, so probes stay short.
+  uint32_t bits = 1;
+  while (bits < 31 && (1u << bits) < 2 * max_out) bits++;
+  uint32_t mask = (1u << bits) - 1;
+  uint64_t total = 0;
+#pragma omp parallel reduction(+:total)
+  {
+    // Entries hold the vertex in the high word and its list position in
+    // the low one; empty ones are all ones.
+    std::vector<uint64_t> table(mask + 1, UINT64_MAX);
+    std::vector<uint32_t> slot(max_out + 1), hits(max_out + 1);
+#pragma omp for schedule(dynamic, 64)
+    for (uint32_t v = 0; v < N; v++){
+      uint32_t b = OA[v], d = OA[v+1] - OA[v];
+      if (d < 2) continue;
+      for (uint32_t j = 0; j < d; j++){
+        uint32_t w = OJ[b+j];
+        uint32_t h = (uint32_t)(w * 2654435761u) >> (32 - bits);
+        while (table[h] != UINT64_MAX) h = (h + 1) & mask;
+        table[h] = ((uint64_t)w << 32) | j;
+        slot[j] = h;
+        hits[j] = 0;
+      }
+      uint64_t at_v = 0;
+      for (uint32_t j = 0; j < d; j++){
+        uint32_t u = OJ[b+j], at_u = 0;
+        for (uint32_t f = OA[u]; f < OA[u+1]; f++){
+          uint32_t w = OJ[f];
+          uint32_t h = (uint32_t)(w * 2654435761u) >> (32 - bits);
+          uint64_t t;
+          while ((t = table[h]) != UINT64_MAX){
+            if ((uint32_t)(t >> 32) == w){
+              at_u++;
+              hits[(uint32_t)t]++;
+              break;
+            }
+            h = (h + 1) & mask;
+          }
+        }
+        at_v += at_u;
+        if (tri && at_u){
+#pragma omp atomic
+          tri[u] += at_u;
+        }
+      }
+      total += at_v;
+      if (tri && at_v){
+#pragma omp atomic
+        tri[v] += at_v;
+        for (uint32_t j = 0; j < d; j++){
+          if (hits[j]){
+#pragma omp atomic
+            tri[OJ[b+j]] += hits[j];
+          }
+        }
+      }
+      for (uint32_t j = 0; j < d; j++) table[slot[j]] = UINT64_MAX;
+    }
+  }
+  return total;
+}
+
+// The triangle count to check func_name's kernels against: recounted by
+// tri_count_hash, and compared with the table when func_name is in it.
+uint64_t tri_count_reference(uint32_t * IA, uint32_t * JA, uint32_t N,
+  char* func_name){
+
+  uint64_t known = 0;
+  bool in_table = known_tri_count(func_name, &known);
+#ifdef TC_VERIFY_TABLE
+  if (in_table) return known;
+#endif
+  double st = omp_get_wtime();
+  uint64_t count = tri_count_hash(IA, JA, N, NULL);
+  printf("Reference: %lu triangles by hash recount in %f seconds\n", count,
+    omp_get_wtime() - st);
+  if (in_table && count != known){
+    printf("WARNING: %s should have %lu triangles\n", func_name, known);
+  }
+  return count;
+}
+
+// Per-vertex triangle counts recounted by tri_count_hash, compared with tri.
+bool check_tri_per_vertex(uint32_t * IA, uint32_t * JA, uint32_t N,
+  uint64_t * tri){
+
+  std::vector<uint64_t> ref(MAX(N, 1));
+  tri_count_hash(IA, JA, N, ref.data());
+
+  uint32_t num_errors = 0;
+  for (uint32_t v = 0; v < N; v++){
+    if (ref[v] != tri[v]){
+      if (num_errors < 10){
+        printf("%u: %lu != %lu\n", v, tri[v], ref[v]);
+      }
+      num_errors++;
+    }
+  }
+  if (num_errors) printf("%u mismatched per-vertex counts\n", num_errors);
+  return num_errors == 0;
+}
+
+// k-cliques containing the chosen vertices and completed from cand, all
+// of whose ids are above the last chosen one.
+uint64_t clique_extend_serial(uint32_t * IA, uint32_t * JA,
+  const std::vector<uint32_t> & cand, uint32_t need){
+
+  if (need == 0) return 1;
+  if (need == 1) return cand.size();
+  uint64_t count = 0;
+  for (size_t i = 0; i < cand.size(); i++){
+    uint32_t v = cand[i];
+    std::vector<uint32_t> next;
+    std::set_intersection(cand.begin() + i + 1, cand.end(),
+      JA + IA[v], JA + IA[v+1], std::back_inserter(next));
+    count += clique_extend_serial(IA, JA, next, need - 1);
+  }
+  return count;
+}
+
+// Serial k-clique count over the full symmetric matrix, each clique found
+// once from its lowest id.
+uint64_t clique_count_serial(uint32_t * IA, uint32_t * JA, uint32_t N,
+  uint32_t k){
+
+  std::vector<uint32_t> all(N);
+  for (uint32_t v = 0; v < N; v++) all[v] = v;
+  return clique_extend_serial(IA, JA, all, k);
+}
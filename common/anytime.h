@@ -0,0 +1,108 @@
+/*
+ * Graph Kernel Collection
+ *
+ * Copyright 2020 Carnegie Mellon University.
+ *
+ * NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ * INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON 
+ * UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR IMPLIED, 
+ * AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF FITNESS FOR 
+ * PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS OBTAINED FROM USE OF 
+ * THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES NOT MAKE ANY WARRANTY OF ANY
+ * KIND WITH RESPECT TO FREEDOM FROM PATENT, TRADEMARK, OR COPYRIGHT 
+ * INFRINGEMENT.
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or
+ * contact permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public
+ * release and unlimited distribution.  Please see Copyright notice for 
+ * non-US Government use and distribution.
+ *
+ * This Software includes and/or makes use of the following Third-Party
+ * Software subject to its own license:
+ *
+ * 1. Matrix Market Loader code (https://math.nist.gov/MatrixMarket/mmio-c.html).
+ *
+ *      The code made publicly available at nist.gov is not marked with a 
+ *      copyright notice and is therefore believed pursuant to section 105 of 
+ *      the Copyright Act, to not be entitled to domestic copyright protection 
+ *      under U.S. law and is therefore in the public domain.  Accordingly, it 
+ *      is believed that no license is required for its use.
+ *
+ * This Software may include certain portions of copyrighted code that is 
+ * initially being released only in binary form for validation and evaluation
+ * purposes. It is expected that source code will be released as open source at
+ * a future date. 
+ *
+ * DM20-0375
+ */
+ 
+#ifndef ANYTIME_H
+#define ANYTIME_H
+
+#include <stdint.h>
+#include <omp.h>
+
+/*
+ * Control block for anytime kernels.
+ *
+ * A kernel that takes an anytime_t polls it at points where it can stop with
+ * a usable result (ranks, tentative distances, partial centralities) and
+ * reports its progress and current error bound between steps. The meaning of
+ * err_bound is kernel specific and documented with each kernel. Passing NULL
+ * runs the kernel to completion.
+ *
+ * Kernels poll from inside their parallel loops (every few dozen vertices),
+ * so a deadline is honored within one chunk of work rather than one
+ * iteration, and the stop is not delayed by a slow progress callback.
+ */
+
+// Called between kernel steps with progress in [0, 1] and the current error
+// bound. Return false to stop the kernel. Called from a single thread.
+typedef bool (*anytime_cb_t)(double progress, double err_bound, void * ctx);
+
+typedef struct {
+ double deadline;       // omp_get_wtime() value to stop at, 0 for none
+ volatile bool cancel;  // set by any thread to stop the kernel
+ anytime_cb_t progress; // may be NULL
+ void * ctx;
+ // Filled in by the kernel:
+ bool completed;        // ran to convergence/completion
+ double err_bound;      // error bound of the returned result
+} anytime_t;
+
+// budget_sec <= 0 means no deadline.
+inline void anytime_init(anytime_t * ctl, double budget_sec,
+  anytime_cb_t progress, void * ctx)
+{
+ ctl->deadline = budget_sec > 0 ? omp_get_wtime() + budget_sec : 0;
+ ctl->cancel = false;
+ ctl->progress = progress;
+ ctl->ctx = ctx;
+ ctl->completed = false;
+ ctl->err_bound = 0;
+}
+
+// True once the kernel should stop. Safe to call from any thread.
+inline bool anytime_expired(anytime_t * ctl){
+ if (ctl == NULL) return false;
+ if (ctl->cancel) return true;
+ if (ctl->deadline > 0 && omp_get_wtime() >= ctl->deadline){
+  ctl->cancel = true;
+  return true;
+ }
+ return false;
+}
+
+// Record the bound reached by a finished step and run the callback. Returns
+// true if the kernel should stop.
+inline bool anytime_step(anytime_t * ctl, double progress, double err_bound){
+ if (ctl == NULL) return false;
+ ctl->err_bound = err_bound;
+ if (ctl->progress && !ctl->progress(progress, err_bound, ctl->ctx)){
+  ctl->cancel = true;
+ }
+ return anytime_expired(ctl);
+}
+#endif
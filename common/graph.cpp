@@ -388,3 +388,89 @@ void csr_to_center_csr(uint32_t * IA, uint32_t * JA,
     JA_int[idx] = (int32_t)((int64_t)JA[idx] - (int64_t)((N+1)/2));
   }
 }
+
+// Like csr_to_csc_parallel, with the weights carried along: column sizes
+// by atomic counts, a blocked prefix sum, a parallel scatter over source
+// ranges, then each column put back in source order.
+template <typename W>
+bool csr_to_csc_weighted(uint32_t * IAr, uint32_t * JAr, W * Ar,
+  uint32_t ** IAc, uint32_t ** JAc, W ** Ac, uint32_t length){
+ uint32_t edges = IAr[length];
+ uint32_t * I = (uint32_t *)calloc(length + 1, sizeof(uint32_t));
+ uint32_t * J = (uint32_t *)malloc(MAX(edges, 1) * sizeof(uint32_t));
+ W * V = (W *)malloc(MAX(edges, 1) * sizeof(W));
+ uint32_t * fill = (uint32_t *)calloc(MAX(length, 1), sizeof(uint32_t));
+ if (!I || !J || !V || !fill){
+  free(I); free(J); free(V); free(fill);
+  return false;
+ }
+#pragma omp parallel for schedule(static)
+ for (uint32_t edx = 0; edx < edges; edx++){
+#pragma omp atomic
+  I[JAr[edx] + 1]++;
+ }
+
+ // Sums within blocks, then across block ends, then block starts added in.
+ uint32_t num_elems = 1024*1024 / sizeof(uint32_t);
+ uint32_t num_blocks = (length + num_elems - 1) / num_elems;
+#pragma omp parallel for
+ for (uint32_t bidx = 0; bidx < num_blocks; bidx++){
+  uint32_t b_st = bidx * num_elems;
+  uint32_t b_nd = MIN(length, (bidx+1) * num_elems);
+  for (uint32_t idx = b_st + 1; idx < b_nd; idx++) I[idx+1] += I[idx];
+ }
+ for (uint32_t bidx = 1; bidx < num_blocks; bidx++){
+  uint32_t b_st = bidx * num_elems;
+  uint32_t b_nd = MIN(length, (bidx+1) * num_elems);
+  I[b_nd] += I[b_st];
+ }
+#pragma omp parallel for
+ for (uint32_t bidx = 1; bidx < num_blocks; bidx++){
+  uint32_t b_st = bidx * num_elems;
+  uint32_t b_nd = MIN(length, (bidx+1) * num_elems);
+  for (uint32_t idx = b_st + 1; idx < b_nd; idx++) I[idx] += I[b_st];
+ }
+
+#pragma omp parallel for schedule(dynamic, 64)
+ for (uint32_t u = 0; u < length; u++){
+  for (uint32_t edx = IAr[u]; edx < IAr[u+1]; edx++){
+   uint32_t jdx = JAr[edx];
+   uint32_t pos = I[jdx] + __sync_fetch_and_add(&fill[jdx], 1);
+   J[pos] = u;
+   V[pos] = Ar[edx];
+  }
+ }
+ free(fill);
+
+#pragma omp parallel
+ {
+  std::vector<std::pair<uint32_t, W> > col;
+#pragma omp for schedule(dynamic, 64)
+  for (uint32_t v = 0; v < length; v++){
+   uint32_t st = I[v], nd = I[v+1];
+   if (std::is_sorted(J + st, J + nd)) continue;
+   col.clear();
+   for (uint32_t pos = st; pos < nd; pos++){
+    col.push_back(std::make_pair(J[pos], V[pos]));
+   }
+   std::sort(col.begin(), col.end());
+   for (uint32_t pos = st; pos < nd; pos++){
+    J[pos] = col[pos - st].first;
+    V[pos] = col[pos - st].second;
+   }
+  }
+ }
+ *IAc = I;
+ *JAc = J;
+ *Ac = V;
+ return true;
+}
+
+template bool csr_to_csc_weighted<uint32_t>(uint32_t *, uint32_t *,
+  uint32_t *, uint32_t **, uint32_t **, uint32_t **, uint32_t);
+template bool csr_to_csc_weighted<uint64_t>(uint32_t *, uint32_t *,
+  uint64_t *, uint32_t **, uint32_t **, uint64_t **, uint32_t);
+template bool csr_to_csc_weighted<float>(uint32_t *, uint32_t *,
+  float *, uint32_t **, uint32_t **, float **, uint32_t);
+template bool csr_to_csc_weighted<double>(uint32_t *, uint32_t *,
+  double *, uint32_t **, uint32_t **, double **, uint32_t);
@@ -95,4 +95,12 @@ void sort_neighborhoods(uint32_t * IA, uint32_t * JA, uint32_t N);
 void csr_to_center_csr(uint32_t * IA, uint32_t * JA, 
   int32_t ** IA_cent, int32_t ** JA_cent, uint32_t N);
 
+// Transpose of a weighted CSR (e.g. SSSP's IA/JA/A), for searches that also
+// walk edges backwards. IAc, JAc and Ac are allocated here; each column
+// lists its sources in increasing order. Returns false if allocation fails.
+// Instantiated for uint32_t, uint64_t, float and double weights.
+template <typename W>
+bool csr_to_csc_weighted(uint32_t * IAr, uint32_t * JAr, W * Ar,
+  uint32_t ** IAc, uint32_t ** JAc, W ** Ac, uint32_t length);
+
 #endif
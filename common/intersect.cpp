@@ -0,0 +1,373 @@
+/*
+ * Graph Kernel Collection
+ *
+ * Copyright 2020 Carnegie Mellon University.
+ *
+ * NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ * INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON 
+ * UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR IMPLIED, 
+ * AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF FITNESS FOR 
+ * PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS OBTAINED FROM USE OF 
+ * THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES NOT MAKE ANY WARRANTY OF ANY
+ * KIND WITH RESPECT TO FREEDOM FROM PATENT, TRADEMARK, OR COPYRIGHT 
+ * INFRINGEMENT.
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or
+ * contact permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public
+ * release and unlimited distribution.  Please see Copyright notice for 
+ * non-US Government use and distribution.
+ *
+ * This Software includes and/or makes use of the following Third-Party
+ * Software subject to its own license:
+ *
+ * 1. Matrix Market Loader code (https://math.nist.gov/MatrixMarket/mmio-c.html).
+ *
+ *      The code made publicly available at nist.gov is not marked with a 
+ *      copyright notice and is therefore believed pursuant to section 105 of 
+ *      the Copyright Act, to not be entitled to domestic copyright protection 
+ *      under U.S. law and is therefore in the public domain.  Accordingly, it 
+ *      is believed that no license is required for its use.
+ *
+ * This Software may include certain portions of copyrighted code that is 
+ * initially being released only in binary form for validation and evaluation
+ * purposes. It is expected that source code will be released as open source at
+ * a future date. 
+ *
+ * DM20-0375
+ */
+ 
+#include "intersect.h"
+#include <stddef.h>
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define INTERSECT_X86
+#include <immintrin.h>
+#endif
+
+// Branch-free merge: every candidate is stored and the position only
+// advances on a match, so the loop has no branches on the data.
+template <bool EMIT>
+static inline uint32_t merge_scalar(const uint32_t * a, uint32_t na,
+  const uint32_t * b, uint32_t nb, uint32_t * out)
+{
+ uint32_t count = 0, i = 0, j = 0;
+ while (i < na && j < nb){
+  uint32_t x = a[i], y = b[j];
+  if (EMIT) out[count] = x;
+  count += (x == y);
+  i += (x <= y);
+  j += (y <= x);
+ }
+ return count;
+}
+
+#ifdef INTERSECT_X86
+// The vector merges advance blocks by their last ids like a scalar merge
+// advances elements, so a pair of blocks is compared once and an id left
+// for the scalar tail has no match in the blocks already passed.
+
+template <bool EMIT>
+__attribute__((target("avx2,bmi2,popcnt")))
+static inline uint32_t merge_avx2(const uint32_t * a, uint32_t na,
+  const uint32_t * b, uint32_t nb, uint32_t * out)
+{
+ // Lane l of the rotated block takes lane l+1.
+ const __m256i rot = _mm256_set_epi32(0, 7, 6, 5, 4, 3, 2, 1);
+ uint32_t count = 0, i = 0, j = 0;
+ while (i + 8 <= na && j + 8 <= nb){
+  __m256i va = _mm256_loadu_si256((const __m256i *)(a + i));
+  __m256i vb = _mm256_loadu_si256((const __m256i *)(b + j));
+  __m256i m = _mm256_cmpeq_epi32(va, vb);
+  for (int r = 1; r < 8; r++){
+   vb = _mm256_permutevar8x32_epi32(vb, rot);
+   m = _mm256_or_si256(m, _mm256_cmpeq_epi32(va, vb));
+  }
+  uint32_t mask = _mm256_movemask_ps(_mm256_castsi256_ps(m));
+  if (EMIT){
+   // Lane numbers of the set bits, packed to the front a byte each.
+   uint64_t bytes = _pdep_u64(mask, 0x0101010101010101ull) * 0xff;
+   uint64_t idx = _pext_u64(0x0706050403020100ull, bytes);
+   __m256i perm = _mm256_cvtepu8_epi32(_mm_cvtsi64_si128(idx));
+   _mm256_storeu_si256((__m256i *)(out + count),
+     _mm256_permutevar8x32_epi32(va, perm));
+  }
+  count += _mm_popcnt_u32(mask);
+  uint32_t amax = a[i+7], bmax = b[j+7];
+  i += (amax <= bmax) << 3;
+  j += (bmax <= amax) << 3;
+ }
+ return count + merge_scalar<EMIT>(a + i, na - i, b + j, nb - j,
+   EMIT ? out + count : NULL);
+}
+
+// Unsigned lane minimum. The unmasked intrinsic starts from an undefined
+// vector, which GCC flags as uninitialized.
+__attribute__((target("avx512f")))
+static inline __m512i min_u32x16(__m512i x, __m512i y){
+ return _mm512_mask_min_epu32(x, 0xffff, x, y);
+}
+
+template <bool EMIT>
+__attribute__((target("avx512f,popcnt")))
+static inline uint32_t merge_avx512(const uint32_t * a, uint32_t na,
+  const uint32_t * b, uint32_t nb, uint32_t * out)
+{
+ uint32_t count = 0, i = 0, j = 0;
+ while (i + 16 <= na && j + 16 <= nb){
+  __m512i va = _mm512_loadu_si512((const void *)(a + i));
+  // A lane of a matches if its xor with some id of the b block is zero.
+  // The ids are broadcast from memory, which leaves the shuffle port
+  // free, and the minimum keeps the mask compares out of the loop.
+  // Four chains of minimums keep the loop off the latency of one.
+  __m512i d[4];
+  for (int r = 0; r < 4; r++){
+   d[r] = _mm512_xor_si512(va, _mm512_set1_epi32(b[j+r]));
+  }
+  for (int r = 4; r < 16; r++){
+   d[r&3] = min_u32x16(d[r&3],
+     _mm512_xor_si512(va, _mm512_set1_epi32(b[j+r])));
+  }
+  __m512i dmin = min_u32x16(min_u32x16(d[0], d[1]), min_u32x16(d[2], d[3]));
+  __mmask16 m = _mm512_cmpeq_epi32_mask(dmin, _mm512_setzero_si512());
+  if (EMIT) _mm512_mask_compressstoreu_epi32(out + count, m, va);
+  count += _mm_popcnt_u32(m);
+  uint32_t amax = a[i+15], bmax = b[j+15];
+  i += (amax <= bmax) << 4;
+  j += (bmax <= amax) << 4;
+ }
+ return count + merge_scalar<EMIT>(a + i, na - i, b + j, nb - j,
+   EMIT ? out + count : NULL);
+}
+#endif
+
+template <bool EMIT>
+static uint32_t merge_scalar_fn(const uint32_t * a, uint32_t na,
+  const uint32_t * b, uint32_t nb, uint32_t * out)
+{
+ return merge_scalar<EMIT>(a, na, b, nb, out);
+}
+
+#ifdef INTERSECT_X86
+template <bool EMIT>
+__attribute__((target("avx2,bmi2,popcnt")))
+static uint32_t merge_avx2_fn(const uint32_t * a, uint32_t na,
+  const uint32_t * b, uint32_t nb, uint32_t * out)
+{
+ return merge_avx2<EMIT>(a, na, b, nb, out);
+}
+
+template <bool EMIT>
+__attribute__((target("avx512f,popcnt")))
+static uint32_t merge_avx512_fn(const uint32_t * a, uint32_t na,
+  const uint32_t * b, uint32_t nb, uint32_t * out)
+{
+ return merge_avx512<EMIT>(a, na, b, nb, out);
+}
+#endif
+
+typedef uint32_t (*merge_fn_t)(const uint32_t *, uint32_t,
+  const uint32_t *, uint32_t, uint32_t *);
+
+typedef struct {
+ intersect_isa_t isa;
+ merge_fn_t count;
+ merge_fn_t emit;
+} merge_kernels_t;
+
+static merge_kernels_t kernels_for(intersect_isa_t isa){
+ merge_kernels_t k = {INTERSECT_SCALAR, merge_scalar_fn<false>,
+   merge_scalar_fn<true>};
+#ifdef INTERSECT_X86
+ if (isa == INTERSECT_AVX2){
+  k.isa = isa;
+  k.count = merge_avx2_fn<false>;
+  k.emit = merge_avx2_fn<true>;
+ } else if (isa == INTERSECT_AVX512){
+  k.isa = isa;
+  k.count = merge_avx512_fn<false>;
+  k.emit = merge_avx512_fn<true>;
+ }
+#endif
+ return k;
+}
+
+bool intersect_isa_supported(intersect_isa_t isa){
+ if (isa == INTERSECT_SCALAR) return true;
+#ifdef INTERSECT_X86
+ __builtin_cpu_init();
+ if (isa == INTERSECT_AVX2){
+  return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("bmi2") &&
+    __builtin_cpu_supports("popcnt");
+ }
+ if (isa == INTERSECT_AVX512){
+  return __builtin_cpu_supports("avx512f") &&
+    __builtin_cpu_supports("popcnt");
+ }
+#endif
+ return false;
+}
+
+// Best of INTERSECT_CAL_TRIALS timings of 16 counts over the same pair of
+// INTERSECT_CAL_LEN-id lists.
+#define INTERSECT_CAL_LEN 1024
+#define INTERSECT_CAL_TRIALS 5
+
+static double time_kernel(merge_fn_t count,
+  const std::vector<uint32_t> & a, const std::vector<uint32_t> & b)
+{
+ volatile uint32_t sink = 0;
+ double best = 0.0;
+ for (uint32_t t = 0; t < INTERSECT_CAL_TRIALS; t++){
+  std::chrono::steady_clock::time_point st = std::chrono::steady_clock::now();
+  for (uint32_t r = 0; r < 16; r++){
+   sink = sink + count(a.data(), a.size(), b.data(), b.size(), NULL);
+  }
+  double el = std::chrono::duration<double>(
+    std::chrono::steady_clock::now() - st).count();
+  if (t == 0 || el < best) best = el;
+ }
+ (void)sink;
+ return best;
+}
+
+// AVX-512 only where it beats AVX2 on this CPU; on some parts the 16 x 16
+// blocks lose to 8 x 8 (frequency drop, port pressure), so it is timed.
+static merge_kernels_t best_kernels(){
+ bool avx2 = intersect_isa_supported(INTERSECT_AVX2);
+ bool avx512 = intersect_isa_supported(INTERSECT_AVX512);
+ if (!avx2 && !avx512) return kernels_for(INTERSECT_SCALAR);
+ if (!avx512) return kernels_for(INTERSECT_AVX2);
+ if (!avx2) return kernels_for(INTERSECT_AVX512);
+ // Each id goes to either list with probability 3/8, independently.
+ std::vector<uint32_t> a, b;
+ uint32_t x = 27491095;
+ for (uint32_t v = 0; a.size() < INTERSECT_CAL_LEN ||
+        b.size() < INTERSECT_CAL_LEN; v++){
+  x = x * 1664525 + 1013904223;
+  bool in_a = (x >> 28) < 6, in_b = ((x >> 24) & 15) < 6;
+  if (in_a && a.size() < INTERSECT_CAL_LEN) a.push_back(v);
+  if (in_b && b.size() < INTERSECT_CAL_LEN) b.push_back(v);
+ }
+ merge_kernels_t k2 = kernels_for(INTERSECT_AVX2);
+ merge_kernels_t k512 = kernels_for(INTERSECT_AVX512);
+ time_kernel(k2.count, a, b);  // warm-up
+ double t2 = time_kernel(k2.count, a, b);
+ double t512 = time_kernel(k512.count, a, b);
+ return (t512 < t2) ? k512 : k2;
+}
+
+static merge_kernels_t kernels = best_kernels();
+
+intersect_isa_t intersect_isa(){
+ return kernels.isa;
+}
+
+const char * intersect_isa_name(intersect_isa_t isa){
+ switch (isa){
+  case INTERSECT_AVX2: return "avx2";
+  case INTERSECT_AVX512: return "avx512";
+  default: return "scalar";
+ }
+}
+
+bool intersect_set_isa(intersect_isa_t isa){
+ if (!intersect_isa_supported(isa)) return false;
+ kernels = kernels_for(isa);
+ return true;
+}
+
+uint32_t intersect_merge_count(const uint32_t * a, uint32_t na,
+  const uint32_t * b, uint32_t nb)
+{
+ return kernels.count(a, na, b, nb, NULL);
+}
+
+uint32_t intersect_merge(const uint32_t * a, uint32_t na,
+  const uint32_t * b, uint32_t nb, uint32_t * out)
+{
+ return kernels.emit(a, na, b, nb, out);
+}
+
+// First index in [lo, n) with b[idx] >= x: doubling steps, then a binary
+// search over the last step.
+static inline uint32_t gallop_to(const uint32_t * b, uint32_t lo,
+  uint32_t n, uint32_t x)
+{
+ uint32_t step = 1, hi = lo;
+ while (hi < n && b[hi] < x){
+  lo = hi + 1;
+  hi += step;
+  step <<= 1;
+ }
+ hi = std::min(hi, n);
+ while (lo < hi){
+  uint32_t mid = lo + (hi - lo) / 2;
+  if (b[mid] < x) lo = mid + 1;
+  else hi = mid;
+ }
+ return lo;
+}
+
+template <bool EMIT>
+static inline uint32_t gallop(const uint32_t * a, uint32_t na,
+  const uint32_t * b, uint32_t nb, uint32_t * out)
+{
+ uint32_t count = 0, j = 0;
+ for (uint32_t i = 0; i < na && j < nb; i++){
+  j = gallop_to(b, j, nb, a[i]);
+  if (EMIT) out[count] = a[i];
+  count += (j < nb && b[j] == a[i]);
+ }
+ return count;
+}
+
+uint32_t intersect_gallop_count(const uint32_t * a, uint32_t na,
+  const uint32_t * b, uint32_t nb)
+{
+ return gallop<false>(a, na, b, nb, NULL);
+}
+
+uint32_t intersect_gallop(const uint32_t * a, uint32_t na,
+  const uint32_t * b, uint32_t nb, uint32_t * out)
+{
+ return gallop<true>(a, na, b, nb, out);
+}
+
+uint32_t intersect_count(const uint32_t * a, uint32_t na,
+  const uint32_t * b, uint32_t nb)
+{
+ if (na > nb){
+  std::swap(a, b);
+  std::swap(na, nb);
+ }
+ if ((uint64_t)na * INTERSECT_GALLOP_RATIO <= nb){
+  return gallop<false>(a, na, b, nb, NULL);
+ }
+ return kernels.count(a, na, b, nb, NULL);
+}
+
+uint32_t intersect(const uint32_t * a, uint32_t na,
+  const uint32_t * b, uint32_t nb, uint32_t * out)
+{
+ if (na > nb){
+  std::swap(a, b);
+  std::swap(na, nb);
+ }
+ if ((uint64_t)na * INTERSECT_GALLOP_RATIO <= nb){
+  return gallop<true>(a, na, b, nb, out);
+ }
+ return kernels.emit(a, na, b, nb, out);
+}
+
+uint32_t intersect_count_below(const uint32_t * a, uint32_t na,
+  const uint32_t * b, uint32_t nb, uint32_t bound)
+{
+ na = std::lower_bound(a, a + na, bound) - a;
+ nb = std::lower_bound(b, b + nb, bound) - b;
+ return intersect_count(a, na, b, nb);
+}
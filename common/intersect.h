@@ -0,0 +1,113 @@
+/*
+ * Graph Kernel Collection
+ *
+ * Copyright 2020 Carnegie Mellon University.
+ *
+ * NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ * INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON 
+ * UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR IMPLIED, 
+ * AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF FITNESS FOR 
+ * PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS OBTAINED FROM USE OF 
+ * THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES NOT MAKE ANY WARRANTY OF ANY
+ * KIND WITH RESPECT TO FREEDOM FROM PATENT, TRADEMARK, OR COPYRIGHT 
+ * INFRINGEMENT.
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or
+ * contact permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public
+ * release and unlimited distribution.  Please see Copyright notice for 
+ * non-US Government use and distribution.
+ *
+ * This Software includes and/or makes use of the following Third-Party
+ * Software subject to its own license:
+ *
+ * 1. Matrix Market Loader code (https://math.nist.gov/MatrixMarket/mmio-c.html).
+ *
+ *      The code made publicly available at nist.gov is not marked with a 
+ *      copyright notice and is therefore believed pursuant to section 105 of 
+ *      the Copyright Act, to not be entitled to domestic copyright protection 
+ *      under U.S. law and is therefore in the public domain.  Accordingly, it 
+ *      is believed that no license is required for its use.
+ *
+ * This Software may include certain portions of copyrighted code that is 
+ * initially being released only in binary form for validation and evaluation
+ * purposes. It is expected that source code will be released as open source at
+ * a future date. 
+ *
+ * DM20-0375
+ */
+ 
+#ifndef INTERSECT_H
+#define INTERSECT_H
+
+#include <stdint.h>
+
+/*
+ * Intersections of sorted lists of distinct uint32 ids (CSR neighborhoods),
+ * shared by the triangle, clique and similarity kernels.
+ *
+ * The merge kernels compare blocks of both lists at once, all pairs, and
+ * finish the tails with a branch-free scalar merge: 8 x 8 with AVX2 (the
+ * b block rotated through every lane) and 16 x 16 with AVX-512 (each id of
+ * the b block broadcast against the a block). The instruction set
+ * is picked at startup from what the CPU supports, independent of the
+ * flags the caller was built with, and AVX-512 only if a short timing
+ * against AVX2 finds it faster; intersect_set_isa forces one (for
+ * benchmarks). Galloping stays scalar. The plain entry points gallop the
+ * shorter list through the longer once the lengths differ by
+ * INTERSECT_GALLOP_RATIO and merge otherwise.
+ *
+ * Materializing kernels write the common ids, in order, to out and return
+ * how many there are. They store whole vectors, so out needs room for the
+ * shorter list plus INTERSECT_PAD entries.
+ */
+
+// Length ratio from which intersect_count and intersect gallop.
+#ifndef INTERSECT_GALLOP_RATIO
+#define INTERSECT_GALLOP_RATIO 32
+#endif
+
+#define INTERSECT_PAD 16
+
+typedef enum {
+ INTERSECT_SCALAR = 0,
+ INTERSECT_AVX2,
+ INTERSECT_AVX512
+} intersect_isa_t;
+
+// Whether this CPU (and compiler) can run the kernels of isa.
+bool intersect_isa_supported(intersect_isa_t isa);
+
+// Kernels in use, and their name ("scalar", "avx2", "avx512").
+intersect_isa_t intersect_isa();
+const char * intersect_isa_name(intersect_isa_t isa);
+
+// Use the kernels of isa from now on; false (and no change) if unsupported.
+// Not safe while other threads intersect.
+bool intersect_set_isa(intersect_isa_t isa);
+
+// Merge-based, in the instruction set in use.
+uint32_t intersect_merge_count(const uint32_t * a, uint32_t na,
+  const uint32_t * b, uint32_t nb);
+uint32_t intersect_merge(const uint32_t * a, uint32_t na,
+  const uint32_t * b, uint32_t nb, uint32_t * out);
+
+// Binary-search each id of a (the shorter list) in b with doubling steps.
+uint32_t intersect_gallop_count(const uint32_t * a, uint32_t na,
+  const uint32_t * b, uint32_t nb);
+uint32_t intersect_gallop(const uint32_t * a, uint32_t na,
+  const uint32_t * b, uint32_t nb, uint32_t * out);
+
+// Merge or gallop by length ratio, in either order of the lists.
+uint32_t intersect_count(const uint32_t * a, uint32_t na,
+  const uint32_t * b, uint32_t nb);
+uint32_t intersect(const uint32_t * a, uint32_t na,
+  const uint32_t * b, uint32_t nb, uint32_t * out);
+
+// intersect_count over the ids below bound only (e.g. the lower neighbors
+// in a full symmetric matrix).
+uint32_t intersect_count_below(const uint32_t * a, uint32_t na,
+  const uint32_t * b, uint32_t nb, uint32_t bound);
+
+#endif
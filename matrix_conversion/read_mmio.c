@@ -78,7 +78,14 @@
 #include <typeinfo>
 
 typedef uint32_t VTYPE;
+// -DWTYPE_FLOAT writes 32-bit float weights instead of unsigned integers.
+#ifdef WTYPE_FLOAT
+typedef float WTYPE;
+#define WTYPE_FMT "%f"
+#else
 typedef uint32_t WTYPE;
+#define WTYPE_FMT "%u"
+#endif
 
 #define MAX(a,b) ((a) > (b) ? (a) : (b))
 typedef std::pair<VTYPE, WTYPE> j_val;
@@ -198,7 +205,7 @@ int main(int argc, char *argv[])
   for (i=0; i<nz; i++)
   {
     // This line needs to be changed if the datatypes are modified!
-    fscanf(f, "%u %u %u\n", &idx, &jdx, &val_w);
+    fscanf(f, "%u %u " WTYPE_FMT "\n", &idx, &jdx, &val_w);
     idx--;
     jdx--;
     if (idx == jdx) continue; // Skip self edges.